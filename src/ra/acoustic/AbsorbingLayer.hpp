@@ -0,0 +1,94 @@
+#pragma once
+
+#include <neo/container/mdspan.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ra {
+
+/// Graded lossy layer along the edges of a 2D FDTD grid. Inside the layer the
+/// lossy wave equation u_tt + 2 sigma u_t = c^2 laplace(u) is solved, with
+/// sigma rising quadratically towards the outer edge so outgoing waves are
+/// damped before they reach the rigid boundary.
+///
+/// The lossless bulk kernel runs over the whole grid as usual, apply() then
+/// corrects only the layer cells. Coefficients are stored for those cells
+/// alone, so the cost scales with the perimeter and not the area.
+template<typename Float>
+struct AbsorbingLayer
+{
+    AbsorbingLayer() = default;
+
+    /// thickness is in grid cells, courant is c*dt/dx of the scheme
+    AbsorbingLayer(std::size_t Nx, std::size_t Ny, std::size_t thickness, double courant)
+    {
+        if (thickness == 0) {
+            return;
+        }
+
+        // Maximum loss for a quadratic profile with the given round-trip
+        // reflection of a normally incident plane wave.
+        static constexpr auto order      = 2.0;
+        static constexpr auto reflection = 1e-4;
+
+        auto const N       = static_cast<double>(thickness);
+        auto const betaMax = -(order + 1.0) * courant * std::log(reflection) / (2.0 * N);
+
+        auto const inLayer = [thickness](std::size_t i, std::size_t size) {
+            return std::min(i, size - 1U - i) < thickness;
+        };
+
+        auto const depth = [N](std::size_t i, std::size_t size) {
+            auto const fromEdge = std::min(i, size - 1U - i);
+            auto const d        = N - static_cast<double>(fromEdge);
+            return d > 0.0 ? d / N : 0.0;
+        };
+
+        for (auto x{0UL}; x < Nx; ++x) {
+            for (auto y{0UL}; y < Ny; ++y) {
+                if (not inLayer(x, Nx) and not inLayer(y, Ny)) {
+                    continue;
+                }
+
+                auto const dx = depth(x, Nx);
+                auto const dy = depth(y, Ny);
+
+                auto const beta = betaMax * (std::pow(dx, order) + std::pow(dy, order));
+                _cells.push_back({static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y)});
+                _beta.push_back(static_cast<Float>(beta));
+                _gain.push_back(static_cast<Float>(1.0 / (1.0 + beta)));
+            }
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return _cells.size(); }
+
+    /// uNext must hold the lossless update 2u - uPrev + lambda^2 * laplace(u)
+    auto apply(
+        stdex::mdspan<Float const, stdex::dextents<std::size_t, 2>> uPrev,
+        stdex::mdspan<Float, stdex::dextents<std::size_t, 2>> uNext
+    ) const -> void
+    {
+        for (auto i{0UL}; i < _cells.size(); ++i) {
+            auto const [x, y] = _cells[i];
+            uNext(x, y)       = (uNext(x, y) + _beta[i] * uPrev(x, y)) * _gain[i];
+        }
+    }
+
+private:
+    struct Cell
+    {
+        std::uint32_t x;
+        std::uint32_t y;
+    };
+
+    std::vector<Cell> _cells;
+    std::vector<Float> _beta;
+    std::vector<Float> _gain;
+};
+
+}  // namespace ra
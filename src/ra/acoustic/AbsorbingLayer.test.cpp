@@ -0,0 +1,55 @@
+#include "AbsorbingLayer.hpp"
+
+#include <ra/acoustic/WaveEquation2D.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <numeric>
+
+TEST_CASE("RaumAkustik: AbsorbingLayer", "")
+{
+    auto const layer = ra::AbsorbingLayer<double>{20, 10, 3, 1.0};
+    REQUIRE(layer.size() == 20 * 10 - 14 * 4);
+    REQUIRE(ra::AbsorbingLayer<float>{20, 10, 0, 1.0}.size() == 0);
+
+    // Lossless update of a field at rest must stay at rest
+    auto uPrev = stdex::mdarray<double, stdex::dextents<std::size_t, 2>>{20, 10};
+    auto uNext = stdex::mdarray<double, stdex::dextents<std::size_t, 2>>{20, 10};
+    uPrev(1, 1) = 0.5;
+    uNext(1, 1) = 0.5;
+    layer.apply(uPrev.to_mdspan(), uNext.to_mdspan());
+    REQUIRE(uNext(1, 1) == Catch::Approx(0.5));
+}
+
+TEST_CASE("RaumAkustik: WaveEquation2D absorbingLayer", "")
+{
+    using namespace mp_units::si::unit_symbols;
+
+    auto energy = [](ra::WaveEquation2D::State const& state) {
+        auto const u = state.u.to_mdspan();
+        return std::transform_reduce(u.data_handle(), u.data_handle() + u.size(), 0.0, std::plus{}, [](auto v) {
+            return v * v;
+        });
+    };
+
+    auto run = [](std::size_t layer) {
+        auto const we = ra::WaveEquation2D({
+            .Lx             = 2.0 * m,
+            .Ly             = 2.0 * m,
+            .duration       = 0.03 * s,
+            .fmax           = 500.0 * Hz,
+            .ppw            = 6.0,
+            .absorbingLayer = layer,
+        });
+
+        auto state = we.initialState();
+        we(state, {});
+        return state;
+    };
+
+    auto const rigid = run(0);
+    auto const free  = run(16);
+    REQUIRE(free.u.extent(0) == rigid.u.extent(0) + 32);
+    REQUIRE(energy(free) < energy(rigid) * 0.01);
+}
@@ -0,0 +1,103 @@
+#include "FdtdStencil.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+template<ra::FdtdScheme Scheme, typename Float>
+auto checkUniformField2D() -> void
+{
+    using Field = stdex::mdarray<Float, stdex::dextents<std::size_t, 2>>;
+
+    auto u     = Field{5, 6};
+    auto uPrev = Field{5, 6};
+    auto uNext = Field{5, 6};
+    for (auto x{0UL}; x < u.extent(0); ++x) {
+        for (auto y{0UL}; y < u.extent(1); ++y) {
+            u(x, y)     = Float(0.5);
+            uPrev(x, y) = Float(0.5);
+        }
+    }
+
+    ra::fdtdUpdate<Scheme, Float>(u.to_mdspan(), uPrev.to_mdspan(), uNext.to_mdspan());
+    for (auto x{1UL}; x < u.extent(0) - 1; ++x) {
+        for (auto y{1UL}; y < u.extent(1) - 1; ++y) {
+            REQUIRE(uNext(x, y) == Catch::Approx(0.5));
+        }
+    }
+}
+
+template<ra::FdtdScheme Scheme, typename Float>
+auto checkUniformField3D() -> void
+{
+    using Field = stdex::mdarray<Float, stdex::dextents<std::size_t, 3>>;
+
+    auto u     = Field{4, 5, 6};
+    auto uPrev = Field{4, 5, 6};
+    auto uNext = Field{4, 5, 6};
+    for (auto x{0UL}; x < u.extent(0); ++x) {
+        for (auto y{0UL}; y < u.extent(1); ++y) {
+            for (auto z{0UL}; z < u.extent(2); ++z) {
+                u(x, y, z)     = Float(0.5);
+                uPrev(x, y, z) = Float(0.5);
+            }
+        }
+    }
+
+    ra::fdtdUpdate<Scheme, Float>(u.to_mdspan(), uPrev.to_mdspan(), uNext.to_mdspan());
+    for (auto x{1UL}; x < u.extent(0) - 1; ++x) {
+        for (auto y{1UL}; y < u.extent(1) - 1; ++y) {
+            for (auto z{1UL}; z < u.extent(2) - 1; ++z) {
+                REQUIRE(uNext(x, y, z) == Catch::Approx(0.5));
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEMPLATE_TEST_CASE("RaumAkustik: fdtdUpdate", "", float, double)
+{
+    using Float = TestType;
+
+    static constexpr auto slf = ra::FdtdScheme::StandardLeapfrog;
+    static constexpr auto iwb = ra::FdtdScheme::InterpolatedWideband;
+
+    REQUIRE(ra::courantNumber<slf, 2>() == Catch::Approx(0.7071067812));
+    REQUIRE(ra::courantNumber<iwb, 2>() == Catch::Approx(1.0));
+    REQUIRE(ra::courantNumber<slf, 3>() == Catch::Approx(0.5773502692));
+    REQUIRE(ra::courantNumber<iwb, 3>() == Catch::Approx(1.0));
+
+    SECTION("uniform field is at rest")
+    {
+        checkUniformField2D<slf, Float>();
+        checkUniformField2D<iwb, Float>();
+        checkUniformField3D<slf, Float>();
+        checkUniformField3D<iwb, Float>();
+    }
+
+    SECTION("impulse response 2D")
+    {
+        using Field = stdex::mdarray<Float, stdex::dextents<std::size_t, 2>>;
+
+        auto u     = Field{5, 5};
+        auto uPrev = Field{5, 5};
+        auto uNext = Field{5, 5};
+        u(2, 2)    = Float(1);
+
+        ra::fdtdUpdate<slf, Float>(u.to_mdspan(), uPrev.to_mdspan(), uNext.to_mdspan());
+        REQUIRE(uNext(2, 2) == Catch::Approx(0.0));
+        REQUIRE(uNext(1, 2) == Catch::Approx(0.5));
+        REQUIRE(uNext(2, 3) == Catch::Approx(0.5));
+        REQUIRE(uNext(1, 1) == Catch::Approx(0.0));
+
+        ra::fdtdUpdate<iwb, Float>(u.to_mdspan(), uPrev.to_mdspan(), uNext.to_mdspan());
+        REQUIRE(uNext(2, 2) == Catch::Approx(-1.0));
+        REQUIRE(uNext(1, 2) == Catch::Approx(0.5));
+        REQUIRE(uNext(2, 3) == Catch::Approx(0.5));
+        REQUIRE(uNext(1, 1) == Catch::Approx(0.25));
+        REQUIRE(uNext(3, 3) == Catch::Approx(0.25));
+    }
+}
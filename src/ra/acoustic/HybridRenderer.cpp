@@ -0,0 +1,288 @@
+#include "HybridRenderer.hpp"
+
+#include <ra/acoustic/ReverberationTime.hpp>
+#include <ra/acoustic/SchroederFrequency.hpp>
+#include <ra/acoustic/WaveEquation2D.hpp>
+#include <ra/dsp/Biquad.hpp>
+#include <ra/dsp/FrequencyResponse.hpp>
+#include <ra/dsp/Resampler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <numbers>
+#include <numeric>
+#include <random>
+
+namespace ra {
+
+namespace detail {
+
+auto applyDecay(std::span<double> impulse, double sampleRate, double T60) -> void
+{
+    // ln(10^3)
+    static constexpr auto decay60dB = 6.907755278982137;
+
+    auto const rate = decay60dB / (T60 * sampleRate);
+    for (auto i{0UL}; i < impulse.size(); ++i) {
+        impulse[i] *= std::exp(-rate * static_cast<double>(i));
+    }
+}
+
+auto histogramsToImpulse(
+    std::span<std::vector<double> const> histograms,
+    std::span<quantity<isq::frequency[si::hertz]> const> frequencies,
+    double binDuration,
+    double sampleRate,
+    std::uint32_t seed
+) -> std::vector<double>
+{
+    auto const bins = std::transform_reduce(
+        histograms.begin(),
+        histograms.end(),
+        std::size_t{0},
+        [](auto l, auto r) { return std::max(l, r); },
+        [](auto const& h) { return h.size(); }
+    );
+
+    auto const samplesPerBin = binDuration * sampleRate;
+    auto const size          = static_cast<std::size_t>(std::ceil(static_cast<double>(bins) * samplesPerBin));
+
+    auto impulse = std::vector<double>(size, 0.0);
+    auto noise   = std::vector<double>(size, 0.0);
+
+    for (auto band{0UL}; band < histograms.size(); ++band) {
+        auto const center = frequencies[band].numerical_value_in(si::hertz);
+        if (center >= sampleRate * 0.5) {
+            continue;
+        }
+
+        // Octave wide carrier
+        auto rng    = std::mt19937{seed + static_cast<std::uint32_t>(band)};
+        auto normal = std::normal_distribution<double>{0.0, 1.0};
+        std::generate(noise.begin(), noise.end(), [&] { return normal(rng); });
+
+        auto filter = Biquad<double>{makeBandpass(center, std::numbers::sqrt2, sampleRate)};
+        filter(std::span{noise});
+
+        auto const& histogram = histograms[band];
+        for (auto bin{0UL}; bin < histogram.size(); ++bin) {
+            auto const first = static_cast<std::size_t>(std::round(static_cast<double>(bin) * samplesPerBin));
+            auto const end   = std::round(static_cast<double>(bin + 1) * samplesPerBin);
+            auto const last  = std::min(size, static_cast<std::size_t>(end));
+            if (first >= last or histogram[bin] <= 0.0) {
+                continue;
+            }
+
+            auto const energy = std::transform_reduce(
+                std::next(noise.begin(), static_cast<std::ptrdiff_t>(first)),
+                std::next(noise.begin(), static_cast<std::ptrdiff_t>(last)),
+                0.0,
+                std::plus{},
+                [](auto x) { return x * x; }
+            );
+            if (energy <= 0.0) {
+                continue;
+            }
+
+            auto const gain = std::sqrt(histogram[bin] / energy);
+            for (auto i{first}; i < last; ++i) {
+                impulse[i] += noise[i] * gain;
+            }
+        }
+    }
+
+    return impulse;
+}
+
+}  // namespace detail
+
+HybridRenderer::HybridRenderer(Spec spec) : _spec{std::move(spec)} {}
+
+auto HybridRenderer::reverberationTimes() const -> std::vector<quantity<isq::duration[si::second]>>
+{
+    auto const& room = _spec.room;
+
+    auto const length = room.dimensions.length.numerical_value_in(si::metre);
+    auto const width  = room.dimensions.width.numerical_value_in(si::metre);
+    auto const height = room.dimensions.height.numerical_value_in(si::metre);
+    auto const volume = length * width * height * cubic(si::metre);
+
+    auto const surfaces = std::array{
+        std::pair{RoomSurface::front, width * height},
+        std::pair{RoomSurface::back, width * height},
+        std::pair{RoomSurface::left, length * height},
+        std::pair{RoomSurface::right, length * height},
+        std::pair{RoomSurface::ceiling, length * width},
+        std::pair{RoomSurface::floor, length * width},
+    };
+
+    auto times = std::vector<quantity<isq::duration[si::second]>>{};
+    times.reserve(_spec.frequencies.size());
+
+    for (auto band{0UL}; band < _spec.frequencies.size(); ++band) {
+        auto absorptionArea = 0.0;
+        for (auto const& [surface, area] : surfaces) {
+            absorptionArea += area * room.absorption.surface(surface)[band];
+        }
+
+        // A rigid room doesn't decay within the rendered duration
+        if (absorptionArea <= 0.0) {
+            times.push_back(_spec.duration);
+            continue;
+        }
+        times.push_back(sabineReverberationTime(volume, absorptionArea * square(si::metre)));
+    }
+
+    return times;
+}
+
+auto HybridRenderer::crossover() const -> quantity<isq::frequency[si::hertz]>
+{
+    using si::unit_symbols::Hz;
+
+    auto const times = reverberationTimes();
+
+    auto sum   = 0.0;
+    auto count = 0UL;
+    for (auto band{0UL}; band < times.size(); ++band) {
+        auto const f = _spec.frequencies[band];
+        if (f >= 500.0 * Hz and f <= 1000.0 * Hz) {
+            sum += times[band].numerical_value_in(si::second);
+            ++count;
+        }
+    }
+
+    // No mid bands, fall back to all of them
+    if (count == 0) {
+        for (auto const& t : times) {
+            sum += t.numerical_value_in(si::second);
+        }
+        count = times.size();
+    }
+
+    auto const& dimensions = _spec.room.dimensions;
+    auto const volume      = dimensions.length.numerical_value_in(si::metre)
+                      * dimensions.width.numerical_value_in(si::metre)
+                      * dimensions.height.numerical_value_in(si::metre) * cubic(si::metre);
+
+    // Long decays in small rooms push the Schroeder frequency up to where
+    // the crossover filters break down
+    auto const T  = sum / static_cast<double>(std::max(count, std::size_t(1))) * si::second;
+    auto const fc = schroederFrequency(T, volume).numerical_value_in(si::hertz);
+    return std::min(fc, _spec.sampleRate * 0.4) * si::hertz;
+}
+
+auto HybridRenderer::operator()() const -> Result
+{
+    auto const fs = _spec.sampleRate;
+    auto const fc = crossover().numerical_value_in(si::hertz);
+
+    auto waveTask = std::async(std::launch::async, [this] { return renderWave(); });
+    auto geo      = renderGeometric();
+    auto wave     = waveTask.get();
+
+    auto const size = static_cast<std::size_t>(std::round(_spec.duration.numerical_value_in(si::second) * fs));
+    wave.resize(size, 0.0);
+    geo.resize(size, 0.0);
+
+    // Level calibration in the octave around the crossover, where both
+    // engines are valid
+    auto const center     = std::array{fc * si::hertz};
+    auto const waveEnergy = octaveBandEnergies(frequencyResponse(wave, fs), center)[0];
+    auto const geoEnergy  = octaveBandEnergies(frequencyResponse(geo, fs), center)[0];
+    if (waveEnergy > 0.0) {
+        auto const gain = std::sqrt(geoEnergy / waveEnergy);
+        std::transform(wave.begin(), wave.end(), wave.begin(), [gain](auto x) { return x * gain; });
+    }
+
+    // Linkwitz-Riley, two cascaded butterworth sections per side
+    static constexpr auto q = 1.0 / std::numbers::sqrt2;
+
+    auto const lowpass  = makeLowpass(fc, q, fs);
+    auto const highpass = makeHighpass(fc, q, fs);
+    for (auto i{0}; i < 2; ++i) {
+        auto lp = Biquad<double>{lowpass};
+        auto hp = Biquad<double>{highpass};
+        lp(std::span{wave});
+        hp(std::span{geo});
+    }
+
+    auto impulse = std::vector<double>(size);
+    std::transform(wave.begin(), wave.end(), geo.begin(), impulse.begin(), std::plus{});
+
+    return {
+        .sampleRate = fs,
+        .crossover  = fc * si::hertz,
+        .impulse    = std::move(impulse),
+        .wave       = std::move(wave),
+        .geometric  = std::move(geo),
+    };
+}
+
+auto HybridRenderer::renderWave() const -> std::vector<double>
+{
+    auto const fc    = crossover();
+    auto const fs    = _spec.sampleRate;
+    auto const& room = _spec.room;
+
+    // The 2D solver runs in the floor plan, x across the width & y along the length
+    auto const solver = WaveEquation2D({
+        .Lx        = room.dimensions.width,
+        .Ly        = room.dimensions.length,
+        .duration  = _spec.duration,
+        .fmax      = std::min(fc.numerical_value_in(si::hertz) * 2.0, fs * 0.5) * si::hertz,
+        .ppw       = _spec.ppw,
+        .scheme    = _spec.scheme,
+        .precision = FdtdPrecision::Float64,
+        .source    = glm::dvec2{room.source.y, room.source.x},
+        .receiver  = glm::dvec2{room.receiver.y, room.receiver.x},
+    });
+
+    auto state = solver.initialState();
+    solver(state, {});
+
+    auto const resample = Resampler{{.inputRate = 1.0 / solver.grid().dt, .outputRate = fs}};
+    auto impulse        = resample(state.receiver);
+
+    // The 2D field keeps a constant offset after the impulse
+    auto dcBlock = Biquad<double>{makeHighpass(10.0, 1.0 / std::numbers::sqrt2, fs)};
+    dcBlock(std::span{impulse});
+
+    // Walls are rigid, impose the decay of the bands below the crossover
+    auto const times = reverberationTimes();
+
+    auto sum   = 0.0;
+    auto count = 0UL;
+    for (auto band{0UL}; band < times.size(); ++band) {
+        if (_spec.frequencies[band] <= fc * 2.0 or band == 0) {
+            sum += times[band].numerical_value_in(si::second);
+            ++count;
+        }
+    }
+
+    if (count != 0) {
+        detail::applyDecay(impulse, fs, sum / static_cast<double>(count));
+    }
+
+    return impulse;
+}
+
+auto HybridRenderer::renderGeometric() const -> std::vector<double>
+{
+    static constexpr auto binDuration = 0.001;
+
+    auto const raytracer = StochasticRaytracing{_spec.room};
+    auto const histogram = raytracer({
+        .frequencies = _spec.frequencies,
+        .duration    = _spec.duration,
+        .timeStep    = binDuration * si::second,
+        .radius      = 0.0875 * si::metre,
+        .rays        = _spec.rays,
+    });
+
+    return detail::histogramsToImpulse(histogram, _spec.frequencies, binDuration, _spec.sampleRate, _spec.seed);
+}
+
+}  // namespace ra
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <ra/acoustic/FdtdStencil.hpp>
+#include <ra/acoustic/StochasticRaytracing.hpp>
+#include <ra/unit/frequency.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Broadband impulse response from a wave based simulation below the
+/// Schroeder frequency and stochastic raytracing above it.
+///
+/// The crossover is derived from the Sabine reverberation time of the room,
+/// so the FDTD grid only has to resolve up to twice that frequency. Both
+/// engines run concurrently, their responses are split with a 4th order
+/// Linkwitz-Riley crossover and the wave part is level matched to the
+/// geometric part in the octave around the crossover.
+struct HybridRenderer
+{
+    struct Spec
+    {
+        StochasticRaytracing::Room room;
+
+        /// Band centers of the absorption, reflection & scattering tables
+        std::vector<quantity<isq::frequency[si::hertz]>> frequencies;
+
+        quantity<isq::duration[si::second]> duration;
+        std::size_t rays{10'000};
+        double sampleRate{48'000.0};
+
+        double ppw{6.0};
+        FdtdScheme scheme{FdtdScheme::InterpolatedWideband};
+
+        /// Seed for the noise carrier of the geometric part
+        std::uint32_t seed{42};
+    };
+
+    struct Result
+    {
+        double sampleRate{0.0};
+        quantity<isq::frequency[si::hertz]> crossover;
+
+        /// Sum of wave & geometric
+        std::vector<double> impulse;
+
+        /// Lowpassed FDTD response
+        std::vector<double> wave;
+
+        /// Highpassed raytracing response
+        std::vector<double> geometric;
+    };
+
+    explicit HybridRenderer(Spec spec);
+
+    /// Sabine reverberation time for each band, the rendered duration for
+    /// bands without any absorption
+    [[nodiscard]] auto reverberationTimes() const -> std::vector<quantity<isq::duration[si::second]>>;
+
+    /// Schroeder frequency for the mean reverberation time of the 500Hz & 1kHz
+    /// bands, at most 40% of the sample rate
+    [[nodiscard]] auto crossover() const -> quantity<isq::frequency[si::hertz]>;
+
+    [[nodiscard]] auto operator()() const -> Result;
+
+private:
+    [[nodiscard]] auto renderWave() const -> std::vector<double>;
+    [[nodiscard]] auto renderGeometric() const -> std::vector<double>;
+
+    Spec _spec;
+};
+
+namespace detail {
+
+/// Decay envelope exp(-6.91 t / T60) for a 60dB drop after T60 seconds
+auto applyDecay(std::span<double> impulse, double sampleRate, double T60) -> void;
+
+/// Energy histograms per band to a pressure response. Each band is white
+/// noise filtered to the band, scaled in every histogram bin to carry the
+/// bin's energy.
+[[nodiscard]] auto histogramsToImpulse(
+    std::span<std::vector<double> const> histograms,
+    std::span<quantity<isq::frequency[si::hertz]> const> frequencies,
+    double binDuration,
+    double sampleRate,
+    std::uint32_t seed
+) -> std::vector<double>;
+
+}  // namespace detail
+
+}  // namespace ra
@@ -0,0 +1,142 @@
+#include "HybridRenderer.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+TEST_CASE("RaumAkustik: HybridRenderer", "")
+{
+    using namespace mp_units::si::unit_symbols;
+
+    auto const frequencies = std::vector{125.0 * Hz, 250.0 * Hz, 500.0 * Hz, 1000.0 * Hz, 2000.0 * Hz};
+    auto const absorption  = std::vector{0.3, 0.3, 0.3, 0.3, 0.3};
+    auto const scattering  = std::vector{0.5, 0.5, 0.5, 0.5, 0.5};
+
+    auto const roomAbsorption = ra::RoomAbsorption{
+        .front   = absorption,
+        .back    = absorption,
+        .left    = absorption,
+        .right   = absorption,
+        .ceiling = absorption,
+        .floor   = absorption,
+    };
+
+    auto const renderer = ra::HybridRenderer{{
+        .room = {
+            .dimensions = {.length = 3.0 * m, .width = 2.5 * m, .height = 2.4 * m},
+            .absorption = roomAbsorption,
+            .reflection = ra::makeReflection(roomAbsorption),
+            .scattering = {
+                .front   = scattering,
+                .back    = scattering,
+                .left    = scattering,
+                .right   = scattering,
+                .ceiling = scattering,
+                .floor   = scattering,
+            },
+            .source   = {0.5, 0.6, 1.2},
+            .receiver = {2.2, 1.7, 1.2},
+        },
+        .frequencies = frequencies,
+        .duration    = 0.3 * s,
+        .rays        = 2'000,
+    }};
+
+    // V=18m3, A=41.4m2*0.3
+    auto const times = renderer.reverberationTimes();
+    REQUIRE(times.size() == frequencies.size());
+    REQUIRE(times[0].numerical_value_in(s) == Catch::Approx(0.161 * 18.0 / (41.4 * 0.3)));
+    REQUIRE(renderer.crossover().numerical_value_in(Hz) == Catch::Approx(2000.0 * std::sqrt(0.161 / (41.4 * 0.3))));
+
+    auto const result = renderer();
+    REQUIRE(result.sampleRate == Catch::Approx(48'000.0));
+    REQUIRE(result.impulse.size() == 14'400);
+    REQUIRE(result.wave.size() == result.impulse.size());
+    REQUIRE(result.geometric.size() == result.impulse.size());
+    REQUIRE(std::all_of(result.impulse.begin(), result.impulse.end(), [](auto x) { return std::isfinite(x); }));
+
+    auto const energy = [](auto const& buf) { return std::inner_product(buf.begin(), buf.end(), buf.begin(), 0.0); };
+    REQUIRE(energy(result.wave) > 0.0);
+    REQUIRE(energy(result.geometric) > 0.0);
+
+    for (auto i{0UL}; i < result.impulse.size(); ++i) {
+        REQUIRE(result.impulse[i] == Catch::Approx(result.wave[i] + result.geometric[i]));
+    }
+}
+
+TEST_CASE("RaumAkustik: HybridRenderer(rigid)", "")
+{
+    using namespace mp_units::si::unit_symbols;
+
+    auto const frequencies = std::vector{125.0 * Hz, 250.0 * Hz, 500.0 * Hz, 1000.0 * Hz};
+    auto const rigid       = std::vector{0.0, 0.0, 0.0, 0.0};
+    auto const scattering  = std::vector{0.5, 0.5, 0.5, 0.5};
+
+    auto const roomAbsorption = ra::RoomAbsorption{
+        .front   = rigid,
+        .back    = rigid,
+        .left    = rigid,
+        .right   = rigid,
+        .ceiling = rigid,
+        .floor   = rigid,
+    };
+
+    auto const renderer = ra::HybridRenderer{{
+        .room = {
+            .dimensions = {.length = 3.0 * m, .width = 2.5 * m, .height = 2.4 * m},
+            .absorption = roomAbsorption,
+            .reflection = ra::makeReflection(roomAbsorption),
+            .scattering = {
+                .front   = scattering,
+                .back    = scattering,
+                .left    = scattering,
+                .right   = scattering,
+                .ceiling = scattering,
+                .floor   = scattering,
+            },
+            .source   = {0.5, 0.6, 1.2},
+            .receiver = {2.2, 1.7, 1.2},
+        },
+        .frequencies = frequencies,
+        .duration    = 0.2 * s,
+        .rays        = 500,
+    }};
+
+    // No decay within the rendering instead of an infinite one
+    auto const times = renderer.reverberationTimes();
+    for (auto const& t : times) {
+        REQUIRE(t.numerical_value_in(s) == Catch::Approx(0.2));
+    }
+    REQUIRE(renderer.crossover().numerical_value_in(Hz) == Catch::Approx(2000.0 * std::sqrt(0.2 / 18.0)));
+
+    auto const result = renderer();
+    REQUIRE(result.impulse.size() == 9'600);
+    REQUIRE(std::all_of(result.impulse.begin(), result.impulse.end(), [](auto x) { return std::isfinite(x); }));
+}
+
+TEST_CASE("RaumAkustik: HybridRenderer histogramsToImpulse", "")
+{
+    using namespace mp_units::si::unit_symbols;
+
+    auto const frequencies = std::vector{1000.0 * Hz, 30'000.0 * Hz};
+    auto const histograms  = std::vector<std::vector<double>>{
+        {0.0, 0.5, 0.25, 0.0},
+        {1.0, 1.0, 1.0, 1.0},
+    };
+
+    auto const impulse = ra::detail::histogramsToImpulse(histograms, frequencies, 0.001, 48'000.0, 1);
+    REQUIRE(impulse.size() == 192);
+
+    // Each bin carries the energy of its histogram entry, bands above nyquist are skipped
+    auto const binEnergy = [&](std::size_t bin) {
+        auto const first = std::next(impulse.begin(), static_cast<std::ptrdiff_t>(bin * 48));
+        return std::inner_product(first, std::next(first, 48), first, 0.0);
+    };
+    REQUIRE(binEnergy(0) == Catch::Approx(0.0));
+    REQUIRE(binEnergy(1) == Catch::Approx(0.5));
+    REQUIRE(binEnergy(2) == Catch::Approx(0.25));
+    REQUIRE(binEnergy(3) == Catch::Approx(0.0));
+}
@@ -0,0 +1,93 @@
+#include "ImpulseResponseAnalysis.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+namespace ra {
+
+auto schroederIntegral(std::span<double const> impulse) -> std::vector<double>
+{
+    auto decay = std::vector<double>(impulse.size());
+    auto sum   = 0.0;
+    for (auto i{impulse.size()}; i > 0; --i) {
+        sum += impulse[i - 1] * impulse[i - 1];
+        decay[i - 1] = sum;
+    }
+
+    auto const total = std::max(sum, 1e-300);
+    std::transform(decay.begin(), decay.end(), decay.begin(), [total](auto energy) {
+        return 10.0 * std::log10(std::max(energy / total, 1e-30));
+    });
+    return decay;
+}
+
+auto analyzeImpulseResponse(std::span<double const> impulse, quantity<isq::frequency[si::hertz]> sampleRate)
+    -> ImpulseResponseParameters
+{
+    auto const fs = sampleRate.numerical_value_in(si::hertz);
+
+    auto const peak = std::max_element(impulse.begin(), impulse.end(), [](auto l, auto r) {
+        return std::abs(l) < std::abs(r);
+    });
+    if (peak == impulse.end()) {
+        return {};
+    }
+
+    auto const response = impulse.subspan(static_cast<std::size_t>(std::distance(impulse.begin(), peak)));
+    auto const decay    = schroederIntegral(response);
+
+    // Least squares fit of the decay between both levels, extrapolated to -60 dB
+    auto const reverberationTime = [&](double upper, double lower) {
+        auto const first = std::find_if(decay.begin(), decay.end(), [upper](auto db) { return db <= upper; });
+        auto const last  = std::find_if(first, decay.end(), [lower](auto db) { return db < lower; });
+        if (last == decay.end() or std::distance(first, last) < 2) {
+            return 0.0 * si::second;
+        }
+
+        auto const offset = std::distance(decay.begin(), first);
+        auto const count  = static_cast<double>(std::distance(first, last));
+        auto sumT         = 0.0;
+        auto sumL         = 0.0;
+        auto sumTT        = 0.0;
+        auto sumTL        = 0.0;
+        for (auto it{first}; it != last; ++it) {
+            auto const t = static_cast<double>(offset + std::distance(first, it)) / fs;
+            sumT += t;
+            sumL += *it;
+            sumTT += t * t;
+            sumTL += t * *it;
+        }
+
+        auto const slope = (count * sumTL - sumT * sumL) / (count * sumTT - sumT * sumT);
+        return -60.0 / slope * si::second;
+    };
+
+    // Energy before & after the boundary in milliseconds
+    auto const split = [&](double ms) {
+        auto const boundary = std::min(static_cast<std::size_t>(ms / 1000.0 * fs), response.size());
+        auto const energy   = [](auto first, auto last) {
+            return std::transform_reduce(first, last, 0.0, std::plus{}, [](auto x) { return x * x; });
+        };
+        auto const early = energy(response.begin(), std::next(response.begin(), static_cast<std::ptrdiff_t>(boundary)));
+        auto const late  = energy(std::next(response.begin(), static_cast<std::ptrdiff_t>(boundary)), response.end());
+        return std::pair{early, late};
+    };
+
+    auto const [early50, late50] = split(50.0);
+    auto const [early80, late80] = split(80.0);
+
+    return ImpulseResponseParameters{
+        .edt = reverberationTime(0.0, -10.0),
+        .t20 = reverberationTime(-5.0, -25.0),
+        .t30 = reverberationTime(-5.0, -35.0),
+        .c50 = 10.0 * std::log10(early50 / std::max(late50, 1e-300)),
+        .c80 = 10.0 * std::log10(early80 / std::max(late80, 1e-300)),
+        .d50 = early50 / std::max(early50 + late50, 1e-300),
+    };
+}
+
+}  // namespace ra
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <ra/unit/unit.hpp>
+
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Room acoustic parameters from an impulse response, ISO 3382-1
+struct ImpulseResponseParameters
+{
+    /// Early decay time, from the first 10 dB of the decay
+    quantity<isq::duration[si::second]> edt{};
+
+    /// Reverberation time extrapolated from -5 to -25 dB
+    quantity<isq::duration[si::second]> t20{};
+
+    /// Reverberation time extrapolated from -5 to -35 dB
+    quantity<isq::duration[si::second]> t30{};
+
+    /// Clarity for speech & music in dB
+    double c50{0.0};
+    double c80{0.0};
+
+    /// Definition, early to total energy ratio
+    double d50{0.0};
+};
+
+/// Backward integrated energy decay in dB, 0 dB at the first sample
+[[nodiscard]] auto schroederIntegral(std::span<double const> impulse) -> std::vector<double>;
+
+/// The response starts at its absolute peak and should be cropped before
+/// the noise floor, there is no noise compensation. Reverberation times are
+/// zero if the decay has too few samples in the evaluation range.
+[[nodiscard]] auto analyzeImpulseResponse(
+    std::span<double const> impulse,
+    quantity<isq::frequency[si::hertz]> sampleRate
+) -> ImpulseResponseParameters;
+
+}  // namespace ra
@@ -0,0 +1,51 @@
+#include "ImpulseResponseAnalysis.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("RaumAkustik: schroederIntegral", "")
+{
+    auto const impulse = std::vector{1.0, 0.0, 1.0, 0.0};
+    auto const decay   = ra::schroederIntegral(impulse);
+    REQUIRE(decay.size() == 4);
+    REQUIRE(decay[0] == Catch::Approx(0.0));
+    REQUIRE(decay[1] == Catch::Approx(-3.0103).margin(1e-4));
+    REQUIRE(decay[2] == Catch::Approx(-3.0103).margin(1e-4));
+    REQUIRE(decay[3] < -200.0);
+}
+
+TEST_CASE("RaumAkustik: analyzeImpulseResponse", "")
+{
+    using ra::si::unit_symbols::Hz;
+
+    // Exponential decay with a reverberation time of 2s after a silent
+    // pre-delay, alternating signs to stay free of DC
+    auto const fs = 16'000.0;
+    auto const rt = 2.0;
+
+    auto impulse = std::vector<double>(100, 0.0);
+    for (auto i{0}; i < static_cast<int>(fs * 3.0); ++i) {
+        auto const t    = i / fs;
+        auto const sign = i % 2 == 0 ? 1.0 : -1.0;
+        impulse.push_back(sign * std::pow(10.0, -3.0 * t / rt));
+    }
+
+    auto const params = ra::analyzeImpulseResponse(impulse, fs * Hz);
+    REQUIRE(params.edt.numerical_value_in(ra::si::second) == Catch::Approx(rt).epsilon(0.01));
+    REQUIRE(params.t20.numerical_value_in(ra::si::second) == Catch::Approx(rt).epsilon(0.01));
+    REQUIRE(params.t30.numerical_value_in(ra::si::second) == Catch::Approx(rt).epsilon(0.01));
+
+    // Energy decays with exp(-t / tau)
+    auto const tau  = rt / (6.0 * std::log(10.0));
+    auto const late = [tau](double boundary) { return std::exp(-boundary / tau); };
+    REQUIRE(params.c50 == Catch::Approx(10.0 * std::log10((1.0 - late(0.05)) / late(0.05))).margin(0.01));
+    REQUIRE(params.c80 == Catch::Approx(10.0 * std::log10((1.0 - late(0.08)) / late(0.08))).margin(0.01));
+    REQUIRE(params.d50 == Catch::Approx(1.0 - late(0.05)).margin(0.001));
+
+    auto const silence = std::vector<double>(1'000, 0.0);
+    REQUIRE(ra::analyzeImpulseResponse(silence, fs * Hz).t30.numerical_value_in(ra::si::second) == 0.0);
+    REQUIRE(ra::analyzeImpulseResponse({}, fs * Hz).t30.numerical_value_in(ra::si::second) == 0.0);
+}
@@ -20,4 +20,17 @@ namespace ra {
     return std::clamp(T_m, 0.2, 0.4) * si::second;
 }
 
+/// Sabine's formula
+///
+/// T = 0.161 * V / A
+///
+/// V is the volume
+/// A is the equivalent absorption area, the sum of all surfaces times their absorption coefficient
+[[nodiscard]] auto sabineReverberationTime(QuantityOf<isq::volume> auto V, QuantityOf<isq::area> auto A) noexcept
+    -> QuantityOf<isq::duration> auto
+{
+    auto const T = 0.161 * V.numerical_value_in(cubic(si::metre)) / A.numerical_value_in(square(si::metre));
+    return T * si::second;
+}
+
 }  // namespace ra
@@ -12,3 +12,11 @@ TEST_CASE("RaumAkustik: nominalReverberationTime", "")
     REQUIRE(ra::nominalReverberationTime(6.0 * 3.65 * 3.12 * m3).numerical_value_in(s) == Catch::Approx(0.2201943874));
     REQUIRE(ra::nominalReverberationTime(10.0 * 20.0 * 30.0 * m3).numerical_value_in(s) == Catch::Approx(0.40));
 }
+
+TEST_CASE("RaumAkustik: sabineReverberationTime", "")
+{
+    using namespace mp_units::si::unit_symbols;
+
+    REQUIRE(ra::sabineReverberationTime(100.0 * m3, 16.1 * m2).numerical_value_in(s) == Catch::Approx(1.0));
+    REQUIRE(ra::sabineReverberationTime(200.0 * m3, 16.1 * m2).numerical_value_in(s) == Catch::Approx(2.0));
+}
@@ -5,13 +5,55 @@
 #include <fmt/format.h>
 #include <fmt/os.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <fstream>
+#include <future>
+#include <type_traits>
 
 namespace ra {
 
+namespace detail {
+
+struct CheckpointHeader
+{
+    static constexpr auto magicBytes     = std::array<char, 4>{'R', 'A', 'W', 'C'};
+    static constexpr auto currentVersion = std::uint32_t{1};
+
+    std::array<char, 4> magic{magicBytes};
+    std::uint32_t version{currentVersion};
+
+    // Grid the checkpoint was taken from, resuming on a different one is rejected
+    std::uint64_t Nx{0};
+    std::uint64_t Ny{0};
+    std::uint64_t Nt{0};
+    std::uint64_t layer{0};
+    double dx{0};
+    double dt{0};
+    FdtdScheme scheme{FdtdScheme::StandardLeapfrog};
+    FdtdPrecision precision{FdtdPrecision::Float64};
+
+    std::uint64_t timeStep{0};
+    std::uint64_t receiver{0};
+};
+
+auto convertField(auto in, auto out) -> void
+{
+    using To = typename decltype(out)::value_type;
+
+    for (auto x{0UL}; x < in.extent(0); ++x) {
+        for (auto y{0UL}; y < in.extent(1); ++y) {
+            out(x, y) = static_cast<To>(in(x, y));
+        }
+    }
+}
+
+}  // namespace detail
+
 WaveEquation2D::WaveEquation2D(Spec const& spec) : _spec{spec} {}
 
-auto WaveEquation2D::operator()(Callback const& callback) const -> void
+auto WaveEquation2D::grid() const -> Grid
 {
     // Speed of sound (m/s)
     static constexpr auto const c = 343.0;
@@ -20,33 +62,137 @@ auto WaveEquation2D::operator()(Callback const& callback) const -> void
     auto const dx = c / _spec.fmax.numerical_value_in(si::hertz) / _spec.ppw;
 
     // Time step (CFL condition)
-    auto const dt = std::sqrt(0.5) * dx / c;
-    auto const fs = 1.0 / dt;
+    auto const dt = courantNumber2D(_spec.scheme) * dx / c;
 
     // Number of time steps
     auto const T  = _spec.duration.numerical_value_in(si::second);
     auto const Nt = static_cast<size_t>(std::ceil(T / dt));
 
     // Number of grid points
-    auto const Nx = static_cast<size_t>(std::ceil(_spec.Lx.numerical_value_in(si::metre) / dx));
-    auto const Ny = static_cast<size_t>(std::ceil(_spec.Ly.numerical_value_in(si::metre) / dx));
+    auto const layer = _spec.absorbingLayer;
+    auto const Nx    = static_cast<size_t>(std::ceil(_spec.Lx.numerical_value_in(si::metre) / dx)) + 2 * layer;
+    auto const Ny    = static_cast<size_t>(std::ceil(_spec.Ly.numerical_value_in(si::metre) / dx)) + 2 * layer;
 
-    // Initialize pressure fields
-    auto uBuf     = stdex::mdarray<double, stdex::dextents<std::size_t, 2>>{Nx, Ny};
-    auto uPrevBuf = stdex::mdarray<double, stdex::dextents<std::size_t, 2>>{Nx, Ny};
-    auto uNextBuf = stdex::mdarray<double, stdex::dextents<std::size_t, 2>>{Nx, Ny};
-    auto Kib      = stdex::mdarray<std::uint8_t, stdex::dextents<std::size_t, 2>>{Nx, Ny};
+    return {.dx = dx, .dt = dt, .Nx = Nx, .Ny = Ny, .Nt = Nt, .layer = layer};
+}
 
-    auto u     = uBuf.to_mdspan();
-    auto uPrev = uPrevBuf.to_mdspan();
-    auto uNext = uNextBuf.to_mdspan();
+auto WaveEquation2D::initialState() const -> State
+{
+    auto const [dx, dt, Nx, Ny, Nt, layer] = grid();
+
+    auto state = State{
+        .timeStep = 0,
+        .u        = stdex::mdarray<double, stdex::dextents<std::size_t, 2>>{Nx, Ny},
+        .uPrev    = stdex::mdarray<double, stdex::dextents<std::size_t, 2>>{Nx, Ny},
+        .receiver = {},
+    };
+    state.receiver.reserve(Nt);
+
+    // Source location and initial condition, relative to the room without the absorbing layer
+    auto const roomX = Nx - 2 * layer;
+    auto const roomY = Ny - 2 * layer;
+
+    if (_spec.source) {
+        auto const [x, y] = cell(*_spec.source);
+        state.u(x, y)     = 1.0;
+        state.uPrev(x, y) = 1.0;
+        return state;
+    }
 
-    // Source location and initial condition
-    u(Nx / 4, Ny / 4)     = 1.0;
-    u(Nx / 4 * 3, Ny / 4) = -1.0;
+    state.u(layer + roomX / 4, layer + roomY / 4)     = 1.0;
+    state.u(layer + roomX / 4 * 3, layer + roomY / 4) = -1.0;
 
-    // Update equation function with Neumann boundary conditions
-    auto const delta = std::pow(c * dt / dx, 2.0);
+    return state;
+}
+
+auto WaveEquation2D::cell(glm::dvec2 position) const -> std::pair<std::size_t, std::size_t>
+{
+    auto const g     = grid();
+    auto const index = [&g](double p, std::size_t size) {
+        auto const i = static_cast<std::size_t>(std::max(std::round(p / g.dx), 0.0));
+        return g.layer + std::clamp<std::size_t>(i, 1, size - 2 * g.layer - 2);
+    };
+    return {index(position.x, g.Nx), index(position.y, g.Ny)};
+}
+
+auto WaveEquation2D::operator()(Callback const& callback) const -> void
+{
+    auto state = initialState();
+    (*this)(state, callback);
+}
+
+auto WaveEquation2D::operator()(State& state, Callback const& callback) const -> void
+{
+    (*this)(state, callback, Checkpoint{});
+}
+
+auto WaveEquation2D::operator()(
+    State& state,
+    Callback const& callback,
+    Checkpoint const& checkpoint,
+    std::stop_token stop
+) const -> void
+{
+    static constexpr auto slf = FdtdScheme::StandardLeapfrog;
+    static constexpr auto iwb = FdtdScheme::InterpolatedWideband;
+
+    auto const single = _spec.precision == FdtdPrecision::Float32;
+    switch (_spec.scheme) {
+        case slf: return single ? run<slf, float>(state, callback, checkpoint, stop)
+                                : run<slf, double>(state, callback, checkpoint, stop);
+        case iwb: return single ? run<iwb, float>(state, callback, checkpoint, stop)
+                                : run<iwb, double>(state, callback, checkpoint, stop);
+        default: break;
+    }
+}
+
+template<FdtdScheme Scheme, typename Float>
+auto WaveEquation2D::run(State& state, Callback const& callback, Checkpoint const& checkpoint, std::stop_token stop)
+    const -> void
+{
+    using Field = stdex::mdarray<Float, stdex::dextents<std::size_t, 2>>;
+
+    auto const [dx, dt, Nx, Ny, Nt, layer] = grid();
+    auto const fs                          = 1.0 / dt;
+    auto const absorbing                   = AbsorbingLayer<Float>{Nx, Ny, layer, courantNumber<Scheme, 2>()};
+
+    // Receiver cell
+    auto const [rx, ry] = _spec.receiver ? cell(*_spec.receiver) : std::pair{Nx / 2, Ny / 2};
+
+    // Double precision runs work directly on the state, single precision
+    // runs on a copy which is written back before checkpoints & on exit.
+    auto uBuf     = Field{};
+    auto uPrevBuf = Field{};
+    auto uNextBuf = Field{Nx, Ny};
+    if constexpr (not std::is_same_v<Float, double>) {
+        uBuf     = Field{Nx, Ny};
+        uPrevBuf = Field{Nx, Ny};
+        detail::convertField(state.u.to_mdspan(), uBuf.to_mdspan());
+        detail::convertField(state.uPrev.to_mdspan(), uPrevBuf.to_mdspan());
+    }
+
+    auto u = [&] {
+        if constexpr (std::is_same_v<Float, double>) {
+            return state.u.to_mdspan();
+        } else {
+            return uBuf.to_mdspan();
+        }
+    }();
+    auto uPrev = [&] {
+        if constexpr (std::is_same_v<Float, double>) {
+            return state.uPrev.to_mdspan();
+        } else {
+            return uPrevBuf.to_mdspan();
+        }
+    }();
+    auto uNext = uNextBuf.to_mdspan();
+
+    auto const syncState = [&] {
+        if constexpr (not std::is_same_v<Float, double>) {
+            detail::convertField(u, state.u.to_mdspan());
+            detail::convertField(uPrev, state.uPrev.to_mdspan());
+        }
+    };
 
     fmt::println(
         "Wave: {}x{} Nt={} dx={:.1f}mm fs={:.0f}Hz fmax={:.0f}Hz",
@@ -58,23 +204,34 @@ auto WaveEquation2D::operator()(Callback const& callback) const -> void
         _spec.fmax.numerical_value_in(si::hertz)
     );
 
-    for (auto t{0U}; t < Nt; ++t) {
-        for (auto x{1U}; x < Nx - 1U; ++x) {
-            for (auto y{1U}; y < Ny - 1U; ++y) {
-                auto const prev   = uPrev(x, y);
-                auto const now    = u(x, y);
-                auto const right  = u(x + 1, y);
-                auto const left   = u(x - 1, y);
-                auto const top    = u(x, y + 1);
-                auto const bottom = u(x, y - 1);
+    // At most one checkpoint is in flight, the solver only waits if the
+    // previous one is still being written when the next one is due.
+    auto pending    = std::future<bool>{};
+    auto const save = [&](std::uint64_t completedSteps) {
+        if (pending.valid()) {
+            pending.wait();
+        }
+
+        syncState();
 
-                uNext(x, y) = (2 * now - prev + delta * (right - 2 * now + left) + delta * (top - 2 * now + bottom));
+        auto copy     = state;
+        copy.timeStep = completedSteps;
+        pending       = std::async(std::launch::async, [this, copy = std::move(copy), path = checkpoint.path] {
+            return writeCheckpoint(copy, path);
+        });
+    };
 
-                // u0 = in_mask * (0.5*(right + left + top + bottom) - prev);
-                // uNext(x, y) = 0.5 * (right + left + top + bottom) - prev;
+    for (; state.timeStep < Nt; ++state.timeStep) {
+        if (stop.stop_requested()) {
+            if (checkpoint.interval != 0) {
+                save(state.timeStep);
             }
+            break;
         }
 
+        fdtdUpdate<Scheme, Float>(u, uPrev, uNext);
+        absorbing.apply(uPrev, uNext);
+
         // Neumann boundary conditions (rigid walls)
         auto const leftEdge   = stdex::submdspan(uNext, 0, stdex::full_extent);
         auto const leftInside = stdex::submdspan(uNext, 1, stdex::full_extent);
@@ -95,10 +252,112 @@ auto WaveEquation2D::operator()(Callback const& callback) const -> void
         neo::copy(u, uPrev);
         neo::copy(uNext, u);
 
+        state.receiver.push_back(static_cast<double>(u(rx, ry)));
+
         if (callback) {
-            callback(u);
+            callback(stdex::mdspan<Float const, stdex::dextents<std::size_t, 2>>{u});
         }
+
+        if (checkpoint.interval != 0 and (state.timeStep + 1) % checkpoint.interval == 0) {
+            save(state.timeStep + 1);
+        }
+    }
+
+    syncState();
+
+    if (pending.valid()) {
+        pending.wait();
+    }
+}
+
+auto WaveEquation2D::writeCheckpoint(State const& state, std::filesystem::path const& path) const -> bool
+{
+    auto const g      = grid();
+    auto const header = detail::CheckpointHeader{
+        .Nx        = g.Nx,
+        .Ny        = g.Ny,
+        .Nt        = g.Nt,
+        .layer     = g.layer,
+        .dx        = g.dx,
+        .dt        = g.dt,
+        .scheme    = _spec.scheme,
+        .precision = _spec.precision,
+        .timeStep  = state.timeStep,
+        .receiver  = state.receiver.size(),
+    };
+
+    if (state.u.extent(0) != g.Nx or state.u.extent(1) != g.Ny or state.uPrev.extents() != state.u.extents()) {
+        return false;
     }
+
+    // Write next to the target and rename, so a crash while writing never
+    // destroys the previous checkpoint.
+    auto tmp = path;
+    tmp += ".tmp";
+
+    {
+        auto out = std::ofstream{tmp, std::ios::binary | std::ios::trunc};
+        if (not out) {
+            return false;
+        }
+
+        auto const field = static_cast<std::streamsize>(g.Nx * g.Ny * sizeof(double));
+        out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        out.write(reinterpret_cast<char const*>(state.u.to_mdspan().data_handle()), field);
+        out.write(reinterpret_cast<char const*>(state.uPrev.to_mdspan().data_handle()), field);
+        out.write(
+            reinterpret_cast<char const*>(state.receiver.data()),
+            static_cast<std::streamsize>(state.receiver.size() * sizeof(double))
+        );
+        if (not out) {
+            return false;
+        }
+    }
+
+    auto error = std::error_code{};
+    std::filesystem::rename(tmp, path, error);
+    return not error;
+}
+
+auto WaveEquation2D::readCheckpoint(std::filesystem::path const& path) const -> std::optional<State>
+{
+    auto in = std::ifstream{path, std::ios::binary};
+    if (not in) {
+        return std::nullopt;
+    }
+
+    auto header = detail::CheckpointHeader{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (not in or header.magic != detail::CheckpointHeader::magicBytes
+        or header.version != detail::CheckpointHeader::currentVersion) {
+        return std::nullopt;
+    }
+
+    // Same spec gives the same spacing, the tolerance only hides rounding
+    auto const g       = grid();
+    auto const differs = [](double a, double b) { return std::abs(a - b) > 1e-9 * std::abs(b); };
+    if (header.Nx != g.Nx or header.Ny != g.Ny or header.Nt != g.Nt or header.layer != g.layer
+        or differs(header.dx, g.dx) or differs(header.dt, g.dt) or header.scheme != _spec.scheme
+        or header.precision != _spec.precision or header.timeStep > g.Nt or header.receiver != header.timeStep) {
+        return std::nullopt;
+    }
+
+    auto state = initialState();
+    state.timeStep = header.timeStep;
+    state.receiver.resize(header.receiver);
+
+    auto const field = static_cast<std::streamsize>(g.Nx * g.Ny * sizeof(double));
+    in.read(reinterpret_cast<char*>(state.u.to_mdspan().data_handle()), field);
+    in.read(reinterpret_cast<char*>(state.uPrev.to_mdspan().data_handle()), field);
+    in.read(
+        reinterpret_cast<char*>(state.receiver.data()),
+        static_cast<std::streamsize>(state.receiver.size() * sizeof(double))
+    );
+    if (not in) {
+        return std::nullopt;
+    }
+
+    return state;
 }
 
 }  // namespace ra
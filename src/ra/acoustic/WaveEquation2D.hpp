@@ -1,17 +1,33 @@
 #pragma once
 
+#include <ra/acoustic/AbsorbingLayer.hpp>
+#include <ra/acoustic/FdtdStencil.hpp>
 #include <ra/unit/frequency.hpp>
 
 #include <neo/container/mdspan.hpp>
 
+#include <glm/glm.hpp>
+
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <functional>
+#include <optional>
+#include <stop_token>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace ra {
 
 struct WaveEquation2D
 {
-    using Callback = std::function<void(stdex::mdspan<double, stdex::dextents<std::size_t, 2>>)>;
+    /// Pressure field after a time step, in the precision the solver runs at
+    using Frame = std::variant<
+        stdex::mdspan<float const, stdex::dextents<std::size_t, 2>>,
+        stdex::mdspan<double const, stdex::dextents<std::size_t, 2>>>;
+
+    using Callback = std::function<void(Frame)>;
 
     struct Spec
     {
@@ -21,13 +37,82 @@ struct WaveEquation2D
         quantity<isq::duration[si::second]> duration;
         quantity<isq::frequency[si::hertz]> fmax;
         double ppw{6.0};
+        FdtdScheme scheme{FdtdScheme::StandardLeapfrog};
+        FdtdPrecision precision{FdtdPrecision::Float64};
+
+        /// Thickness of the absorbing layer around the room in grid cells.
+        /// 0 gives rigid walls, otherwise the room is in free-field.
+        std::size_t absorbingLayer{0};
+
+        /// Positions in metres relative to the room. The source is a unit
+        /// impulse at rest, without one the field starts from a dipole.
+        /// Without a receiver the center of the grid is recorded.
+        std::optional<glm::dvec2> source{};
+        std::optional<glm::dvec2> receiver{};
+    };
+
+    struct Grid
+    {
+        double dx{0};
+        double dt{0};
+        std::size_t Nx{0};
+        std::size_t Ny{0};
+        std::size_t Nt{0};
+
+        /// Cells of absorbing layer on each side, included in Nx & Ny
+        std::size_t layer{0};
+    };
+
+    /// Everything needed to continue a run at timeStep. The fields are
+    /// always stored in double, single precision runs convert losslessly.
+    struct State
+    {
+        std::uint64_t timeStep{0};
+        stdex::mdarray<double, stdex::dextents<std::size_t, 2>> u;
+        stdex::mdarray<double, stdex::dextents<std::size_t, 2>> uPrev;
+
+        /// Pressure at the receiver, one sample per time step
+        std::vector<double> receiver;
+    };
+
+    struct Checkpoint
+    {
+        std::filesystem::path path;
+
+        /// Write every n-th time step, 0 disables checkpoints
+        std::size_t interval{0};
     };
 
     explicit WaveEquation2D(Spec const& spec);
 
+    [[nodiscard]] auto grid() const -> Grid;
+    [[nodiscard]] auto initialState() const -> State;
+
     auto operator()(Callback const& callback) const -> void;
+    auto operator()(State& state, Callback const& callback) const -> void;
+
+    /// Advances state until the end of the run or until a stop is requested.
+    /// Checkpoints are written on a background thread from a copy of the
+    /// state, a final one is written when the run is stopped early.
+    auto operator()(
+        State& state,
+        Callback const& callback,
+        Checkpoint const& checkpoint,
+        std::stop_token stop = {}
+    ) const -> void;
+
+    auto writeCheckpoint(State const& state, std::filesystem::path const& path) const -> bool;
+
+    /// Returns nullopt if the file is missing, corrupt or from a different grid
+    [[nodiscard]] auto readCheckpoint(std::filesystem::path const& path) const -> std::optional<State>;
 
 private:
+    [[nodiscard]] auto cell(glm::dvec2 position) const -> std::pair<std::size_t, std::size_t>;
+
+    template<FdtdScheme Scheme, typename Float>
+    auto run(State& state, Callback const& callback, Checkpoint const& checkpoint, std::stop_token stop) const
+        -> void;
+
     Spec _spec;
 };
 
@@ -0,0 +1,148 @@
+#include "WaveEquation2D.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <span>
+
+namespace {
+
+auto bitIdentical(std::span<double const> lhs, std::span<double const> rhs) -> bool
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    return std::memcmp(lhs.data(), rhs.data(), lhs.size_bytes()) == 0;
+}
+
+auto bitIdentical(auto const& lhs, auto const& rhs) -> bool
+    requires requires { lhs.to_mdspan(); }
+{
+    auto const l = lhs.to_mdspan();
+    auto const r = rhs.to_mdspan();
+    return bitIdentical(std::span{l.data_handle(), l.size()}, std::span{r.data_handle(), r.size()});
+}
+
+}  // namespace
+
+TEST_CASE("RaumAkustik: WaveEquation2D checkpoint", "")
+{
+    using namespace mp_units::si::unit_symbols;
+
+    auto const we = ra::WaveEquation2D({
+        .Lx       = 1.0 * m,
+        .Ly       = 1.5 * m,
+        .duration = 0.05 * s,
+        .fmax     = 500.0 * Hz,
+        .ppw      = 6.0,
+    });
+
+    auto const grid = we.grid();
+    auto const path = std::filesystem::temp_directory_path() / "ra_wave_equation_2d.checkpoint";
+    std::filesystem::remove(path);
+
+    auto expected = we.initialState();
+    we(expected, {});
+    REQUIRE(expected.timeStep == grid.Nt);
+    REQUIRE(expected.receiver.size() == grid.Nt);
+
+    SECTION("stopped run")
+    {
+        auto source = std::stop_source{};
+        auto steps  = 0UL;
+
+        auto interrupted = we.initialState();
+        we(interrupted, [&](auto) {
+            if (++steps == 25) {
+                source.request_stop();
+            }
+        }, {.path = path, .interval = 10}, source.get_token());
+        REQUIRE(interrupted.timeStep == 25);
+
+        auto resumed = we.readCheckpoint(path);
+        REQUIRE(resumed.has_value());
+        REQUIRE(resumed->timeStep == 25);
+
+        we(*resumed, {});
+        REQUIRE(resumed->timeStep == grid.Nt);
+        REQUIRE(bitIdentical(std::span{resumed->receiver}, std::span{expected.receiver}));
+        REQUIRE(bitIdentical(resumed->u, expected.u));
+        REQUIRE(bitIdentical(resumed->uPrev, expected.uPrev));
+    }
+
+    SECTION("interval")
+    {
+        auto state = we.initialState();
+        we(state, {}, {.path = path, .interval = 40});
+
+        auto resumed = we.readCheckpoint(path);
+        REQUIRE(resumed.has_value());
+        REQUIRE(resumed->timeStep == grid.Nt / 40 * 40);
+
+        we(*resumed, {});
+        REQUIRE(bitIdentical(std::span{resumed->receiver}, std::span{expected.receiver}));
+        REQUIRE(bitIdentical(resumed->u, expected.u));
+    }
+
+    SECTION("different grid")
+    {
+        REQUIRE(we.writeCheckpoint(expected, path));
+
+        auto const other = ra::WaveEquation2D({
+            .Lx       = 1.0 * m,
+            .Ly       = 1.5 * m,
+            .duration = 0.05 * s,
+            .fmax     = 400.0 * Hz,
+            .ppw      = 6.0,
+        });
+        REQUIRE_FALSE(other.readCheckpoint(path).has_value());
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("RaumAkustik: WaveEquation2D checkpoint single precision", "")
+{
+    using namespace mp_units::si::unit_symbols;
+
+    auto const we = ra::WaveEquation2D({
+        .Lx        = 1.0 * m,
+        .Ly        = 1.5 * m,
+        .duration  = 0.05 * s,
+        .fmax      = 500.0 * Hz,
+        .ppw       = 3.0,
+        .scheme    = ra::FdtdScheme::InterpolatedWideband,
+        .precision = ra::FdtdPrecision::Float32,
+    });
+
+    auto const grid = we.grid();
+    REQUIRE(grid.dt == Catch::Approx(grid.dx / 343.0));
+
+    auto const path = std::filesystem::temp_directory_path() / "ra_wave_equation_2d_float.checkpoint";
+    std::filesystem::remove(path);
+
+    auto expected = we.initialState();
+    we(expected, [](auto frame) { REQUIRE(frame.index() == 0); });
+
+    auto source = std::stop_source{};
+    auto steps  = 0UL;
+
+    auto interrupted = we.initialState();
+    we(interrupted, [&](auto) {
+        if (++steps == 30) {
+            source.request_stop();
+        }
+    }, {.path = path, .interval = 7}, source.get_token());
+
+    auto resumed = we.readCheckpoint(path);
+    REQUIRE(resumed.has_value());
+    REQUIRE(resumed->timeStep == 30);
+
+    we(*resumed, {});
+    REQUIRE(bitIdentical(std::span{resumed->receiver}, std::span{expected.receiver}));
+    REQUIRE(bitIdentical(resumed->u, expected.u));
+    REQUIRE(bitIdentical(resumed->uPrev, expected.uPrev));
+
+    std::filesystem::remove(path);
+}
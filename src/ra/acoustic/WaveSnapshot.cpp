@@ -0,0 +1,222 @@
+#include "WaveSnapshot.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace ra {
+
+auto bytesPerSample(WaveSnapshotEncoding encoding) noexcept -> std::size_t
+{
+    switch (encoding) {
+        case WaveSnapshotEncoding::Float32: return sizeof(float);
+        case WaveSnapshotEncoding::Float16: return sizeof(std::uint16_t);
+        case WaveSnapshotEncoding::Int16: return sizeof(std::int16_t);
+        default: break;
+    }
+    return 0;
+}
+
+auto recordSize(WaveSnapshotHeader const& header) noexcept -> std::size_t
+{
+    auto const numSamples = std::size_t{header.width} * std::size_t{header.height};
+    return sizeof(WaveSnapshotFrameInfo) + numSamples * bytesPerSample(header.encoding);
+}
+
+auto recordOffset(WaveSnapshotHeader const& header, std::size_t index) noexcept -> std::size_t
+{
+    return sizeof(WaveSnapshotHeader) + index * recordSize(header);
+}
+
+auto fileSize(WaveSnapshotHeader const& header) noexcept -> std::size_t
+{
+    return recordOffset(header, static_cast<std::size_t>(header.capacity));
+}
+
+namespace detail {
+
+auto decimateImpl(auto field, std::size_t factor, std::span<float> out) -> void
+{
+    auto const width  = (field.extent(0) + factor - 1) / factor;
+    auto const height = (field.extent(1) + factor - 1) / factor;
+    assert(out.size() >= width * height);
+
+    for (auto x{0UL}; x < width; ++x) {
+        for (auto y{0UL}; y < height; ++y) {
+            out[x * height + y] = static_cast<float>(field(x * factor, y * factor));
+        }
+    }
+}
+
+}  // namespace detail
+
+auto decimate(
+    stdex::mdspan<float const, stdex::dextents<std::size_t, 2>> field,
+    std::size_t factor,
+    std::span<float> out
+) -> void
+{
+    detail::decimateImpl(field, factor, out);
+}
+
+auto decimate(
+    stdex::mdspan<double const, stdex::dextents<std::size_t, 2>> field,
+    std::size_t factor,
+    std::span<float> out
+) -> void
+{
+    detail::decimateImpl(field, factor, out);
+}
+
+auto encodeWaveSnapshot(
+    WaveSnapshotHeader const& header,
+    std::span<float const> frame,
+    std::uint64_t timeStep,
+    std::span<std::byte> record
+) -> void
+{
+    assert(record.size() >= recordSize(header));
+    assert(frame.size() == std::size_t{header.width} * std::size_t{header.height});
+
+    auto const absLess = [](auto l, auto r) { return std::abs(l) < std::abs(r); };
+    auto const peak    = frame.empty() ? 0.0F : std::abs(*std::max_element(frame.begin(), frame.end(), absLess));
+
+    auto info     = WaveSnapshotFrameInfo{.timeStep = timeStep};
+    auto* samples = std::next(record.data(), sizeof(WaveSnapshotFrameInfo));
+
+    switch (header.encoding) {
+        case WaveSnapshotEncoding::Float32: {
+            std::memcpy(samples, frame.data(), frame.size_bytes());
+            break;
+        }
+        case WaveSnapshotEncoding::Float16: {
+            info.scale = peak > 0.0F ? peak : 1.0F;
+            for (auto i{0UL}; i < frame.size(); ++i) {
+                auto const half = detail::floatToHalf(frame[i] / info.scale);
+                std::memcpy(std::next(samples, static_cast<std::ptrdiff_t>(i * sizeof(half))), &half, sizeof(half));
+            }
+            break;
+        }
+        case WaveSnapshotEncoding::Int16: {
+            static constexpr auto maxInt = static_cast<float>(std::numeric_limits<std::int16_t>::max());
+
+            info.scale = peak > 0.0F ? peak / maxInt : 1.0F;
+            for (auto i{0UL}; i < frame.size(); ++i) {
+                auto const value = static_cast<std::int16_t>(std::lround(frame[i] / info.scale));
+                std::memcpy(std::next(samples, static_cast<std::ptrdiff_t>(i * sizeof(value))), &value, sizeof(value));
+            }
+            break;
+        }
+        default: break;
+    }
+
+    std::memcpy(record.data(), &info, sizeof(info));
+}
+
+auto decodeWaveSnapshot(WaveSnapshotHeader const& header, std::span<std::byte const> record, std::span<float> frame)
+    -> WaveSnapshotFrameInfo
+{
+    assert(record.size() >= recordSize(header));
+    assert(frame.size() == std::size_t{header.width} * std::size_t{header.height});
+
+    auto info = WaveSnapshotFrameInfo{};
+    std::memcpy(&info, record.data(), sizeof(info));
+
+    auto const* samples = std::next(record.data(), sizeof(WaveSnapshotFrameInfo));
+
+    switch (header.encoding) {
+        case WaveSnapshotEncoding::Float32: {
+            std::memcpy(frame.data(), samples, frame.size_bytes());
+            break;
+        }
+        case WaveSnapshotEncoding::Float16: {
+            for (auto i{0UL}; i < frame.size(); ++i) {
+                auto half = std::uint16_t{};
+                std::memcpy(&half, std::next(samples, static_cast<std::ptrdiff_t>(i * sizeof(half))), sizeof(half));
+                frame[i] = detail::halfToFloat(half) * info.scale;
+            }
+            break;
+        }
+        case WaveSnapshotEncoding::Int16: {
+            for (auto i{0UL}; i < frame.size(); ++i) {
+                auto value = std::int16_t{};
+                std::memcpy(&value, std::next(samples, static_cast<std::ptrdiff_t>(i * sizeof(value))), sizeof(value));
+                frame[i] = static_cast<float>(value) * info.scale;
+            }
+            break;
+        }
+        default: break;
+    }
+
+    return info;
+}
+
+namespace detail {
+
+auto floatToHalf(float value) noexcept -> std::uint16_t
+{
+    auto const bits     = std::bit_cast<std::uint32_t>(value);
+    auto const sign     = (bits >> 16U) & 0x8000U;
+    auto const exponent = static_cast<int>((bits >> 23U) & 0xFFU) - 127 + 15;
+    auto mantissa       = bits & 0x7FFFFFU;
+
+    // Inf & NaN
+    if (((bits >> 23U) & 0xFFU) == 0xFFU) {
+        return static_cast<std::uint16_t>(sign | 0x7C00U | (mantissa != 0U ? 0x200U : 0U));
+    }
+
+    // Overflow
+    if (exponent >= 31) {
+        return static_cast<std::uint16_t>(sign | 0x7C00U);
+    }
+
+    // Subnormal or zero
+    if (exponent <= 0) {
+        if (exponent < -10) {
+            return static_cast<std::uint16_t>(sign);
+        }
+
+        mantissa |= 0x800000U;
+        auto const shift   = static_cast<unsigned>(14 - exponent);
+        auto const halfway = 1U << (shift - 1U);
+        auto const rest    = mantissa & ((1U << shift) - 1U);
+        auto half          = mantissa >> shift;
+        if (rest > halfway or (rest == halfway and (half & 1U) != 0U)) {
+            ++half;
+        }
+        return static_cast<std::uint16_t>(sign | half);
+    }
+
+    // Round to nearest even, a carry into the exponent is still correct
+    auto half       = (static_cast<unsigned>(exponent) << 10U) | (mantissa >> 13U);
+    auto const rest = mantissa & 0x1FFFU;
+    if (rest > 0x1000U or (rest == 0x1000U and (half & 1U) != 0U)) {
+        ++half;
+    }
+    return static_cast<std::uint16_t>(sign | half);
+}
+
+auto halfToFloat(std::uint16_t value) noexcept -> float
+{
+    auto const sign     = static_cast<std::uint32_t>(value & 0x8000U) << 16U;
+    auto const exponent = static_cast<std::uint32_t>((value >> 10U) & 0x1FU);
+    auto const mantissa = static_cast<std::uint32_t>(value & 0x3FFU);
+
+    if (exponent == 0U) {
+        auto const magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0U ? -magnitude : magnitude;
+    }
+
+    if (exponent == 31U) {
+        return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13U));
+    }
+
+    return std::bit_cast<float>(sign | ((exponent + 112U) << 23U) | (mantissa << 13U));
+}
+
+}  // namespace detail
+
+}  // namespace ra
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <neo/container/mdspan.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace ra {
+
+enum struct WaveSnapshotEncoding : std::uint32_t
+{
+    Float32,
+    Float16,
+    Int16,
+};
+
+/// File header of a recorded FDTD run. The file is a fixed size header
+/// followed by fixed size frame records, so the byte offset of every frame
+/// can be computed from its index without a separate lookup table.
+struct WaveSnapshotHeader
+{
+    static constexpr auto magicBytes     = std::array<char, 4>{'R', 'A', 'W', 'S'};
+    static constexpr auto currentVersion = std::uint32_t{1};
+
+    std::array<char, 4> magic{magicBytes};
+    std::uint32_t version{currentVersion};
+    WaveSnapshotEncoding encoding{WaveSnapshotEncoding::Float16};
+
+    /// Extents of the stored (decimated) frames
+    std::uint32_t width{0};
+    std::uint32_t height{0};
+
+    /// Keep every n-th grid point in both dimensions
+    std::uint32_t spatialDecimation{1};
+
+    /// Keep every n-th time step
+    std::uint32_t temporalDecimation{1};
+
+    std::uint32_t reserved{0};
+
+    /// Sample-rate of the solver (1/dt)
+    double sampleRate{0.0};
+
+    /// Number of frames the file has room for
+    std::uint64_t capacity{0};
+
+    /// Number of frames written so far
+    std::uint64_t frameCount{0};
+};
+
+/// Stored in front of every frame
+struct WaveSnapshotFrameInfo
+{
+    /// Time step of the solver this frame was taken from
+    std::uint64_t timeStep{0};
+
+    /// Multiply decoded samples by this to get the original pressure
+    float scale{1.0F};
+
+    std::uint32_t reserved{0};
+};
+
+[[nodiscard]] auto bytesPerSample(WaveSnapshotEncoding encoding) noexcept -> std::size_t;
+
+/// Size of one frame record including its WaveSnapshotFrameInfo
+[[nodiscard]] auto recordSize(WaveSnapshotHeader const& header) noexcept -> std::size_t;
+
+/// Byte offset of the frame record at index
+[[nodiscard]] auto recordOffset(WaveSnapshotHeader const& header, std::size_t index) noexcept -> std::size_t;
+
+/// Size of the whole file once all frames have been written
+[[nodiscard]] auto fileSize(WaveSnapshotHeader const& header) noexcept -> std::size_t;
+
+/// Copies every n-th grid point of field into out, out must hold ceil(Nx/n) * ceil(Ny/n) samples.
+auto decimate(
+    stdex::mdspan<float const, stdex::dextents<std::size_t, 2>> field,
+    std::size_t factor,
+    std::span<float> out
+) -> void;
+
+auto decimate(
+    stdex::mdspan<double const, stdex::dextents<std::size_t, 2>> field,
+    std::size_t factor,
+    std::span<float> out
+) -> void;
+
+/// Quantizes a decimated frame into a record. The scale is chosen per frame
+/// from the absolute peak, so quiet late frames keep their resolution.
+auto encodeWaveSnapshot(
+    WaveSnapshotHeader const& header,
+    std::span<float const> frame,
+    std::uint64_t timeStep,
+    std::span<std::byte> record
+) -> void;
+
+auto decodeWaveSnapshot(WaveSnapshotHeader const& header, std::span<std::byte const> record, std::span<float> frame)
+    -> WaveSnapshotFrameInfo;
+
+namespace detail {
+
+[[nodiscard]] auto floatToHalf(float value) noexcept -> std::uint16_t;
+[[nodiscard]] auto halfToFloat(std::uint16_t value) noexcept -> float;
+
+}  // namespace detail
+
+}  // namespace ra
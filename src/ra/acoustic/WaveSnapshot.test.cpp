@@ -0,0 +1,82 @@
+#include "WaveSnapshot.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+TEST_CASE("RaumAkustik: detail::floatToHalf", "")
+{
+    using ra::detail::floatToHalf;
+    using ra::detail::halfToFloat;
+
+    REQUIRE(floatToHalf(0.0F) == 0x0000U);
+    REQUIRE(floatToHalf(1.0F) == 0x3C00U);
+    REQUIRE(floatToHalf(-2.0F) == 0xC000U);
+    REQUIRE(floatToHalf(65504.0F) == 0x7BFFU);
+    REQUIRE(floatToHalf(1e6F) == 0x7C00U);
+
+    REQUIRE(halfToFloat(0x3C00U) == 1.0F);
+    REQUIRE(halfToFloat(0xC000U) == -2.0F);
+    REQUIRE(halfToFloat(0x0001U) == Catch::Approx(5.9604645e-8));
+
+    for (auto const value : {0.5F, -0.25F, 0.1F, 0.333F, 1e-4F}) {
+        REQUIRE(halfToFloat(floatToHalf(value)) == Catch::Approx(value).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("RaumAkustik: encodeWaveSnapshot", "")
+{
+    auto field = stdex::mdarray<double, stdex::dextents<std::size_t, 2>>{5, 3};
+    for (auto x{0UL}; x < field.extent(0); ++x) {
+        for (auto y{0UL}; y < field.extent(1); ++y) {
+            field(x, y) = static_cast<double>(x) * 0.1 - static_cast<double>(y) * 0.05;
+        }
+    }
+
+    for (auto const encoding : {
+             ra::WaveSnapshotEncoding::Float32,
+             ra::WaveSnapshotEncoding::Float16,
+             ra::WaveSnapshotEncoding::Int16,
+         }) {
+        auto const header = ra::WaveSnapshotHeader{
+            .encoding          = encoding,
+            .width             = 3,
+            .height            = 2,
+            .spatialDecimation = 2,
+            .capacity          = 4,
+        };
+
+        auto frame = std::vector<float>(6);
+        ra::decimate(field.to_mdspan(), header.spatialDecimation, frame);
+        REQUIRE(frame[0] == Catch::Approx(0.0));
+        REQUIRE(frame[1] == Catch::Approx(-0.1));
+        REQUIRE(frame[5] == Catch::Approx(0.3));
+
+        auto record = std::vector<std::byte>(ra::recordSize(header));
+        ra::encodeWaveSnapshot(header, frame, 42, record);
+
+        auto decoded    = std::vector<float>(6);
+        auto const info = ra::decodeWaveSnapshot(header, record, decoded);
+        REQUIRE(info.timeStep == 42);
+        for (auto i{0UL}; i < frame.size(); ++i) {
+            REQUIRE(decoded[i] == Catch::Approx(frame[i]).margin(1e-4));
+        }
+    }
+}
+
+TEST_CASE("RaumAkustik: recordOffset", "")
+{
+    auto const header = ra::WaveSnapshotHeader{
+        .encoding = ra::WaveSnapshotEncoding::Int16,
+        .width    = 10,
+        .height   = 20,
+        .capacity = 3,
+    };
+
+    auto const record = sizeof(ra::WaveSnapshotFrameInfo) + 10 * 20 * 2;
+    REQUIRE(ra::recordSize(header) == record);
+    REQUIRE(ra::recordOffset(header, 0) == sizeof(ra::WaveSnapshotHeader));
+    REQUIRE(ra::recordOffset(header, 2) == sizeof(ra::WaveSnapshotHeader) + 2 * record);
+    REQUIRE(ra::fileSize(header) == sizeof(ra::WaveSnapshotHeader) + 3 * record);
+}
@@ -0,0 +1,168 @@
+#include "AbsorberOptimizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <future>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <utility>
+
+namespace ra {
+
+namespace detail {
+
+auto paretoFront(std::vector<AbsorberOptimizer::Candidate> candidates) -> std::vector<AbsorberOptimizer::Candidate>
+{
+    std::stable_sort(candidates.begin(), candidates.end(), [](auto const& lhs, auto const& rhs) {
+        if (lhs.depth != rhs.depth) {
+            return lhs.depth < rhs.depth;
+        }
+        return lhs.cost < rhs.cost;
+    });
+
+    auto front = std::vector<AbsorberOptimizer::Candidate>{};
+    for (auto const& candidate : candidates) {
+        if (front.empty() or candidate.cost < front.back().cost) {
+            front.push_back(candidate);
+        }
+    }
+    return front;
+}
+
+}  // namespace detail
+
+AbsorberOptimizer::AbsorberOptimizer(Spec spec) : _spec{std::move(spec)}
+{
+    assert(_spec.target.empty() or _spec.target.size() == _spec.frequencies.size());
+}
+
+auto AbsorberOptimizer::cost(std::span<double const> absorption) const -> double
+{
+    if (_spec.target.empty()) {
+        auto const sum = std::accumulate(absorption.begin(), absorption.end(), 0.0);
+        return 1.0 - sum / static_cast<double>(absorption.size());
+    }
+
+    auto sum = 0.0;
+    for (auto i{0UL}; i < absorption.size(); ++i) {
+        auto const error = absorption[i] - _spec.target[i];
+        sum += error * error;
+    }
+    return std::sqrt(sum / static_cast<double>(absorption.size()));
+}
+
+auto AbsorberOptimizer::cost(PorousAbsorberSpecs const& specs) const -> double
+{
+    auto const angles = std::array{_spec.angle};
+    auto alpha        = std::vector<double>(_spec.frequencies.size());
+
+    auto sweep = PorousAbsorberSweep{};
+    if (specs.airGap.numerical_value_in(si::metre) > 0.0) {
+        sweep.absorptionFactorWithAirGap = alpha;
+    } else {
+        sweep.absorptionFactorNoAirGap = alpha;
+    }
+    propertiesOfAbsorber(specs, _spec.environment, _spec.frequencies, angles, sweep);
+
+    return cost(alpha);
+}
+
+auto AbsorberOptimizer::operator()() const -> std::vector<Candidate>
+{
+    auto const maxDepth = _spec.maxDepth.numerical_value_in(si::metre);
+    auto const tMin     = _spec.thickness.min.numerical_value_in(si::metre);
+    auto const gapMin   = _spec.airGap.min.numerical_value_in(si::metre);
+    auto const gapMax   = _spec.airGap.max.numerical_value_in(si::metre);
+    auto const tMax     = std::min(_spec.thickness.max.numerical_value_in(si::metre), maxDepth - gapMin);
+    auto const mismatch = not _spec.target.empty() and _spec.target.size() != _spec.frequencies.size();
+    if (_spec.candidates == 0 or _spec.frequencies.empty() or mismatch or tMax < tMin) {
+        return {};
+    }
+
+    // Latin hypercube, each dimension is split into equal strata and every
+    // stratum is hit exactly once. Generated upfront, so the result does not
+    // depend on the number of threads.
+    auto const count = _spec.candidates;
+    auto rng         = std::mt19937{_spec.seed};
+    auto jitter      = std::uniform_real_distribution<double>{0.0, 1.0};
+    auto const unit  = [&] {
+        auto strata = std::vector<std::size_t>(count);
+        std::iota(strata.begin(), strata.end(), 0UL);
+        std::shuffle(strata.begin(), strata.end(), rng);
+
+        auto samples = std::vector<double>(count);
+        for (auto i{0UL}; i < count; ++i) {
+            samples[i] = (static_cast<double>(strata[i]) + jitter(rng)) / static_cast<double>(count);
+        }
+        return samples;
+    };
+
+    auto const thickness = unit();
+    auto const flow      = unit();
+    auto const gap       = unit();
+
+    // Flow resistivity spans decades and is sampled log-uniform, the air gap
+    // range shrinks with the depth left over by the absorber.
+    auto const logFlowMin = std::log(_spec.flowResisitivity.min);
+    auto const logFlowMax = std::log(_spec.flowResisitivity.max);
+    auto const candidate  = [&](std::size_t i) {
+        auto const t   = tMin + thickness[i] * (tMax - tMin);
+        auto const top = std::min(gapMax, maxDepth - t);
+        auto const g   = std::clamp(gapMin + gap[i] * std::max(top - gapMin, 0.0), gapMin, gapMax);
+
+        return PorousAbsorberSpecs{
+            .thickness        = t * si::metre,
+            .flowResisitivity = std::exp(logFlowMin + flow[i] * (logFlowMax - logFlowMin)),
+            .airGap           = g * si::metre,
+        };
+    };
+
+    auto const search = [&](std::size_t first, std::size_t last) {
+        auto const angles = std::array{_spec.angle};
+        auto alpha        = std::vector<double>(_spec.frequencies.size());
+        auto withGap      = PorousAbsorberSweep{.absorptionFactorWithAirGap = alpha};
+        auto noGap        = PorousAbsorberSweep{.absorptionFactorNoAirGap = alpha};
+
+        auto results = std::vector<Candidate>{};
+        results.reserve(last - first);
+        for (auto i{first}; i < last; ++i) {
+            auto const specs = candidate(i);
+            auto const& out  = specs.airGap.numerical_value_in(si::metre) > 0.0 ? withGap : noGap;
+            propertiesOfAbsorber(specs, _spec.environment, _spec.frequencies, angles, out);
+
+            auto const depth = specs.thickness.numerical_value_in(si::metre)
+                             + specs.airGap.numerical_value_in(si::metre);
+            results.push_back(Candidate{
+                .specs = specs,
+                .depth = depth * si::metre,
+                .cost  = cost(alpha),
+            });
+        }
+        return detail::paretoFront(std::move(results));
+    };
+
+    auto const hardware = std::max(std::thread::hardware_concurrency(), 1U);
+    auto const threads  = std::min<std::size_t>(_spec.threads == 0 ? hardware : _spec.threads, count);
+    if (threads <= 1) {
+        return search(0, count);
+    }
+
+    auto const chunk = (count + threads - 1) / threads;
+    auto tasks       = std::vector<std::future<std::vector<Candidate>>>{};
+    for (auto first{0UL}; first < count; first += chunk) {
+        tasks.push_back(std::async(std::launch::async, search, first, std::min(first + chunk, count)));
+    }
+
+    // The global front is a subset of the union of the local ones
+    auto fronts = std::vector<Candidate>{};
+    for (auto& task : tasks) {
+        auto const front = task.get();
+        fronts.insert(fronts.end(), front.begin(), front.end());
+    }
+    return detail::paretoFront(std::move(fronts));
+}
+
+}  // namespace ra
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <ra/acoustic/absorber/PorousAbsorber.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Global search over thickness, flow resistivity & air gap of a porous
+/// absorber with a Latin hypercube. Candidates are evaluated in parallel
+/// with the batched propertiesOfAbsorber, the result is the Pareto front of
+/// total depth vs. cost.
+struct AbsorberOptimizer
+{
+    template<typename T>
+    struct Interval
+    {
+        T min;
+        T max;
+    };
+
+    struct Spec
+    {
+        AtmosphericEnvironment environment;
+
+        /// Evaluation frequencies in Hz
+        std::vector<double> frequencies;
+
+        /// Absorption per frequency, empty or the same size as frequencies.
+        /// Cost is the rms error against the target, without one it is
+        /// 1 - mean absorption.
+        std::vector<double> target{};
+
+        Interval<quantity<isq::thickness[si::metre]>> thickness;
+        Interval<double> flowResisitivity;
+        Interval<quantity<isq::distance[si::metre]>> airGap;
+
+        /// Limit for thickness + air gap
+        quantity<isq::thickness[si::metre]> maxDepth;
+
+        /// Angle of incidence in degree
+        double angle{0.0};
+
+        std::size_t candidates{100'000};
+
+        /// 0 uses all hardware threads
+        std::size_t threads{0};
+
+        std::uint32_t seed{42};
+    };
+
+    struct Candidate
+    {
+        PorousAbsorberSpecs specs;
+        quantity<isq::thickness[si::metre]> depth;
+        double cost{0.0};
+    };
+
+    explicit AbsorberOptimizer(Spec spec);
+
+    /// Cost of a single design, lower is better
+    [[nodiscard]] auto cost(PorousAbsorberSpecs const& specs) const -> double;
+
+    /// Pareto optimal candidates, sorted by increasing depth & decreasing cost
+    [[nodiscard]] auto operator()() const -> std::vector<Candidate>;
+
+private:
+    [[nodiscard]] auto cost(std::span<double const> absorption) const -> double;
+
+    Spec _spec;
+};
+
+namespace detail {
+
+/// Removes dominated candidates, a candidate is kept if no other one is at
+/// most as deep and strictly cheaper.
+[[nodiscard]] auto paretoFront(std::vector<AbsorberOptimizer::Candidate> candidates)
+    -> std::vector<AbsorberOptimizer::Candidate>;
+
+}  // namespace detail
+
+}  // namespace ra
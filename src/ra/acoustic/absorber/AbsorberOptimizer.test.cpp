@@ -0,0 +1,105 @@
+#include "AbsorberOptimizer.hpp"
+
+#include <ra/unit/pressure.hpp>
+#include <ra/unit/temperature.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+static constexpr auto C20 = ra::AtmosphericEnvironment{ra::celciusToKelvin(20.0), ra::OneAtmosphere<double>};
+
+[[nodiscard]] static auto makeSpec() -> ra::AbsorberOptimizer::Spec
+{
+    using ra::si::unit_symbols::mm;
+
+    return ra::AbsorberOptimizer::Spec{
+        .environment      = C20,
+        .frequencies      = {63.0, 80.0, 100.0, 125.0, 160.0, 200.0, 250.0},
+        .thickness        = {25.0 * mm, 200.0 * mm},
+        .flowResisitivity = {2'000.0, 40'000.0},
+        .airGap           = {0.0 * mm, 200.0 * mm},
+        .maxDepth         = 300.0 * mm,
+        .candidates       = 2'000,
+    };
+}
+
+TEST_CASE("RaumAkustik: AbsorberOptimizer", "")
+{
+    using ra::si::unit_symbols::mm;
+
+    auto const spec      = makeSpec();
+    auto const optimizer = ra::AbsorberOptimizer{spec};
+    auto const front     = optimizer();
+    REQUIRE(front.size() > 1);
+
+    for (auto i{0UL}; i < front.size(); ++i) {
+        auto const& candidate = front[i];
+        REQUIRE(candidate.depth <= spec.maxDepth);
+        REQUIRE(candidate.specs.thickness >= spec.thickness.min);
+        REQUIRE(candidate.specs.thickness <= spec.thickness.max);
+        REQUIRE(candidate.cost == Catch::Approx(optimizer.cost(candidate.specs)));
+
+        if (i > 0) {
+            REQUIRE(candidate.depth > front[i - 1].depth);
+            REQUIRE(candidate.cost < front[i - 1].cost);
+        }
+    }
+
+    // Deeper treatments absorb more bass
+    REQUIRE(front.back().cost < 0.3);
+    REQUIRE(front.back().depth > 200.0 * mm);
+
+    auto single    = spec;
+    single.threads = 1;
+    auto const ref = ra::AbsorberOptimizer{single}();
+    REQUIRE(ref.size() == front.size());
+    for (auto i{0UL}; i < ref.size(); ++i) {
+        REQUIRE(ref[i].cost == front[i].cost);
+        REQUIRE(ref[i].depth == front[i].depth);
+    }
+}
+
+TEST_CASE("RaumAkustik: AbsorberOptimizer(target)", "")
+{
+    using ra::si::unit_symbols::mm;
+
+    auto const known = ra::PorousAbsorberSpecs{100.0 * mm, 8'000.0, 100.0 * mm};
+
+    auto spec = makeSpec();
+    for (auto const f : spec.frequencies) {
+        auto const alpha = ra::propertiesOfAbsorber(known, C20, f * ra::si::hertz, 0.0);
+        spec.target.push_back(alpha.absorptionFactorWithAirGap);
+    }
+
+    auto const optimizer = ra::AbsorberOptimizer{spec};
+    REQUIRE(optimizer.cost(known) == Catch::Approx(0.0).margin(1e-9));
+
+    auto const front = optimizer();
+    REQUIRE(front.back().cost < 0.05);
+}
+
+TEST_CASE("RaumAkustik: AbsorberOptimizer(infeasible)", "")
+{
+    using ra::si::unit_symbols::mm;
+
+    auto spec     = makeSpec();
+    spec.maxDepth = 10.0 * mm;
+    REQUIRE(ra::AbsorberOptimizer{spec}().empty());
+}
+
+TEST_CASE("RaumAkustik: paretoFront", "")
+{
+    using ra::si::unit_symbols::mm;
+
+    auto const make = [](double depth, double cost) {
+        return ra::AbsorberOptimizer::Candidate{.specs = {}, .depth = depth * mm, .cost = cost};
+    };
+
+    auto const front = ra::detail::paretoFront({make(50, 0.5), make(100, 0.6), make(100, 0.3), make(20, 0.9)});
+    REQUIRE(front.size() == 3);
+    REQUIRE(front[0].cost == Catch::Approx(0.9));
+    REQUIRE(front[1].cost == Catch::Approx(0.5));
+    REQUIRE(front[2].cost == Catch::Approx(0.3));
+}
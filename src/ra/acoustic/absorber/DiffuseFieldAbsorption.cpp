@@ -0,0 +1,161 @@
+#include "DiffuseFieldAbsorption.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <numbers>
+#include <numeric>
+#include <thread>
+
+namespace ra {
+
+namespace detail {
+
+auto gaussLegendre(std::size_t order) -> std::pair<std::vector<double>, std::vector<double>>
+{
+    auto nodes   = std::vector<double>(order);
+    auto weights = std::vector<double>(order);
+
+    auto const n = static_cast<double>(order);
+    for (auto i{0UL}; i < (order + 1) / 2; ++i) {
+        // Initial guess, then newton iterations on the Legendre polynomial P_n
+        auto x  = std::cos(std::numbers::pi * (static_cast<double>(i) + 0.75) / (n + 0.5));
+        auto dp = 0.0;
+        for (auto iteration{0}; iteration < 100; ++iteration) {
+            auto p0 = 1.0;
+            auto p1 = 0.0;
+            for (auto j{1UL}; j <= order; ++j) {
+                auto const k     = static_cast<double>(j);
+                auto const pPrev = p1;
+                p1               = p0;
+                p0               = ((2.0 * k - 1.0) * x * p1 - (k - 1.0) * pPrev) / k;
+            }
+
+            dp = n * (x * p0 - p1) / (x * x - 1.0);
+
+            auto const dx = p0 / dp;
+            x -= dx;
+            if (std::abs(dx) < 1e-15) {
+                break;
+            }
+        }
+
+        nodes[i]               = -x;
+        nodes[order - 1 - i]   = x;
+        weights[i]             = 2.0 / ((1.0 - x * x) * dp * dp);
+        weights[order - 1 - i] = weights[i];
+    }
+
+    return {nodes, weights};
+}
+
+}  // namespace detail
+
+auto diffuseFieldAbsorption(
+    PorousAbsorberSpecs specs,
+    AtmosphericEnvironment env,
+    std::span<double const> frequencies,
+    DiffuseFieldOptions const& options
+) -> std::vector<double>
+{
+    auto const [nodes, weights] = detail::gaussLegendre(options.angles);
+
+    // Map [-1, 1] to [0, pi/2] and fold sin(2 theta) into the weights
+    auto angles  = std::vector<double>(nodes.size());
+    auto factors = std::vector<double>(nodes.size());
+    for (auto i{0UL}; i < nodes.size(); ++i) {
+        auto const theta = std::numbers::pi / 4.0 * (nodes[i] + 1.0);
+        angles[i]        = theta * 180.0 / std::numbers::pi;
+        factors[i]       = std::numbers::pi / 4.0 * weights[i] * std::sin(2.0 * theta);
+    }
+
+    auto const withAirGap = specs.airGap.numerical_value_in(si::metre) > 0.0;
+
+    auto const solve = [&](std::span<double const> freqs, std::span<double> out) {
+        auto const numAngles = angles.size();
+
+        // Frequency major, all angles of a frequency are adjacent
+        auto f     = std::vector<double>(freqs.size() * numAngles);
+        auto theta = std::vector<double>(f.size());
+        auto alpha = std::vector<double>(f.size());
+        for (auto i{0UL}; i < freqs.size(); ++i) {
+            auto const offset = static_cast<std::ptrdiff_t>(i * numAngles);
+            std::fill_n(std::next(f.begin(), offset), numAngles, freqs[i]);
+            std::copy(angles.begin(), angles.end(), std::next(theta.begin(), offset));
+        }
+
+        auto sweep = PorousAbsorberSweep{};
+        if (withAirGap) {
+            sweep.absorptionFactorWithAirGap = alpha;
+        } else {
+            sweep.absorptionFactorNoAirGap = alpha;
+        }
+        propertiesOfAbsorber(specs, env, f, theta, sweep);
+
+        for (auto i{0UL}; i < freqs.size(); ++i) {
+            auto sum = 0.0;
+            for (auto a{0UL}; a < numAngles; ++a) {
+                sum += factors[a] * alpha[i * numAngles + a];
+            }
+            out[i] = sum;
+        }
+    };
+
+    auto result = std::vector<double>(frequencies.size());
+
+    auto const hardware = std::max(std::thread::hardware_concurrency(), 1U);
+    auto const threads  = std::min<std::size_t>(options.threads == 0 ? hardware : options.threads, frequencies.size());
+    if (threads <= 1) {
+        solve(frequencies, result);
+        return result;
+    }
+
+    auto const chunk = (frequencies.size() + threads - 1) / threads;
+    auto tasks       = std::vector<std::future<void>>{};
+    for (auto first{0UL}; first < frequencies.size(); first += chunk) {
+        auto const count = std::min(chunk, frequencies.size() - first);
+        tasks.push_back(std::async(std::launch::async, [&solve, &result, frequencies, first, count] {
+            solve(frequencies.subspan(first, count), std::span{result}.subspan(first, count));
+        }));
+    }
+
+    for (auto& task : tasks) {
+        task.get();
+    }
+
+    return result;
+}
+
+auto diffuseFieldAbsorption(
+    PorousAbsorberSpecs specs,
+    AtmosphericEnvironment env,
+    std::span<quantity<isq::frequency[si::hertz]> const> centers,
+    DiffuseFieldOptions const& options
+) -> std::vector<double>
+{
+    auto const points = std::max(options.pointsPerBand, std::size_t(1));
+
+    // Points at the centers of equal log-width slices of each band
+    auto frequencies = std::vector<double>{};
+    frequencies.reserve(centers.size() * points);
+    for (auto const& center : centers) {
+        auto const fc = center.numerical_value_in(si::hertz);
+        for (auto i{0UL}; i < points; ++i) {
+            auto const position = (static_cast<double>(i) + 0.5) / static_cast<double>(points) - 0.5;
+            frequencies.push_back(fc * std::pow(2.0, position * options.bandwidth));
+        }
+    }
+
+    auto const alpha = diffuseFieldAbsorption(specs, env, frequencies, options);
+
+    auto bands = std::vector<double>(centers.size());
+    for (auto band{0UL}; band < centers.size(); ++band) {
+        auto const first = std::next(alpha.begin(), static_cast<std::ptrdiff_t>(band * points));
+        bands[band]      = std::accumulate(first, std::next(first, static_cast<std::ptrdiff_t>(points)), 0.0)
+                    / static_cast<double>(points);
+    }
+
+    return bands;
+}
+
+}  // namespace ra
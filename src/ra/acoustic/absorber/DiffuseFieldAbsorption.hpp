@@ -0,0 +1,58 @@
+#pragma once
+
+#include <ra/acoustic/absorber/PorousAbsorber.hpp>
+#include <ra/unit/frequency.hpp>
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ra {
+
+struct DiffuseFieldOptions
+{
+    /// Gauss-Legendre nodes between 0 and 90 degree
+    std::size_t angles{32};
+
+    /// Log spaced frequencies averaged for each band
+    std::size_t pointsPerBand{8};
+
+    /// Bandwidth in octaves
+    double bandwidth{1.0 / 3.0};
+
+    /// 0 uses all hardware threads
+    std::size_t threads{0};
+};
+
+/// Random-incidence absorption coefficient with Paris' formula
+///
+/// a_d = integral_0^(pi/2) a(theta) * sin(2 theta) dtheta
+///
+/// The absorption with air gap is used if the absorber has one. Frequencies
+/// are in Hz, the frequency range is split across threads and each thread
+/// evaluates all of its frequency & angle pairs in one batched call.
+[[nodiscard]] auto diffuseFieldAbsorption(
+    PorousAbsorberSpecs specs,
+    AtmosphericEnvironment env,
+    std::span<double const> frequencies,
+    DiffuseFieldOptions const& options = {}
+) -> std::vector<double>;
+
+/// Band averaged diffuse-field absorption, usable as RoomAbsorption for
+/// the raytracer when the centers match its simulation frequencies.
+[[nodiscard]] auto diffuseFieldAbsorption(
+    PorousAbsorberSpecs specs,
+    AtmosphericEnvironment env,
+    std::span<quantity<isq::frequency[si::hertz]> const> centers,
+    DiffuseFieldOptions const& options = {}
+) -> std::vector<double>;
+
+namespace detail {
+
+/// Nodes & weights on [-1, 1]
+[[nodiscard]] auto gaussLegendre(std::size_t order) -> std::pair<std::vector<double>, std::vector<double>>;
+
+}  // namespace detail
+
+}  // namespace ra
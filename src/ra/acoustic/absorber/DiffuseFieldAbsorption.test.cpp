@@ -0,0 +1,87 @@
+#include "DiffuseFieldAbsorption.hpp"
+
+#include <ra/acoustic/Air.hpp>
+#include <ra/unit/pressure.hpp>
+#include <ra/unit/temperature.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <vector>
+
+static constexpr auto C20 = ra::AtmosphericEnvironment{ra::celciusToKelvin(20.0), ra::OneAtmosphere<double>};
+
+TEST_CASE("RaumAkustik: gaussLegendre", "")
+{
+    auto const [nodes, weights] = ra::detail::gaussLegendre(5);
+    REQUIRE(nodes.size() == 5);
+    REQUIRE(std::accumulate(weights.begin(), weights.end(), 0.0) == Catch::Approx(2.0));
+    REQUIRE(nodes[2] == Catch::Approx(0.0).margin(1e-15));
+    REQUIRE(nodes[4] == Catch::Approx(0.9061798459));
+    REQUIRE(weights[4] == Catch::Approx(0.2369268851));
+
+    // Exact for polynomials up to degree 2n-1
+    auto sum = 0.0;
+    for (auto i{0UL}; i < nodes.size(); ++i) {
+        sum += weights[i] * std::pow(nodes[i], 8.0);
+    }
+    REQUIRE(sum == Catch::Approx(2.0 / 9.0));
+}
+
+TEST_CASE("RaumAkustik: diffuseFieldAbsorption", "")
+{
+    using ra::si::unit_symbols::Hz;
+    using ra::si::unit_symbols::mm;
+
+    auto const specs       = ra::PorousAbsorberSpecs{100.0 * mm, 8'000.0, 50.0 * mm};
+    auto const frequencies = std::vector{63.0, 125.0, 250.0, 500.0, 1'000.0, 2'000.0, 4'000.0};
+
+    auto const alpha = ra::diffuseFieldAbsorption(specs, C20, frequencies);
+    REQUIRE(alpha.size() == frequencies.size());
+
+    // Midpoint rule with the scalar reference
+    for (auto i{0UL}; i < frequencies.size(); ++i) {
+        static constexpr auto steps = 2'000;
+
+        auto expected = 0.0;
+        for (auto step{0}; step < steps; ++step) {
+            auto const theta = (step + 0.5) / steps * std::numbers::pi / 2.0;
+            auto const angle = theta * 180.0 / std::numbers::pi;
+            auto const props = ra::propertiesOfAbsorber(specs, C20, frequencies[i] * Hz, angle);
+            expected += props.absorptionFactorWithAirGap * std::sin(2.0 * theta) * std::numbers::pi / 2.0 / steps;
+        }
+
+        REQUIRE(alpha[i] == Catch::Approx(expected).margin(1e-4));
+    }
+
+    auto const single = ra::diffuseFieldAbsorption(specs, C20, frequencies, {.threads = 1});
+    REQUIRE(single == alpha);
+}
+
+TEST_CASE("RaumAkustik: diffuseFieldAbsorption bands", "")
+{
+    using ra::si::unit_symbols::Hz;
+    using ra::si::unit_symbols::mm;
+
+    auto const specs = ra::PorousAbsorberSpecs{50.0 * mm, 10'000.0};
+    auto const bands = ra::thirdOctaveBands(100.0 * Hz, 5'000.0 * Hz);
+
+    auto const alpha = ra::diffuseFieldAbsorption(specs, C20, bands);
+    REQUIRE(alpha.size() == bands.size());
+    for (auto a : alpha) {
+        REQUIRE(a > 0.0);
+        REQUIRE(a < 1.0);
+    }
+
+    // Porous absorbers are far better at high frequencies
+    REQUIRE(alpha.back() > alpha.front());
+
+    // A single point per band is the value at the center
+    auto const center  = std::vector{bands[5].numerical_value_in(Hz)};
+    auto const atPoint = ra::diffuseFieldAbsorption(specs, C20, center);
+    auto const narrow  = ra::diffuseFieldAbsorption(specs, C20, std::span{bands}.subspan(5, 1), {.pointsPerBand = 1});
+    REQUIRE(narrow[0] == Catch::Approx(atPoint[0]));
+}
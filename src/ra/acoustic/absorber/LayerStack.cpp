@@ -0,0 +1,348 @@
+#include "LayerStack.hpp"
+
+#include <ra/acoustic/Air.hpp>
+#include <ra/acoustic/absorber/SplitComplex.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace ra {
+
+namespace detail {
+
+struct AirProperties
+{
+    double density{0};
+    double speed{0};
+    double impedance{0};
+    double pressure{0};
+
+    /// Dynamic viscosity, Sutherland's law
+    double viscosity{0};
+
+    static constexpr auto heatCapacityRatio = 1.4;
+    static constexpr auto prandtl           = 0.71;
+};
+
+[[nodiscard]] auto airProperties(AtmosphericEnvironment env) -> AirProperties
+{
+    using namespace mp_units::si::unit_symbols;
+
+    auto const T = env.temperature.numerical_value_in(si::kelvin);
+    return {
+        .density   = densityOfAir(env.temperature, env.pressure).numerical_value_in(kg / m3),
+        .speed     = soundVelocity(env.temperature).numerical_value_in(m / s),
+        .impedance = impedanceOfAir(env.temperature, env.pressure),
+        .pressure  = env.pressure.numerical_value_in(si::pascal),
+        .viscosity = 1.458e-6 * std::pow(T, 1.5) / (T + 110.4),
+    };
+}
+
+/// Relates pressure & normal velocity on the front to the ones on the back
+template<typename Batch>
+struct TransferMatrix
+{
+    SplitComplex<Batch> t11;
+    SplitComplex<Batch> t12;
+    SplitComplex<Batch> t21;
+    SplitComplex<Batch> t22;
+};
+
+template<typename Batch>
+[[nodiscard]] auto operator*(TransferMatrix<Batch> const& l, TransferMatrix<Batch> const& r) -> TransferMatrix<Batch>
+{
+    return {
+        .t11 = l.t11 * r.t11 + l.t12 * r.t21,
+        .t12 = l.t11 * r.t12 + l.t12 * r.t22,
+        .t21 = l.t21 * r.t11 + l.t22 * r.t21,
+        .t22 = l.t21 * r.t12 + l.t22 * r.t22,
+    };
+}
+
+/// Characteristic impedance & complex wavenumber of an equivalent fluid
+template<typename Batch>
+struct Propagation
+{
+    SplitComplex<Batch> impedance;
+    SplitComplex<Batch> waveNumber;
+};
+
+/// Layer in which a wave propagates with ky preserved across interfaces (Snell)
+template<typename Batch>
+[[nodiscard]] auto fluidLayer(Propagation<Batch> const& fluid, double thickness, Batch ky) -> TransferMatrix<Batch>
+{
+    using Complex = SplitComplex<Batch>;
+
+    auto const& k = fluid.waveNumber;
+    auto const kx = sqrt(k * k - Complex{ky * ky, Batch(0.0)});
+    auto const z  = fluid.impedance * (k / kx);
+    auto const kd = kx * Batch(thickness);
+    auto const c  = cos(kd);
+    auto const s  = sin(kd);
+    return {.t11 = c, .t12 = timesJ(z * s), .t21 = timesJ(s / z), .t22 = c};
+}
+
+/// Thin layer acting as a series impedance
+template<typename Batch>
+[[nodiscard]] auto seriesImpedance(SplitComplex<Batch> const& z) -> TransferMatrix<Batch>
+{
+    auto const one  = SplitComplex<Batch>{Batch(1.0), Batch(0.0)};
+    auto const zero = SplitComplex<Batch>{Batch(0.0), Batch(0.0)};
+    return {.t11 = one, .t12 = z, .t21 = zero, .t22 = one};
+}
+
+template<typename Batch>
+[[nodiscard]] auto propagation(DelanyBazley const& model, AirProperties const& air, Batch omega)
+    -> Propagation<Batch>
+{
+    // X = rho0 * f / sigma, powers as exp(e*ln(X))
+    auto const lnX = xsimd::log(omega * (air.density / (2.0 * std::numbers::pi * model.flowResisitivity)));
+    auto const k0  = omega / air.speed;
+    return {
+        .impedance = {
+            (1.0 + 0.0571 * xsimd::exp(-0.754 * lnX)) * air.impedance,
+            (-0.087 * xsimd::exp(-0.732 * lnX)) * air.impedance,
+        },
+        .waveNumber = {
+            (1.0 + 0.0978 * xsimd::exp(-0.7 * lnX)) * k0,
+            (-0.189 * xsimd::exp(-0.595 * lnX)) * k0,
+        },
+    };
+}
+
+template<typename Batch>
+[[nodiscard]] auto propagation(Miki const& model, AirProperties const& air, Batch omega) -> Propagation<Batch>
+{
+    // X = f / sigma
+    auto const lnX = xsimd::log(omega / (2.0 * std::numbers::pi * model.flowResisitivity));
+    auto const z   = xsimd::exp(-0.632 * lnX);
+    auto const k   = xsimd::exp(-0.618 * lnX);
+    auto const k0  = omega / air.speed;
+    return {
+        .impedance  = {(1.0 + 0.070 * z) * air.impedance, (-0.107 * z) * air.impedance},
+        .waveNumber = {(1.0 + 0.109 * k) * k0, (-0.160 * k) * k0},
+    };
+}
+
+template<typename Batch>
+[[nodiscard]] auto propagation(JohnsonChampouxAllard const& model, AirProperties const& air, Batch omega)
+    -> Propagation<Batch>
+{
+    using Complex = SplitComplex<Batch>;
+
+    auto const one   = Complex{Batch(1.0), Batch(0.0)};
+    auto const sigma = model.flowResisitivity;
+    auto const phi   = model.porosity;
+    auto const alpha = model.tortuosity;
+    auto const L     = model.viscousLength.numerical_value_in(si::metre);
+    auto const Lt    = model.thermalLength.numerical_value_in(si::metre);
+    auto const eta   = air.viscosity;
+    auto const rho0  = air.density;
+    auto const gamma = AirProperties::heatCapacityRatio;
+    auto const pr    = AirProperties::prandtl;
+
+    // Dynamic density, viscous effects
+    auto const gv  = 4.0 * alpha * alpha * eta * rho0 / (sigma * sigma * L * L * phi * phi);
+    auto const g   = sqrt(Complex{Batch(1.0), omega * gv});
+    auto const rho = (one + timesMinusJ(g * (sigma * phi / (rho0 * alpha) / omega))) * Batch(alpha * rho0 / phi);
+
+    // Dynamic bulk modulus, thermal effects
+    auto const gt = sqrt(Complex{Batch(1.0), omega * (pr * Lt * Lt * rho0 / (16.0 * eta))});
+    auto const ht = one + timesMinusJ(gt * (8.0 * eta / (Lt * Lt * pr * rho0) / omega));
+    auto const K  = Complex{Batch(gamma * air.pressure / phi), Batch(0.0)}
+                 / (Complex{Batch(gamma), Batch(0.0)} - (one / ht) * Batch(gamma - 1.0));
+
+    return {.impedance = sqrt(rho * K), .waveNumber = sqrt(rho / K) * omega};
+}
+
+template<typename Batch, typename Model>
+[[nodiscard]] auto transferMatrix(PorousLayer<Model> const& layer, AirProperties const& air, Batch omega, Batch ky)
+    -> TransferMatrix<Batch>
+{
+    return fluidLayer(propagation(layer.model, air, omega), layer.thickness.numerical_value_in(si::metre), ky);
+}
+
+template<typename Batch>
+[[nodiscard]] auto transferMatrix(AirLayer const& layer, AirProperties const& air, Batch omega, Batch ky)
+    -> TransferMatrix<Batch>
+{
+    auto const fluid = Propagation<Batch>{
+        .impedance  = {Batch(air.impedance), Batch(0.0)},
+        .waveNumber = {omega / air.speed, Batch(0.0)},
+    };
+    return fluidLayer(fluid, layer.thickness.numerical_value_in(si::metre), ky);
+}
+
+template<typename Batch>
+[[nodiscard]] auto transferMatrix(
+    ResistiveLayer const& layer,
+    AirProperties const& /*air*/,
+    Batch /*omega*/,
+    Batch /*ky*/
+) -> TransferMatrix<Batch>
+{
+    return seriesImpedance(SplitComplex<Batch>{Batch(layer.flowResistance), Batch(0.0)});
+}
+
+template<typename Batch>
+[[nodiscard]] auto transferMatrix(PerforatedPanel const& panel, AirProperties const& air, Batch omega, Batch /*ky*/)
+    -> TransferMatrix<Batch>
+{
+    // D.-Y. Maa, "Potential of microperforated panel absorber" (1998)
+    auto const t   = panel.thickness.numerical_value_in(si::metre);
+    auto const d   = panel.holeDiameter.numerical_value_in(si::metre);
+    auto const eps = panel.perforation;
+    auto const eta = air.viscosity;
+
+    auto const x  = xsimd::sqrt(omega * (air.density / (4.0 * eta))) * d;
+    auto const kr = xsimd::sqrt(1.0 + x * x / 32.0) + x * (std::numbers::sqrt2 / 32.0 * d / t);
+    auto const km = 1.0 + 1.0 / xsimd::sqrt(9.0 + x * x / 2.0) + 0.85 * d / t;
+
+    auto const resistance = kr * (32.0 * eta * t / (eps * d * d));
+    auto const reactance  = km * omega * (air.density * t / eps);
+    return seriesImpedance(SplitComplex<Batch>{resistance, reactance});
+}
+
+template<typename Batch>
+[[nodiscard]] auto transferMatrix(SlottedPanel const& panel, AirProperties const& air, Batch omega, Batch /*ky*/)
+    -> TransferMatrix<Batch>
+{
+    auto const t   = panel.thickness.numerical_value_in(si::metre);
+    auto const b   = panel.slotWidth.numerical_value_in(si::metre);
+    auto const eps = panel.openArea;
+
+    // End correction on each side of the slit
+    auto const delta = b / std::numbers::pi * std::log(1.0 / std::sin(std::numbers::pi * eps / 2.0));
+
+    auto const resistance = 12.0 * air.viscosity * t / (eps * b * b);
+    auto const reactance  = omega * (air.density * (t + 2.0 * delta) / eps);
+    return seriesImpedance(SplitComplex<Batch>{Batch(resistance), reactance});
+}
+
+template<typename Batch>
+[[nodiscard]] auto transferMatrix(Membrane const& membrane, AirProperties const& /*air*/, Batch omega, Batch /*ky*/)
+    -> TransferMatrix<Batch>
+{
+    return seriesImpedance(SplitComplex<Batch>{Batch(0.0), omega * membrane.surfaceDensity});
+}
+
+}  // namespace detail
+
+LayerStack::LayerStack(std::vector<Layer> layers) : _layers{std::move(layers)} {}
+
+auto LayerStack::layers() const noexcept -> std::span<Layer const> { return _layers; }
+
+auto LayerStack::operator()(
+    AtmosphericEnvironment env,
+    std::span<double const> frequencies,
+    double angle,
+    LayerStackSweep const& out
+) const -> void
+{
+    using Batch  = xsimd::batch<double>;
+    using Matrix = detail::TransferMatrix<Batch>;
+
+    static constexpr auto lanes = Batch::size;
+
+    // A rigid wall without treatment
+    if (_layers.empty()) {
+        std::fill(out.absorptionFactor.begin(), out.absorptionFactor.end(), 0.0);
+        std::fill(out.impedanceReal.begin(), out.impedanceReal.end(), std::numeric_limits<double>::infinity());
+        std::fill(out.impedanceImag.begin(), out.impedanceImag.end(), 0.0);
+        return;
+    }
+
+    auto const air     = detail::airProperties(env);
+    auto const radians = angle * std::numbers::pi / 180.0;
+    auto const sinA    = std::sin(radians);
+    auto const cosA    = std::cos(radians);
+
+    // Split real/imaginary arrays of the matrix entries, padded to full batches
+    auto const size   = frequencies.size();
+    auto const padded = (size + lanes - 1) / lanes * lanes;
+
+    auto omega = std::vector<double>(padded, 2.0 * std::numbers::pi * (size == 0 ? 1.0 : frequencies.back()));
+    std::transform(frequencies.begin(), frequencies.end(), omega.begin(), [](auto f) {
+        return 2.0 * std::numbers::pi * f;
+    });
+
+    auto entries = std::array<std::vector<double>, 8>{};
+    for (auto& entry : entries) {
+        entry.resize(padded, 0.0);
+    }
+    std::fill(entries[0].begin(), entries[0].end(), 1.0);
+    std::fill(entries[6].begin(), entries[6].end(), 1.0);
+
+    auto const load = [&entries](std::size_t i) {
+        auto const at = [&](std::size_t e) {
+            return Batch::load_unaligned(std::next(entries[e].data(), static_cast<std::ptrdiff_t>(i)));
+        };
+        return Matrix{
+            .t11 = {at(0), at(1)},
+            .t12 = {at(2), at(3)},
+            .t21 = {at(4), at(5)},
+            .t22 = {at(6), at(7)},
+        };
+    };
+
+    auto const save = [&entries](std::size_t i, Matrix const& m) {
+        auto const at = [&](std::size_t e) { return std::next(entries[e].data(), static_cast<std::ptrdiff_t>(i)); };
+        m.t11.re.store_unaligned(at(0));
+        m.t11.im.store_unaligned(at(1));
+        m.t12.re.store_unaligned(at(2));
+        m.t12.im.store_unaligned(at(3));
+        m.t21.re.store_unaligned(at(4));
+        m.t21.im.store_unaligned(at(5));
+        m.t22.re.store_unaligned(at(6));
+        m.t22.im.store_unaligned(at(7));
+    };
+
+    // Layer major, the layer type is resolved once per layer and not per frequency
+    for (auto const& layer : _layers) {
+        std::visit(
+            [&](auto const& l) {
+                for (auto i{0UL}; i < padded; i += lanes) {
+                    auto const w  = Batch::load_unaligned(std::next(omega.data(), static_cast<std::ptrdiff_t>(i)));
+                    auto const ky = w * (sinA / air.speed);
+                    save(i, load(i) * detail::transferMatrix(l, air, w, ky));
+                }
+            },
+            layer
+        );
+    }
+
+    // Rigid backing, the velocity on the back of the last layer is zero
+    auto buffer = std::array<double, lanes>{};
+    for (auto i{0UL}; i < padded; i += lanes) {
+        auto const m  = load(i);
+        auto const zs = m.t11 / m.t21;
+
+        auto const write = [&](std::span<double> dest, Batch const& value) {
+            if (dest.empty()) {
+                return;
+            }
+            value.store_unaligned(buffer.data());
+            auto const count = std::min(lanes, size - i);
+            std::copy_n(buffer.begin(), count, std::next(dest.begin(), static_cast<std::ptrdiff_t>(i)));
+        };
+
+        write(out.impedanceReal, zs.re);
+        write(out.impedanceImag, zs.im);
+        if (not out.absorptionFactor.empty()) {
+            write(out.absorptionFactor, detail::absorptionFactor(zs * Batch(cosA / air.impedance)));
+        }
+    }
+}
+
+auto LayerStack::absorption(AtmosphericEnvironment env, std::span<double const> frequencies, double angle) const
+    -> std::vector<double>
+{
+    auto result = std::vector<double>(frequencies.size());
+    (*this)(env, frequencies, angle, {.absorptionFactor = result});
+    return result;
+}
+
+}  // namespace ra
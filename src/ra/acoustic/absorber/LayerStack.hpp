@@ -0,0 +1,134 @@
+#pragma once
+
+#include <ra/acoustic/absorber/PorousAbsorber.hpp>
+
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace ra {
+
+/// Empirical model, Delany & Bazley (1970)
+struct DelanyBazley
+{
+    double flowResisitivity{0};
+};
+
+/// Empirical model, Miki (1990). Stays physical below the Delany-Bazley
+/// validity range, i.e. for low frequencies & high flow resistivity.
+struct Miki
+{
+    double flowResisitivity{0};
+};
+
+/// Semi-phenomenological model, Johnson-Champoux-Allard
+struct JohnsonChampouxAllard
+{
+    double flowResisitivity{0};
+    double porosity{0.98};
+    double tortuosity{1.0};
+
+    /// Viscous characteristic length
+    quantity<isq::length[si::metre]> viscousLength{};
+
+    /// Thermal characteristic length
+    quantity<isq::length[si::metre]> thermalLength{};
+};
+
+/// Equivalent fluid layer, the model is a compile-time parameter
+template<typename Model>
+struct PorousLayer
+{
+    quantity<isq::thickness[si::metre]> thickness{};
+    Model model{};
+};
+
+struct AirLayer
+{
+    quantity<isq::thickness[si::metre]> thickness{};
+};
+
+/// Thin sheet with a purely resistive flow resistance, e.g. fabric or fleece
+struct ResistiveLayer
+{
+    /// Flow resistance in Pa*s/m
+    double flowResistance{0};
+};
+
+/// Plate with circular holes, Maa's model including end corrections
+struct PerforatedPanel
+{
+    quantity<isq::thickness[si::metre]> thickness{};
+    quantity<isq::diameter[si::metre]> holeDiameter{};
+
+    /// Open area ratio
+    double perforation{0};
+};
+
+/// Plate with parallel slits, laminar slit flow with the end correction of
+/// Smits & Kosten
+struct SlottedPanel
+{
+    quantity<isq::thickness[si::metre]> thickness{};
+    quantity<isq::width[si::metre]> slotWidth{};
+
+    /// Open area ratio
+    double openArea{0};
+};
+
+/// Limp membrane or panel, mass law only
+struct Membrane
+{
+    /// kg/m^2
+    double surfaceDensity{0};
+};
+
+using Layer = std::variant<
+    PorousLayer<DelanyBazley>,
+    PorousLayer<Miki>,
+    PorousLayer<JohnsonChampouxAllard>,
+    AirLayer,
+    ResistiveLayer,
+    PerforatedPanel,
+    SlottedPanel,
+    Membrane>;
+
+/// Outputs of LayerStack, one entry per frequency. Empty spans are skipped.
+struct LayerStackSweep
+{
+    std::span<double> absorptionFactor{};
+    std::span<double> impedanceReal{};
+    std::span<double> impedanceImag{};
+};
+
+/// Transfer-matrix model of a treatment in front of a rigid wall
+///
+/// Each layer contributes a 2x2 complex matrix relating pressure & normal
+/// velocity on both of its faces. The chain runs layer by layer over all
+/// frequencies at once, with the matrix entries stored as split
+/// real/imaginary arrays and processed on SIMD registers.
+struct LayerStack
+{
+    LayerStack() = default;
+
+    /// Layers are ordered from the room towards the wall
+    explicit LayerStack(std::vector<Layer> layers);
+
+    [[nodiscard]] auto layers() const noexcept -> std::span<Layer const>;
+
+    /// Frequencies in Hz, angle of incidence in degree
+    auto operator()(
+        AtmosphericEnvironment env,
+        std::span<double const> frequencies,
+        double angle,
+        LayerStackSweep const& out
+    ) const -> void;
+
+    [[nodiscard]] auto absorption(AtmosphericEnvironment env, std::span<double const> frequencies, double angle = 0.0)
+        const -> std::vector<double>;
+
+private:
+    std::vector<Layer> _layers;
+};
+
+}  // namespace ra
@@ -0,0 +1,179 @@
+#include "LayerStack.hpp"
+
+#include <ra/acoustic/Air.hpp>
+#include <ra/unit/pressure.hpp>
+#include <ra/unit/temperature.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+
+static constexpr auto C20 = ra::AtmosphericEnvironment{ra::celciusToKelvin(20.0), ra::OneAtmosphere<double>};
+
+namespace {
+
+auto logSweep(double fmin, double fmax, std::size_t size) -> std::vector<double>
+{
+    auto frequencies = std::vector<double>(size);
+    for (auto i{0UL}; i < size; ++i) {
+        auto const t   = static_cast<double>(i) / static_cast<double>(size - 1);
+        frequencies[i] = fmin * std::pow(fmax / fmin, t);
+    }
+    return frequencies;
+}
+
+}  // namespace
+
+TEST_CASE("RaumAkustik: LayerStack porous", "")
+{
+    using ra::si::unit_symbols::Hz;
+    using ra::si::unit_symbols::mm;
+
+    auto const frequencies = logSweep(50.0, 10'000.0, 101);
+
+    SECTION("rigid backing")
+    {
+        auto const stack = ra::LayerStack{{
+            ra::PorousLayer<ra::DelanyBazley>{.thickness = 100.0 * mm, .model = {8'000.0}},
+        }};
+
+        auto const alpha = stack.absorption(C20, frequencies);
+        for (auto i{0UL}; i < frequencies.size(); ++i) {
+            auto const specs    = ra::PorousAbsorberSpecs{100.0 * mm, 8'000.0};
+            auto const expected = ra::propertiesOfAbsorber(specs, C20, frequencies[i] * Hz, 0.0);
+            REQUIRE(alpha[i] == Catch::Approx(expected.absorptionFactorNoAirGap));
+        }
+
+        // Oblique incidence, Zs = -j * Zc * k/kx * cot(kx * d)
+        auto const oblique = stack.absorption(C20, frequencies, 60.0);
+        for (auto i{0UL}; i < frequencies.size(); ++i) {
+            auto const specs = ra::PorousAbsorberSpecs{100.0 * mm, 8'000.0};
+            auto const p     = ra::propertiesOfAbsorber(specs, C20, frequencies[i] * Hz, 60.0);
+            auto const z0    = ra::impedanceOfAir(C20.temperature, C20.pressure);
+            auto const kxd   = p.kx * 0.1;
+            auto const zs    = std::complex{0.0, -1.0} * p.zca * p.ratiooOfWaveNumbers * std::cos(kxd) / std::sin(kxd);
+            auto const r     = (zs / z0 * 0.5 - 1.0) / (zs / z0 * 0.5 + 1.0);
+            REQUIRE(oblique[i] == Catch::Approx(1.0 - std::norm(r)));
+        }
+    }
+
+    SECTION("air gap")
+    {
+        auto const stack = ra::LayerStack{{
+            ra::PorousLayer<ra::DelanyBazley>{.thickness = 50.0 * mm, .model = {12'000.0}},
+            ra::AirLayer{.thickness = 80.0 * mm},
+        }};
+
+        // The single layer formulas differ from the transfer matrices at oblique incidence
+        auto const alpha = stack.absorption(C20, frequencies);
+        for (auto i{0UL}; i < frequencies.size(); ++i) {
+            auto const specs    = ra::PorousAbsorberSpecs{50.0 * mm, 12'000.0, 80.0 * mm};
+            auto const expected = ra::propertiesOfAbsorber(specs, C20, frequencies[i] * Hz, 0.0);
+            REQUIRE(alpha[i] == Catch::Approx(expected.absorptionFactorWithAirGap));
+        }
+    }
+
+    SECTION("models")
+    {
+        auto const miki = ra::LayerStack{{
+            ra::PorousLayer<ra::Miki>{.thickness = 50.0 * mm, .model = {10'000.0}},
+        }};
+        auto const jca = ra::LayerStack{{
+            ra::PorousLayer<ra::JohnsonChampouxAllard>{
+                .thickness = 50.0 * mm,
+                .model     = {
+                    .flowResisitivity = 10'000.0,
+                    .porosity         = 0.98,
+                    .tortuosity       = 1.02,
+                    .viscousLength    = 0.1 * mm,
+                    .thermalLength    = 0.2 * mm,
+                },
+            },
+        }};
+
+        auto const a = miki.absorption(C20, frequencies);
+        auto const b = jca.absorption(C20, frequencies);
+        for (auto i{0UL}; i < frequencies.size(); ++i) {
+            REQUIRE(a[i] > 0.0);
+            REQUIRE(a[i] < 1.0);
+            REQUIRE(b[i] > 0.0);
+            REQUIRE(b[i] < 1.0);
+        }
+
+        // 50mm of mineral wool absorbs well above 1kHz
+        REQUIRE(a.back() > 0.8);
+        REQUIRE(b.back() > 0.8);
+        REQUIRE(a.front() < 0.2);
+        REQUIRE(b.front() < 0.2);
+    }
+}
+
+TEST_CASE("RaumAkustik: LayerStack resonators", "")
+{
+    using namespace ra::si::unit_symbols;
+
+    auto const c     = ra::soundVelocity(C20.temperature).numerical_value_in(m / s);
+    auto const rho   = ra::densityOfAir(C20.temperature, C20.pressure).numerical_value_in(kg / m3);
+    auto const sweep = logSweep(20.0, 2'000.0, 2'001);
+
+    auto const peak = [&](auto const& alpha) {
+        auto const max = std::max_element(alpha.begin(), alpha.end());
+        return sweep[static_cast<std::size_t>(std::distance(alpha.begin(), max))];
+    };
+
+    SECTION("air")
+    {
+        auto const stack = ra::LayerStack{{ra::AirLayer{.thickness = 100.0 * mm}}};
+        for (auto a : stack.absorption(C20, sweep, 45.0)) {
+            REQUIRE(a == Catch::Approx(0.0).margin(1e-9));
+        }
+    }
+
+    SECTION("membrane")
+    {
+        // Mass-spring resonance f0 = 1/(2pi) * sqrt(rho c^2 / (m d))
+        auto const stack = ra::LayerStack{{
+            ra::Membrane{.surfaceDensity = 5.0},
+            ra::ResistiveLayer{.flowResistance = 200.0},
+            ra::AirLayer{.thickness = 100.0 * mm},
+        }};
+
+        auto const f0 = std::sqrt(rho * c * c / (5.0 * 0.1)) / (2.0 * std::numbers::pi);
+        REQUIRE(peak(stack.absorption(C20, sweep)) == Catch::Approx(f0).epsilon(0.05));
+    }
+
+    SECTION("perforated")
+    {
+        // Helmholtz resonance f0 = c/(2pi) * sqrt(eps / (d * (t + 0.85*dh)))
+        auto const stack = ra::LayerStack{{
+            ra::PerforatedPanel{.thickness = 5.0 * mm, .holeDiameter = 5.0 * mm, .perforation = 0.05},
+            ra::AirLayer{.thickness = 50.0 * mm},
+        }};
+
+        auto const f0 = c / (2.0 * std::numbers::pi) * std::sqrt(0.05 / (0.05 * (0.005 + 0.85 * 0.005)));
+        REQUIRE(peak(stack.absorption(C20, sweep)) == Catch::Approx(f0).epsilon(0.1));
+    }
+
+    SECTION("slotted")
+    {
+        auto const stack = ra::LayerStack{{
+            ra::SlottedPanel{.thickness = 10.0 * mm, .slotWidth = 3.0 * mm, .openArea = 0.1},
+            ra::AirLayer{.thickness = 50.0 * mm},
+        }};
+
+        auto const delta = 0.003 / std::numbers::pi * std::log(1.0 / std::sin(std::numbers::pi * 0.1 / 2.0));
+        auto const f0    = c / (2.0 * std::numbers::pi) * std::sqrt(0.1 / (0.05 * (0.01 + 2.0 * delta)));
+        REQUIRE(peak(stack.absorption(C20, sweep)) == Catch::Approx(f0).epsilon(0.1));
+    }
+
+    SECTION("empty")
+    {
+        auto const alpha = ra::LayerStack{}.absorption(C20, sweep);
+        REQUIRE(std::all_of(alpha.begin(), alpha.end(), [](auto a) { return a == 0.0; }));
+    }
+}
@@ -1,12 +1,17 @@
 #include "PorousAbsorber.hpp"
 
 #include <ra/acoustic/Air.hpp>
+#include <ra/acoustic/absorber/SplitComplex.hpp>
 #include <ra/unit/pressure.hpp>
 #include <ra/unit/temperature.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <numbers>
 
 namespace ra {
+
 auto propertiesOfAbsorber(
     PorousAbsorberSpecs specs,
     AtmosphericEnvironment env,
@@ -65,6 +70,128 @@ auto propertiesOfAbsorber(
     return p;
 }
 
+auto propertiesOfAbsorber(
+    PorousAbsorberSpecs specs,
+    AtmosphericEnvironment env,
+    std::span<double const> frequencies,
+    std::span<double const> angles,
+    PorousAbsorberSweep const& out
+) -> void
+{
+    using namespace mp_units::si::unit_symbols;
+
+    using Batch   = xsimd::batch<double>;
+    using Complex = detail::SplitComplex<Batch>;
+
+    static constexpr auto lanes = Batch::size;
+
+    assert(angles.size() == 1 or angles.size() == frequencies.size());
+
+    auto const wantNoGap     = not out.absorptionFactorNoAirGap.empty();
+    auto const wantWithGap   = not out.absorptionFactorWithAirGap.empty();
+    auto const wantImpedance = not out.impedanceReal.empty() or not out.impedanceImag.empty();
+
+    // Frequency invariant terms
+    auto const airDensity = densityOfAir(env.temperature, env.pressure);
+    auto const airIm      = impedanceOfAir(env.temperature, env.pressure);
+    auto const twoPiC     = (2.0 * std::numbers::pi) / soundVelocity(env.temperature).numerical_value_in(m / s);
+    auto const xScale     = airDensity.numerical_value_in(kg / m3) / specs.flowResisitivity;
+    auto const thickness  = specs.thickness.numerical_value_in(si::metre);
+    auto const airGap     = specs.airGap.numerical_value_in(si::metre);
+    auto const toRadians  = std::numbers::pi / 180.0;
+
+    auto const kernel = [&](Batch f, Batch angle) {
+        auto const wn   = f * twoPiC;
+        auto const sinA = xsimd::sin(angle * toRadians);
+        auto const cosA = xsimd::cos(angle * toRadians);
+
+        // Delany & Bazley, X^e evaluated as exp(e*ln(X))
+        auto const lnX = xsimd::log(f * xScale);
+        auto const zca = Complex{
+            (1.0 + 0.0571 * xsimd::exp(-0.754 * lnX)) * airIm,
+            (-0.087 * xsimd::exp(-0.732 * lnX)) * airIm,
+        };
+        auto const k = Complex{
+            (1.0 + 0.0978 * xsimd::exp(-0.7 * lnX)) * wn,
+            (-0.189 * xsimd::exp(-0.595 * lnX)) * wn,
+        };
+
+        auto const ky    = wn * sinA;
+        auto const kx    = sqrt(k * k - Complex{ky * ky, Batch(0.0)});
+        auto const cotKt = cot(k * Batch(thickness));
+        auto const ki    = timesMinusJ(zca * cotKt);
+        auto const zsa   = ki * (k / kx);
+
+        struct Result
+        {
+            Complex zsa;
+            Batch noGap;
+            Batch withGap;
+        };
+
+        auto result = Result{.zsa = zsa, .noGap = Batch(0.0), .withGap = Batch(0.0)};
+        if (wantNoGap) {
+            result.noGap = detail::absorptionFactor(zsa * (cosA / airIm));
+        }
+
+        if (wantWithGap) {
+            // sin(asin(|ky/k|)) of the scalar version
+            auto const sinBetaPorous = xsimd::abs(ky) / xsimd::sqrt(norm(k));
+
+            auto const kAirY     = k * sinBetaPorous;
+            auto const kAirX     = sqrt(Complex{wn * wn, Batch(0.0)} - kAirY * kAirY);
+            auto const kAirRatio = Complex{wn, Batch(0.0)} / kAirX;
+            auto const cotGap    = xsimd::cos(wn * airGap) / xsimd::sin(wn * airGap);
+            auto const zAir      = timesMinusJ(kAirRatio * (cotGap * airIm));
+            auto const zaAir     = (ki * zAir + zca * zca) / (zAir + ki);
+
+            result.withGap = detail::absorptionFactor(zaAir * (cosA / airIm));
+        }
+
+        return result;
+    };
+
+    auto const store = [&](auto const& result, std::size_t first, std::size_t count) {
+        auto buffer = std::array<double, lanes>{};
+        auto const write = [&](Batch const& value, std::span<double> dest) {
+            if (dest.empty()) {
+                return;
+            }
+            value.store_unaligned(buffer.data());
+            std::copy_n(buffer.begin(), count, std::next(dest.begin(), static_cast<std::ptrdiff_t>(first)));
+        };
+
+        write(result.noGap, out.absorptionFactorNoAirGap);
+        write(result.withGap, out.absorptionFactorWithAirGap);
+        if (wantImpedance) {
+            write(result.zsa.re, out.impedanceReal);
+            write(result.zsa.im, out.impedanceImag);
+        }
+    };
+
+    auto const size = frequencies.size();
+    auto i          = 0UL;
+
+    for (; i + lanes <= size; i += lanes) {
+        auto const f     = Batch::load_unaligned(frequencies.subspan(i, lanes).data());
+        auto const angle = angles.size() == 1 ? Batch(angles[0])
+                                              : Batch::load_unaligned(angles.subspan(i, lanes).data());
+        store(kernel(f, angle), i, lanes);
+    }
+
+    // Remainder, padded with the last frequency
+    if (i < size) {
+        auto f     = std::array<double, lanes>{};
+        auto angle = std::array<double, lanes>{};
+        for (auto lane{0UL}; lane < lanes; ++lane) {
+            auto const idx = std::min(i + lane, size - 1);
+            f[lane]        = frequencies[idx];
+            angle[lane]    = angles.size() == 1 ? angles[0] : angles[idx];
+        }
+        store(kernel(Batch::load_unaligned(f.data()), Batch::load_unaligned(angle.data())), i, size - i);
+    }
+}
+
 namespace detail {
 
 auto waveNumber(
@@ -6,6 +6,7 @@
 #include <mp-units/systems/si.h>
 
 #include <complex>
+#include <span>
 
 namespace ra {
 
@@ -91,6 +92,32 @@ struct PorousAbsorberProperties
     double angle
 ) -> PorousAbsorberProperties;
 
+/// Outputs of the batched propertiesOfAbsorber, one entry per frequency.
+/// Empty spans are skipped, the air gap chain only runs if its output is requested.
+struct PorousAbsorberSweep
+{
+    std::span<double> absorptionFactorNoAirGap{};
+    std::span<double> absorptionFactorWithAirGap{};
+
+    /// Impedance at absorber surface (zsa)
+    std::span<double> impedanceReal{};
+    std::span<double> impedanceImag{};
+};
+
+/// Batched version of propertiesOfAbsorber for frequency sweeps. Frequencies
+/// are in Hz, angles in degree. Angles either hold a single value for all
+/// frequencies or one value per frequency.
+///
+/// The environment terms are evaluated once and the Delany-Bazley chain runs
+/// on SIMD registers with real & imaginary parts in separate lanes.
+auto propertiesOfAbsorber(
+    PorousAbsorberSpecs specs,
+    AtmosphericEnvironment env,
+    std::span<double const> frequencies,
+    std::span<double const> angles,
+    PorousAbsorberSweep const& out
+) -> void;
+
 namespace detail {
 
 [[nodiscard]] auto waveNumber(
@@ -7,6 +7,10 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <cmath>
+#include <vector>
+
 static constexpr auto C20 = ra::AtmosphericEnvironment{ra::celciusToKelvin(20.0), ra::OneAtmosphere<double>};
 static constexpr auto C22 = ra::AtmosphericEnvironment{ra::celciusToKelvin(22.0), ra::OneAtmosphere<double>};
 
@@ -120,3 +124,52 @@ TEST_CASE("RaumAkustik: detail::angleOfPropagation", "")
     REQUIRE(ra::propertiesOfAbsorber(specs, C20, f50, 15.0).betaPorous == Catch::Approx(2.8036973865));
     REQUIRE(ra::propertiesOfAbsorber(specs, C22, f50, 15.0).betaPorous == Catch::Approx(2.7931256656));
 }
+
+TEST_CASE("RaumAkustik: propertiesOfAbsorber sweep", "")
+{
+    using ra::si::unit_symbols::Hz;
+    using ra::si::unit_symbols::mm;
+
+    auto const specs = ra::PorousAbsorberSpecs{100.0 * mm, 8'000.0, 100.0 * mm};
+
+    // Not a multiple of any SIMD width
+    auto frequencies = std::vector<double>(1'003);
+    auto angles      = std::vector<double>(frequencies.size());
+    for (auto i{0UL}; i < frequencies.size(); ++i) {
+        frequencies[i] = 20.0 * std::pow(2.0, static_cast<double>(i) / 100.0);
+        angles[i]      = static_cast<double>(i % 80);
+    }
+
+    auto noGap     = std::vector<double>(frequencies.size());
+    auto withGap   = std::vector<double>(frequencies.size());
+    auto impedance = std::vector<double>(frequencies.size());
+
+    SECTION("single angle")
+    {
+        auto const angle = std::array{45.0};
+        ra::propertiesOfAbsorber(specs, C20, frequencies, angle, {.absorptionFactorNoAirGap = noGap});
+
+        for (auto i{0UL}; i < frequencies.size(); ++i) {
+            auto const expected = ra::propertiesOfAbsorber(specs, C20, frequencies[i] * Hz, angle[0]);
+            REQUIRE(noGap[i] == Catch::Approx(expected.absorptionFactorNoAirGap));
+        }
+
+        REQUIRE(withGap == std::vector<double>(frequencies.size()));
+    }
+
+    SECTION("angle per frequency")
+    {
+        ra::propertiesOfAbsorber(specs, C22, frequencies, angles, {
+            .absorptionFactorNoAirGap   = noGap,
+            .absorptionFactorWithAirGap = withGap,
+            .impedanceReal              = impedance,
+        });
+
+        for (auto i{0UL}; i < frequencies.size(); ++i) {
+            auto const expected = ra::propertiesOfAbsorber(specs, C22, frequencies[i] * Hz, angles[i]);
+            REQUIRE(noGap[i] == Catch::Approx(expected.absorptionFactorNoAirGap));
+            REQUIRE(withGap[i] == Catch::Approx(expected.absorptionFactorWithAirGap));
+            REQUIRE(impedance[i] == Catch::Approx(expected.impedance.atSurface.real()));
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <xsimd/xsimd.hpp>
+
+namespace ra {
+namespace detail {
+
+/// Complex number with real & imaginary part in separate registers
+template<typename Batch>
+struct SplitComplex
+{
+    Batch re;
+    Batch im;
+};
+
+template<typename Batch>
+[[nodiscard]] auto operator+(SplitComplex<Batch> const& l, SplitComplex<Batch> const& r) -> SplitComplex<Batch>
+{
+    return {l.re + r.re, l.im + r.im};
+}
+
+template<typename Batch>
+[[nodiscard]] auto operator-(SplitComplex<Batch> const& l, SplitComplex<Batch> const& r) -> SplitComplex<Batch>
+{
+    return {l.re - r.re, l.im - r.im};
+}
+
+template<typename Batch>
+[[nodiscard]] auto operator*(SplitComplex<Batch> const& l, SplitComplex<Batch> const& r) -> SplitComplex<Batch>
+{
+    return {l.re * r.re - l.im * r.im, l.re * r.im + l.im * r.re};
+}
+
+template<typename Batch>
+[[nodiscard]] auto operator*(SplitComplex<Batch> const& l, Batch const& r) -> SplitComplex<Batch>
+{
+    return {l.re * r, l.im * r};
+}
+
+template<typename Batch>
+[[nodiscard]] auto operator/(SplitComplex<Batch> const& l, SplitComplex<Batch> const& r) -> SplitComplex<Batch>
+{
+    auto const den = r.re * r.re + r.im * r.im;
+    return {(l.re * r.re + l.im * r.im) / den, (l.im * r.re - l.re * r.im) / den};
+}
+
+template<typename Batch>
+[[nodiscard]] auto norm(SplitComplex<Batch> const& z) -> Batch
+{
+    return z.re * z.re + z.im * z.im;
+}
+
+/// Multiplication with j
+template<typename Batch>
+[[nodiscard]] auto timesJ(SplitComplex<Batch> const& z) -> SplitComplex<Batch>
+{
+    return {-z.im, z.re};
+}
+
+/// Multiplication with -j
+template<typename Batch>
+[[nodiscard]] auto timesMinusJ(SplitComplex<Batch> const& z) -> SplitComplex<Batch>
+{
+    return {z.im, -z.re};
+}
+
+/// Principal square root, same branch cut as std::sqrt
+template<typename Batch>
+[[nodiscard]] auto sqrt(SplitComplex<Batch> const& z) -> SplitComplex<Batch>
+{
+    auto const r = xsimd::hypot(z.re, z.im);
+    return {xsimd::sqrt((r + z.re) * 0.5), xsimd::copysign(xsimd::sqrt((r - z.re) * 0.5), z.im)};
+}
+
+template<typename Batch>
+[[nodiscard]] auto cos(SplitComplex<Batch> const& z) -> SplitComplex<Batch>
+{
+    return {xsimd::cos(z.re) * xsimd::cosh(z.im), -xsimd::sin(z.re) * xsimd::sinh(z.im)};
+}
+
+template<typename Batch>
+[[nodiscard]] auto sin(SplitComplex<Batch> const& z) -> SplitComplex<Batch>
+{
+    return {xsimd::sin(z.re) * xsimd::cosh(z.im), xsimd::cos(z.re) * xsimd::sinh(z.im)};
+}
+
+/// cot(x+jy) = (sin(2x) - j*sinh(2y)) / (cosh(2y) - cos(2x))
+template<typename Batch>
+[[nodiscard]] auto cot(SplitComplex<Batch> const& z) -> SplitComplex<Batch>
+{
+    auto const den = xsimd::cosh(z.im * 2.0) - xsimd::cos(z.re * 2.0);
+    return {xsimd::sin(z.re * 2.0) / den, -xsimd::sinh(z.im * 2.0) / den};
+}
+
+/// 1 - |(z-1)/(z+1)|^2 for a normalized impedance z
+template<typename Batch>
+[[nodiscard]] auto absorptionFactor(SplitComplex<Batch> const& z) -> Batch
+{
+    auto const one = SplitComplex<Batch>{Batch(1.0), Batch(0.0)};
+    return Batch(1.0) - norm((z - one) / (z + one));
+}
+
+}  // namespace detail
+}  // namespace ra
@@ -0,0 +1,67 @@
+#include "Biquad.hpp"
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+
+namespace ra {
+
+auto makeLowpass(double cutoff, double q, double sampleRate) noexcept -> BiquadCoefficients
+{
+    auto const w0    = 2.0 * std::numbers::pi * cutoff / sampleRate;
+    auto const cosw0 = std::cos(w0);
+    auto const alpha = std::sin(w0) / (2.0 * q);
+    auto const a0    = 1.0 + alpha;
+
+    return {
+        .b0 = (1.0 - cosw0) / 2.0 / a0,
+        .b1 = (1.0 - cosw0) / a0,
+        .b2 = (1.0 - cosw0) / 2.0 / a0,
+        .a1 = -2.0 * cosw0 / a0,
+        .a2 = (1.0 - alpha) / a0,
+    };
+}
+
+auto makeHighpass(double cutoff, double q, double sampleRate) noexcept -> BiquadCoefficients
+{
+    auto const w0    = 2.0 * std::numbers::pi * cutoff / sampleRate;
+    auto const cosw0 = std::cos(w0);
+    auto const alpha = std::sin(w0) / (2.0 * q);
+    auto const a0    = 1.0 + alpha;
+
+    return {
+        .b0 = (1.0 + cosw0) / 2.0 / a0,
+        .b1 = -(1.0 + cosw0) / a0,
+        .b2 = (1.0 + cosw0) / 2.0 / a0,
+        .a1 = -2.0 * cosw0 / a0,
+        .a2 = (1.0 - alpha) / a0,
+    };
+}
+
+auto makeBandpass(double center, double q, double sampleRate) noexcept -> BiquadCoefficients
+{
+    auto const w0    = 2.0 * std::numbers::pi * center / sampleRate;
+    auto const cosw0 = std::cos(w0);
+    auto const alpha = std::sin(w0) / (2.0 * q);
+    auto const a0    = 1.0 + alpha;
+
+    return {
+        .b0 = alpha / a0,
+        .b1 = 0.0,
+        .b2 = -alpha / a0,
+        .a1 = -2.0 * cosw0 / a0,
+        .a2 = (1.0 - alpha) / a0,
+    };
+}
+
+auto magnitude(BiquadCoefficients const& coefficients, double frequency, double sampleRate) noexcept -> double
+{
+    auto const w   = 2.0 * std::numbers::pi * frequency / sampleRate;
+    auto const z1  = std::polar(1.0, -w);
+    auto const z2  = z1 * z1;
+    auto const num = coefficients.b0 + coefficients.b1 * z1 + coefficients.b2 * z2;
+    auto const den = 1.0 + coefficients.a1 * z1 + coefficients.a2 * z2;
+    return std::abs(num / den);
+}
+
+}  // namespace ra
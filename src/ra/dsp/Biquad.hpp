@@ -0,0 +1,73 @@
+#pragma once
+
+#include <span>
+
+namespace ra {
+
+/// Normalized coefficients, a0 is always 1
+struct BiquadCoefficients
+{
+    double b0{1.0};
+    double b1{0.0};
+    double b2{0.0};
+    double a1{0.0};
+    double a2{0.0};
+};
+
+// Audio EQ Cookbook, Robert Bristow-Johnson
+[[nodiscard]] auto makeLowpass(double cutoff, double q, double sampleRate) noexcept -> BiquadCoefficients;
+[[nodiscard]] auto makeHighpass(double cutoff, double q, double sampleRate) noexcept -> BiquadCoefficients;
+
+/// Constant 0 dB peak gain
+[[nodiscard]] auto makeBandpass(double center, double q, double sampleRate) noexcept -> BiquadCoefficients;
+
+/// Magnitude response at the given frequency
+[[nodiscard]] auto magnitude(BiquadCoefficients const& coefficients, double frequency, double sampleRate) noexcept
+    -> double;
+
+/// Transposed direct form II
+template<typename Float>
+struct Biquad
+{
+    Biquad() = default;
+
+    explicit Biquad(BiquadCoefficients const& coefficients) noexcept
+        : _b0{static_cast<Float>(coefficients.b0)}
+        , _b1{static_cast<Float>(coefficients.b1)}
+        , _b2{static_cast<Float>(coefficients.b2)}
+        , _a1{static_cast<Float>(coefficients.a1)}
+        , _a2{static_cast<Float>(coefficients.a2)}
+    {}
+
+    auto reset() noexcept -> void
+    {
+        _z1 = Float(0);
+        _z2 = Float(0);
+    }
+
+    [[nodiscard]] auto operator()(Float x) noexcept -> Float
+    {
+        auto const y = _b0 * x + _z1;
+        _z1          = _b1 * x - _a1 * y + _z2;
+        _z2          = _b2 * x - _a2 * y;
+        return y;
+    }
+
+    auto operator()(std::span<Float> buffer) noexcept -> void
+    {
+        for (auto& sample : buffer) {
+            sample = (*this)(sample);
+        }
+    }
+
+private:
+    Float _b0{1};
+    Float _b1{0};
+    Float _b2{0};
+    Float _a1{0};
+    Float _a2{0};
+    Float _z1{0};
+    Float _z2{0};
+};
+
+}  // namespace ra
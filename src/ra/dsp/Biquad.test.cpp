@@ -0,0 +1,52 @@
+#include "Biquad.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+auto gainAt(ra::BiquadCoefficients const& c, double frequency, double fs) -> double
+{
+    auto filter = ra::Biquad<double>{c};
+    auto peak   = 0.0;
+    for (auto i{0}; i < static_cast<int>(fs); ++i) {
+        auto const out = filter(std::sin(2.0 * std::numbers::pi * frequency * i / fs));
+        if (i > static_cast<int>(fs) / 2) {
+            peak = std::max(peak, std::abs(out));
+        }
+    }
+    return peak;
+}
+
+}  // namespace
+
+TEST_CASE("RaumAkustik: Biquad", "")
+{
+    auto const fs = 48'000.0;
+    auto const q  = 1.0 / std::numbers::sqrt2;
+
+    REQUIRE(gainAt(ra::makeLowpass(1'000.0, q, fs), 100.0, fs) == Catch::Approx(1.0).margin(0.01));
+    REQUIRE(gainAt(ra::makeLowpass(1'000.0, q, fs), 1'000.0, fs) == Catch::Approx(q).margin(0.01));
+    REQUIRE(gainAt(ra::makeLowpass(1'000.0, q, fs), 10'000.0, fs) < 0.015);
+
+    REQUIRE(gainAt(ra::makeHighpass(1'000.0, q, fs), 10'000.0, fs) == Catch::Approx(1.0).margin(0.01));
+    REQUIRE(gainAt(ra::makeHighpass(1'000.0, q, fs), 1'000.0, fs) == Catch::Approx(q).margin(0.01));
+    REQUIRE(gainAt(ra::makeHighpass(1'000.0, q, fs), 100.0, fs) < 0.015);
+
+    REQUIRE(gainAt(ra::makeBandpass(1'000.0, 2.0, fs), 1'000.0, fs) == Catch::Approx(1.0).margin(0.01));
+    REQUIRE(gainAt(ra::makeBandpass(1'000.0, 2.0, fs), 100.0, fs) < 0.1);
+
+    auto const lowpass = ra::makeLowpass(1'000.0, q, fs);
+    REQUIRE(ra::magnitude(lowpass, 0.0, fs) == Catch::Approx(1.0));
+    REQUIRE(ra::magnitude(lowpass, 1'000.0, fs) == Catch::Approx(q));
+    REQUIRE(ra::magnitude(lowpass, 10'000.0, fs) == Catch::Approx(gainAt(lowpass, 10'000.0, fs)).margin(1e-3));
+
+    auto filter = ra::Biquad<float>{ra::makeLowpass(1'000.0, q, fs)};
+    auto buffer = std::vector<float>(64, 1.0F);
+    filter(buffer);
+    REQUIRE(buffer.back() == Catch::Approx(1.0F).margin(0.05));
+}
@@ -0,0 +1,116 @@
+#include "CallbackProfiler.hpp"
+
+#include <ra/dsp/LatestRing.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ra {
+
+namespace {
+
+/// Nearest rank, values have to be sorted
+[[nodiscard]] auto percentile(std::span<double const> sorted, double p) -> double
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+
+    auto const rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp(rank, std::size_t(1), sorted.size()) - 1];
+}
+
+[[nodiscard]] auto bin(double load) -> std::size_t
+{
+    if (load >= 1.0) {
+        return CallbackStatistics::bins - 1;
+    }
+
+    auto const octave = static_cast<int>(std::floor(std::log2(std::max(load, 1e-9))));
+    return static_cast<std::size_t>(std::clamp(octave + 11, 0, int(CallbackStatistics::bins) - 2));
+}
+
+}  // namespace
+
+CallbackProfiler::CallbackProfiler(std::size_t capacity)
+    : _starts(std::max(capacity, std::size_t(1)))
+    , _durations(_starts.size())
+    , _deadlines(_starts.size())
+{}
+
+auto CallbackProfiler::capacity() const noexcept -> std::size_t { return _starts.size(); }
+
+auto CallbackProfiler::operator()(CallbackTiming timing) -> void
+{
+    auto const n     = _written.load(std::memory_order_relaxed);
+    auto const index = n % capacity();
+    _starts[index].store(timing.start, std::memory_order_relaxed);
+    _durations[index].store(timing.duration, std::memory_order_relaxed);
+    _deadlines[index].store(timing.deadline, std::memory_order_relaxed);
+    _written.store(n + 1, std::memory_order_release);
+}
+
+auto CallbackProfiler::written() const noexcept -> std::size_t { return _written.load(std::memory_order_acquire); }
+
+auto CallbackProfiler::latest(std::span<CallbackTiming> out) const -> std::size_t
+{
+    return copyLatest(out, capacity(), [this] { return written(); }, [this](std::size_t index) {
+        return CallbackTiming{
+            .start    = _starts[index].load(std::memory_order_relaxed),
+            .duration = _durations[index].load(std::memory_order_relaxed),
+            .deadline = _deadlines[index].load(std::memory_order_relaxed),
+        };
+    });
+}
+
+auto CallbackProfiler::reset() -> void
+{
+    for (auto i{0UL}; i < capacity(); ++i) {
+        _starts[i].store(0, std::memory_order_relaxed);
+        _durations[i].store(0, std::memory_order_relaxed);
+        _deadlines[i].store(0, std::memory_order_relaxed);
+    }
+    _written.store(0, std::memory_order_release);
+}
+
+auto analyze(std::span<CallbackTiming const> timings) -> CallbackStatistics
+{
+    auto stats      = CallbackStatistics{};
+    auto loads      = std::vector<double>{};
+    auto deviations = std::vector<double>{};
+    loads.reserve(timings.size());
+    deviations.reserve(timings.size());
+
+    for (auto i{0UL}; i < timings.size(); ++i) {
+        auto const& timing = timings[i];
+        if (timing.deadline == 0) {
+            continue;
+        }
+
+        auto const load = static_cast<double>(timing.duration) / static_cast<double>(timing.deadline);
+        loads.push_back(load);
+        stats.histogram[bin(load)] += 1;
+        stats.overruns += timing.duration > timing.deadline ? 1 : 0;
+
+        // The next callback is due one block after the previous one started
+        if (i > 0 and timings[i - 1].deadline > 0 and timing.start >= timings[i - 1].start) {
+            auto const expected = static_cast<double>(timings[i - 1].deadline);
+            auto const interval = static_cast<double>(timing.start - timings[i - 1].start);
+            deviations.push_back(std::abs(interval - expected) / expected);
+            stats.xruns += interval > expected * 1.5 ? 1 : 0;
+        }
+    }
+
+    std::sort(loads.begin(), loads.end());
+    std::sort(deviations.begin(), deviations.end());
+
+    stats.callbacks = loads.size();
+    stats.median    = percentile(loads, 0.5);
+    stats.p90       = percentile(loads, 0.9);
+    stats.p99       = percentile(loads, 0.99);
+    stats.max       = loads.empty() ? 0.0 : loads.back();
+    stats.jitter    = percentile(deviations, 0.99);
+    return stats;
+}
+
+}  // namespace ra
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// One run of an audio callback, in nanoseconds
+struct CallbackTiming
+{
+    std::uint64_t start{0};
+    std::uint64_t duration{0};
+
+    /// Length of the block, numSamples / sampleRate
+    std::uint64_t deadline{0};
+};
+
+/// Ring of the latest callback timings
+///
+/// The audio thread records every callback without allocating or locking,
+/// the message thread copies the latest timings out at any time. Each field
+/// lives in its own array of 64-bit atomics, which are lock-free everywhere
+/// unlike an atomic of the whole struct.
+struct CallbackProfiler
+{
+    explicit CallbackProfiler(std::size_t capacity = 1024);
+
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+
+    /// Writer only
+    auto operator()(CallbackTiming timing) -> void;
+
+    /// Timings recorded so far, including the overwritten ones
+    [[nodiscard]] auto written() const noexcept -> std::size_t;
+
+    /// Copies up to out.size() latest timings, oldest first. Returns the
+    /// number of timings copied, below the capacity since the writer may be
+    /// overwriting the oldest one.
+    [[nodiscard]] auto latest(std::span<CallbackTiming> out) const -> std::size_t;
+
+    /// Not safe while the writer is running
+    auto reset() -> void;
+
+private:
+    std::vector<std::atomic<std::uint64_t>> _starts;
+    std::vector<std::atomic<std::uint64_t>> _durations;
+    std::vector<std::atomic<std::uint64_t>> _deadlines;
+    std::atomic<std::size_t> _written{0};
+};
+
+struct CallbackStatistics
+{
+    /// Load bins of one octave each, from below 0.1% up to 100% & above
+    static constexpr auto bins = std::size_t{12};
+
+    std::size_t callbacks{0};
+
+    /// Duration relative to the deadline
+    double median{0.0};
+    double p90{0.0};
+    double p99{0.0};
+    double max{0.0};
+
+    /// Callbacks that took longer than their deadline
+    std::size_t overruns{0};
+
+    /// Gaps between two callbacks of more than 1.5 deadlines, the driver
+    /// most likely dropped a buffer
+    std::size_t xruns{0};
+
+    /// 99th percentile of the deviation of the interval between two
+    /// callbacks from the deadline, relative to the deadline
+    double jitter{0.0};
+
+    /// Bin 0 counts loads below 2^-10, bin k loads in [2^(k-11), 2^(k-10)),
+    /// the last bin everything from 100% up
+    std::array<std::size_t, bins> histogram{};
+};
+
+/// Timings in the order they were recorded
+[[nodiscard]] auto analyze(std::span<CallbackTiming const> timings) -> CallbackStatistics;
+
+}  // namespace ra
@@ -0,0 +1,113 @@
+#include "CallbackProfiler.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <numeric>
+#include <vector>
+
+namespace {
+
+// 1 ms blocks, back to back
+auto makeTimings(std::vector<std::uint64_t> const& durations) -> std::vector<ra::CallbackTiming>
+{
+    auto timings = std::vector<ra::CallbackTiming>{};
+    for (auto i{0UL}; i < durations.size(); ++i) {
+        timings.push_back({.start = i * 1'000'000, .duration = durations[i], .deadline = 1'000'000});
+    }
+    return timings;
+}
+
+}  // namespace
+
+TEST_CASE("RaumAkustik: CallbackProfiler", "")
+{
+    auto profiler = ra::CallbackProfiler{8};
+    REQUIRE(profiler.capacity() == 8);
+    REQUIRE(profiler.written() == 0);
+
+    auto out = std::vector<ra::CallbackTiming>(16);
+    REQUIRE(profiler.latest(out) == 0);
+
+    for (auto i{0UL}; i < 5; ++i) {
+        profiler({.start = i, .duration = i * 10, .deadline = 100});
+    }
+    REQUIRE(profiler.written() == 5);
+    REQUIRE(profiler.latest(out) == 5);
+    REQUIRE(out[0].start == 0);
+    REQUIRE(out[4].start == 4);
+    REQUIRE(out[4].duration == 40);
+    REQUIRE(out[4].deadline == 100);
+
+    // Only the last ones fit
+    REQUIRE(profiler.latest(std::span{out}.first(2)) == 2);
+    REQUIRE(out[0].start == 3);
+    REQUIRE(out[1].start == 4);
+
+    // The oldest slot may be overwritten right now
+    for (auto i{5UL}; i < 20; ++i) {
+        profiler({.start = i, .duration = i * 10, .deadline = 100});
+    }
+    REQUIRE(profiler.latest(out) == 7);
+    REQUIRE(out[0].start == 13);
+    REQUIRE(out[6].start == 19);
+
+    profiler.reset();
+    REQUIRE(profiler.written() == 0);
+    REQUIRE(profiler.latest(out) == 0);
+}
+
+TEST_CASE("RaumAkustik: analyze(CallbackTiming)", "")
+{
+    SECTION("empty")
+    {
+        auto const stats = ra::analyze({});
+        REQUIRE(stats.callbacks == 0);
+        REQUIRE(stats.max == 0.0);
+        REQUIRE(stats.jitter == 0.0);
+    }
+
+    SECTION("load")
+    {
+        // 1% to 100% of the deadline
+        auto durations = std::vector<std::uint64_t>(100);
+        std::iota(durations.begin(), durations.end(), std::uint64_t(1));
+        for (auto& duration : durations) {
+            duration *= 10'000;
+        }
+
+        auto const stats = ra::analyze(makeTimings(durations));
+        REQUIRE(stats.callbacks == 100);
+        REQUIRE(stats.median == Catch::Approx(0.50));
+        REQUIRE(stats.p90 == Catch::Approx(0.90));
+        REQUIRE(stats.p99 == Catch::Approx(0.99));
+        REQUIRE(stats.max == Catch::Approx(1.00));
+        REQUIRE(stats.overruns == 0);
+        REQUIRE(stats.xruns == 0);
+        REQUIRE(stats.jitter == Catch::Approx(0.0));
+
+        // One octave per bin, 100% lands in the last one
+        REQUIRE(std::reduce(stats.histogram.begin(), stats.histogram.end()) == 100);
+        REQUIRE(stats.histogram[0] == 0);
+        REQUIRE(stats.histogram[4] == 1);   // 1%
+        REQUIRE(stats.histogram[5] == 2);   // 2% & 3%
+        REQUIRE(stats.histogram[10] == 50); // 50% to 99%
+        REQUIRE(stats.histogram[11] == 1);  // 100%
+    }
+
+    SECTION("overruns & xruns")
+    {
+        auto timings = makeTimings({100'000, 1'500'000, 100'000, 100'000});
+
+        // A dropped buffer, plus a late one
+        timings[2].start += 1'000'000;
+        timings[3].start += 1'200'000;
+
+        auto const stats = ra::analyze(timings);
+        REQUIRE(stats.overruns == 1);
+        REQUIRE(stats.xruns == 1);
+        REQUIRE(stats.max == Catch::Approx(1.5));
+        REQUIRE(stats.histogram[11] == 1);
+        REQUIRE(stats.jitter == Catch::Approx(1.0));
+    }
+}
@@ -0,0 +1,197 @@
+#include "Deconvolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <numeric>
+
+namespace ra {
+
+namespace detail {
+
+auto taper(std::span<double> response, std::size_t fadeIn) -> void
+{
+    auto const fade = [](std::size_t index, std::size_t count) {
+        auto const t = (static_cast<double>(index) + 0.5) / static_cast<double>(count);
+        return 0.5 - 0.5 * std::cos(std::numbers::pi * t);
+    };
+
+    fadeIn             = std::min(fadeIn, response.size());
+    auto const fadeOut = response.size() / 10;
+    for (auto i{0UL}; i < fadeIn; ++i) {
+        response[i] *= fade(i, fadeIn);
+    }
+    for (auto i{0UL}; i < fadeOut; ++i) {
+        response[response.size() - 1 - i] *= fade(i, fadeOut);
+    }
+}
+
+}  // namespace detail
+
+Deconvolver::Deconvolver(Spec const& spec)
+    : _spec{spec}
+    , _convolver{generate(spec.sweep).inverse, spec.blockSize}
+    , _input(_convolver.blockSize())
+    , _output(_convolver.blockSize())
+{
+    auto const fs      = spec.sweep.sampleRate.numerical_value_in(si::hertz);
+    auto const samples = [fs](auto duration) {
+        return static_cast<std::size_t>(duration.numerical_value_in(si::second) * fs);
+    };
+
+    // The direct sound of the linear response sits at the last sweep sample
+    _direct  = std::max(samples(spec.sweep.duration), std::size_t(1)) - 1;
+    _preRoll = std::min(samples(spec.preRoll), _direct);
+    _length  = samples(spec.length);
+    _rate    = sweepRate(spec.sweep).numerical_value_in(si::second) * fs;
+
+    auto const lead = spec.harmonics > 1 ? static_cast<std::size_t>(std::lround(_rate * std::log(spec.harmonics))) : 0;
+    _begin          = _direct - std::min(_direct, _preRoll + lead);
+    _response       = std::vector<double>(_direct - _begin + _length);
+}
+
+auto Deconvolver::operator()(std::span<float const> recording) -> void
+{
+    while (not recording.empty()) {
+        auto const count = std::min(recording.size(), _input.size() - _fill);
+        std::copy_n(recording.begin(), count, std::next(_input.begin(), static_cast<std::ptrdiff_t>(_fill)));
+        recording = recording.subspan(count);
+        _fill += count;
+
+        if (_fill == _input.size()) {
+            processBlock();
+        }
+    }
+}
+
+auto Deconvolver::processBlock() -> void
+{
+    std::fill(std::next(_input.begin(), static_cast<std::ptrdiff_t>(_fill)), _input.end(), 0.0F);
+    _convolver(_input, _output);
+    _fill = 0;
+
+    // Copy the overlap of this block with the window
+    auto const end   = _position + _output.size();
+    auto const first = std::max(_position, _begin);
+    auto const last  = std::min(end, _begin + _response.size());
+    for (auto i{first}; i < last; ++i) {
+        _response[i - _begin] = static_cast<double>(_output[i - _position]);
+    }
+    _position = end;
+}
+
+auto Deconvolver::flush() -> void
+{
+    while (_position < _begin + _response.size()) {
+        processBlock();
+    }
+}
+
+auto Deconvolver::harmonicStart(std::size_t order) const -> std::ptrdiff_t
+{
+    auto const offset = std::lround(_rate * std::log(static_cast<double>(order)));
+    return static_cast<std::ptrdiff_t>(_direct - _preRoll) - offset - static_cast<std::ptrdiff_t>(_begin);
+}
+
+auto Deconvolver::finish() -> std::vector<double>
+{
+    flush();
+
+    auto const first = std::next(_response.begin(), harmonicStart(1));
+    auto response    = std::vector<double>(first, std::next(first, static_cast<std::ptrdiff_t>(_preRoll + _length)));
+    detail::taper(response, _preRoll);
+
+    if (_spec.normalize) {
+        auto const peak = std::transform_reduce(
+            response.begin(),
+            response.end(),
+            0.0,
+            [](auto l, auto r) { return std::max(l, r); },
+            [](auto x) { return std::abs(x); }
+        );
+        if (peak > 0.0) {
+            std::transform(response.begin(), response.end(), response.begin(), [peak](auto x) { return x / peak; });
+        }
+    }
+
+    return response;
+}
+
+auto Deconvolver::distortion() -> HarmonicDistortion
+{
+    flush();
+
+    // Spectra of each order with the FFT of the convolver, order 1 is the
+    // linear response. Every window ends where the next lower order begins.
+    auto const orders  = std::max(_spec.harmonics, std::size_t(1));
+    auto const fftSize = _convolver.blockSize() * 2;
+    auto const bins    = fftSize / 2 + 1;
+
+    auto magnitudes = std::vector<std::vector<double>>(orders, std::vector<double>(bins, 0.0));
+    auto window     = std::vector<double>(fftSize);
+    for (auto order{1UL}; order <= orders; ++order) {
+        auto const start = harmonicStart(order);
+        if (start < 0) {
+            continue;
+        }
+
+        auto const end = order == 1 ? start + static_cast<std::ptrdiff_t>(_preRoll + _length)
+                                    : harmonicStart(order - 1);
+
+        auto const length = std::min({
+            static_cast<std::size_t>(end - start),
+            fftSize,
+            _response.size() - static_cast<std::size_t>(start),
+        });
+
+        auto const first = std::next(_response.begin(), start);
+        std::copy_n(first, length, window.begin());
+        detail::taper(std::span{window}.first(length), _preRoll);
+
+        auto const spectrum = _convolver.spectrum(std::span{window}.first(length));
+        std::transform(spectrum.begin(), spectrum.end(), magnitudes[order - 1].begin(), [](auto bin) {
+            return std::abs(bin);
+        });
+    }
+
+    // The k-th harmonic of the fundamental in bin i is in bin k * i. It can
+    // only be measured while k * f is still inside the sweep range.
+    auto const fs       = _spec.sweep.sampleRate.numerical_value_in(si::hertz);
+    auto const binWidth = fs / static_cast<double>(fftSize);
+    auto const from     = _spec.sweep.from.numerical_value_in(si::hertz);
+    auto const to       = _spec.sweep.to.numerical_value_in(si::hertz);
+    auto const lowest   = std::max(static_cast<std::size_t>(std::ceil(from / binWidth)), std::size_t(1));
+    auto const highest  = std::min(static_cast<std::size_t>(to / binWidth), bins - 1);
+
+    auto result      = HarmonicDistortion{};
+    result.harmonics = std::vector<std::vector<double>>(orders - 1);
+    for (auto bin{lowest}; bin <= highest; ++bin) {
+        auto const fundamental = std::max(magnitudes[0][bin], 1e-30);
+
+        auto sum = 0.0;
+        for (auto order{2UL}; order <= orders; ++order) {
+            auto level = -std::numeric_limits<double>::infinity();
+            if (order * bin <= highest) {
+                auto const harmonic = magnitudes[order - 1][order * bin];
+                sum += harmonic * harmonic;
+                level = 20.0 * std::log10(std::max(harmonic / fundamental, 1e-30));
+            }
+            result.harmonics[order - 2].push_back(level);
+        }
+
+        result.frequency.push_back(static_cast<double>(bin) * binWidth);
+        result.thd.push_back(100.0 * std::sqrt(sum) / fundamental);
+    }
+
+    return result;
+}
+
+auto deconvolve(Deconvolver::Spec const& spec, std::span<float const> recording) -> std::vector<double>
+{
+    auto deconvolver = Deconvolver{spec};
+    deconvolver(recording);
+    return deconvolver.finish();
+}
+
+}  // namespace ra
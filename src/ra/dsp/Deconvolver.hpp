@@ -0,0 +1,105 @@
+#pragma once
+
+#include <ra/dsp/PartitionedConvolver.hpp>
+#include <ra/generator/ExponentialSweep.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Harmonic distortion over the excitation frequency
+struct HarmonicDistortion
+{
+    /// Frequencies of the fundamental in Hz
+    std::vector<double> frequency;
+
+    /// Level relative to the fundamental in dB, one row per order starting
+    /// with the 2nd harmonic. -inf where the harmonic is above the sweep
+    /// range or Nyquist.
+    std::vector<std::vector<double>> harmonics;
+
+    /// Total harmonic distortion in percent, of the harmonics inside the
+    /// sweep range
+    std::vector<double> thd;
+};
+
+/// Impulse response from the recording of an exponential sweep
+///
+/// The recording is convolved with the inverse sweep block by block, so
+/// captures can be fed while they are recorded and only the windowed part
+/// of the result is kept. The linear response starts one sweep length into
+/// the convolution, the response of the k-th harmonic ends up L * ln(k)
+/// in front of it.
+struct Deconvolver
+{
+    struct Spec
+    {
+        /// The sweep played during the capture
+        ExponentialSweep sweep;
+
+        /// Kept after the direct sound
+        quantity<isq::duration[si::second]> length{2.0 * si::second};
+
+        /// Kept before the direct sound, has to be shorter than L * ln(2) to
+        /// exclude the 2nd harmonic
+        quantity<isq::duration[si::second]> preRoll{0.005 * si::second};
+
+        std::size_t blockSize{8192};
+
+        /// Scale the peak to 1
+        bool normalize{true};
+
+        /// Highest harmonic kept for the distortion analysis, 0 or 1 only
+        /// keeps the linear response
+        std::size_t harmonics{0};
+    };
+
+    explicit Deconvolver(Spec const& spec);
+
+    /// Any number of samples
+    auto operator()(std::span<float const> recording) -> void;
+
+    /// Flushes the convolution and returns the windowed impulse response
+    [[nodiscard]] auto finish() -> std::vector<double>;
+
+    /// Flushes the convolution and analyzes the harmonic responses
+    [[nodiscard]] auto distortion() -> HarmonicDistortion;
+
+private:
+    auto processBlock() -> void;
+    auto flush() -> void;
+
+    /// Start of the response of the given harmonic order, relative to _begin
+    [[nodiscard]] auto harmonicStart(std::size_t order) const -> std::ptrdiff_t;
+
+    Spec _spec;
+    PartitionedConvolver _convolver;
+
+    std::vector<float> _input;
+    std::vector<float> _output;
+    std::size_t _fill{0};
+    std::size_t _position{0};
+
+    // Output samples [_begin, _begin + _response.size()) are kept
+    std::size_t _direct{0};
+    std::size_t _begin{0};
+    std::size_t _preRoll{0};
+    std::size_t _length{0};
+    double _rate{0.0};
+    std::vector<double> _response;
+};
+
+/// Deconvolves a complete capture
+[[nodiscard]] auto deconvolve(Deconvolver::Spec const& spec, std::span<float const> recording)
+    -> std::vector<double>;
+
+namespace detail {
+
+/// Raised cosine over the first fadeIn samples and the last tenth
+auto taper(std::span<double> response, std::size_t fadeIn) -> void;
+
+}  // namespace detail
+
+}  // namespace ra
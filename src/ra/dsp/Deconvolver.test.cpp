@@ -0,0 +1,128 @@
+#include "Deconvolver.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("RaumAkustik: Deconvolver", "")
+{
+    using ra::si::unit_symbols::Hz;
+    using ra::si::unit_symbols::ms;
+    using ra::si::unit_symbols::s;
+
+    auto const spec = ra::Deconvolver::Spec{
+        .sweep =
+            ra::ExponentialSweep{
+                .from       = 50.0 * Hz,
+                .to         = 3'000.0 * Hz,
+                .duration   = 0.5 * s,
+                .sampleRate = 8'000.0 * Hz,
+                .fadeIn     = 10.0 * ms,
+                .fadeOut    = 5.0 * ms,
+            },
+        .length    = 0.1 * s,
+        .preRoll   = 5.0 * ms,
+        .blockSize = 256,
+    };
+
+    // Direct sound after 100 samples and one reflection at half the amplitude
+    auto const sweep = ra::generate(spec.sweep).sweep;
+    auto recording   = std::vector<float>(sweep.size() + 800);
+    for (auto i{0UL}; i < sweep.size(); ++i) {
+        recording[i + 100] += sweep[i];
+        recording[i + 300] += 0.5F * sweep[i];
+    }
+
+    auto const impulse = ra::deconvolve(spec, recording);
+    REQUIRE(impulse.size() == 40 + 800);
+
+    auto const peak = std::max_element(impulse.begin(), impulse.end(), [](auto l, auto r) {
+        return std::abs(l) < std::abs(r);
+    });
+    REQUIRE(std::distance(impulse.begin(), peak) == 40 + 100);
+    REQUIRE(*peak == Catch::Approx(1.0));
+    REQUIRE(impulse[40 + 300] == Catch::Approx(0.5).margin(0.03));
+    REQUIRE(std::abs(impulse[40 + 200]) < 0.05);
+
+    // Streaming in odd chunks gives the same result
+    auto deconvolver = ra::Deconvolver{spec};
+    for (auto first{0UL}; first < recording.size(); first += 333) {
+        auto const count = std::min<std::size_t>(333, recording.size() - first);
+        deconvolver(std::span{recording}.subspan(first, count));
+    }
+
+    auto const streamed = deconvolver.finish();
+    REQUIRE(streamed.size() == impulse.size());
+    for (auto i{0UL}; i < impulse.size(); ++i) {
+        REQUIRE(streamed[i] == Catch::Approx(impulse[i]).margin(1e-9));
+    }
+}
+
+TEST_CASE("RaumAkustik: Deconvolver(distortion)", "")
+{
+    using ra::si::unit_symbols::Hz;
+    using ra::si::unit_symbols::ms;
+    using ra::si::unit_symbols::s;
+
+    auto const spec = ra::Deconvolver::Spec{
+        .sweep =
+            ra::ExponentialSweep{
+                .from       = 100.0 * Hz,
+                .to         = 1'000.0 * Hz,
+                .duration   = 1.0 * s,
+                .sampleRate = 8'000.0 * Hz,
+                .fadeIn     = 10.0 * ms,
+                .fadeOut    = 10.0 * ms,
+            },
+        .length    = 0.05 * s,
+        .preRoll   = 5.0 * ms,
+        .blockSize = 256,
+        .harmonics = 3,
+    };
+
+    // y = x + 0.1 * x^2 + 0.08 * x^3, a sine with unit amplitude gets a
+    // fundamental of 1.06, a 2nd harmonic of 0.05 and a 3rd of 0.02
+    auto const sweep = ra::generate(spec.sweep).sweep;
+    auto recording   = std::vector<float>(sweep.size() + 500);
+    for (auto i{0UL}; i < sweep.size(); ++i) {
+        auto const x      = sweep[i];
+        recording[i + 50] = x + 0.1F * x * x + 0.08F * x * x * x;
+    }
+
+    auto deconvolver = ra::Deconvolver{spec};
+    deconvolver(recording);
+
+    auto const result = deconvolver.distortion();
+    REQUIRE(result.harmonics.size() == 2);
+    REQUIRE(result.frequency.size() == result.thd.size());
+    REQUIRE(result.frequency.front() >= 100.0);
+    REQUIRE(result.frequency.back() <= 1'000.0);
+
+    // Harmonics are only measurable inside the sweep range
+    for (auto i{0UL}; i < result.frequency.size(); ++i) {
+        auto const f = result.frequency[i];
+        if (f * 3.0 > 1'000.0) {
+            REQUIRE(std::isinf(result.harmonics[1][i]));
+        }
+        if (f * 2.0 > 1'000.0) {
+            REQUIRE(std::isinf(result.harmonics[0][i]));
+        }
+        if (f < 200.0 or f * 3.0 > 900.0) {
+            continue;
+        }
+
+        REQUIRE(result.harmonics[0][i] == Catch::Approx(20.0 * std::log10(0.05 / 1.06)).margin(1.0));
+        REQUIRE(result.harmonics[1][i] == Catch::Approx(20.0 * std::log10(0.02 / 1.06)).margin(1.0));
+        REQUIRE(result.thd[i] == Catch::Approx(100.0 * std::hypot(0.05, 0.02) / 1.06).margin(0.5));
+    }
+
+    // The linear response is unaffected by the harmonics in front of it
+    auto const impulse = deconvolver.finish();
+    auto const peak    = std::max_element(impulse.begin(), impulse.end(), [](auto l, auto r) {
+        return std::abs(l) < std::abs(r);
+    });
+    REQUIRE(std::distance(impulse.begin(), peak) == 40 + 50);
+}
@@ -0,0 +1,140 @@
+#include "FrequencyResponse.hpp"
+
+#include <neo/container/mdspan.hpp>
+#include <neo/fft.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <numbers>
+
+namespace ra {
+
+auto frequencyResponse(std::span<double const> impulse, double sampleRate) -> FrequencyResponse
+{
+    auto const size  = std::bit_ceil(std::max(impulse.size(), std::size_t(2)));
+    auto const order = static_cast<std::size_t>(std::countr_zero(size));
+    auto const bins  = size / 2U + 1U;
+
+    auto in  = std::vector<double>(size, 0.0);
+    auto out = std::vector<std::complex<double>>(bins);
+    std::copy(impulse.begin(), impulse.end(), in.begin());
+
+    auto rfft = neo::fft::rfft_plan<double>{neo::fft::from_order, order};
+    rfft(
+        stdex::mdspan<double, stdex::dextents<std::size_t, 1>>{in.data(), size},
+        stdex::mdspan<std::complex<double>, stdex::dextents<std::size_t, 1>>{out.data(), bins}
+    );
+
+    auto response = FrequencyResponse{
+        .sampleRate = sampleRate,
+        .fftSize    = size,
+        .frequency  = std::vector<double>(bins),
+        .magnitude  = std::vector<double>(bins),
+        .phase      = std::vector<double>(bins),
+    };
+
+    auto offset = 0.0;
+    auto last   = 0.0;
+    for (auto i{0UL}; i < bins; ++i) {
+        auto const wrapped = std::arg(out[i]);
+        if (i != 0) {
+            auto const delta = wrapped - last;
+            offset -= std::round(delta / (2.0 * std::numbers::pi)) * 2.0 * std::numbers::pi;
+        }
+        last = wrapped;
+
+        response.frequency[i] = static_cast<double>(i) * sampleRate / static_cast<double>(size);
+        response.magnitude[i] = std::abs(out[i]);
+        response.phase[i]     = wrapped + offset;
+    }
+
+    return response;
+}
+
+auto findPeaks(
+    FrequencyResponse const& response,
+    quantity<isq::frequency[si::hertz]> fmin,
+    quantity<isq::frequency[si::hertz]> fmax,
+    double prominence
+) -> std::vector<ResponsePeak>
+{
+    auto const& freq = response.frequency;
+    if (freq.size() < 3) {
+        return {};
+    }
+
+    auto db = std::vector<double>(freq.size());
+    std::transform(response.magnitude.begin(), response.magnitude.end(), db.begin(), [](auto mag) {
+        return 20.0 * std::log10(std::max(mag, 1e-12));
+    });
+
+    auto const lo = fmin.numerical_value_in(si::hertz);
+    auto const hi = fmax.numerical_value_in(si::hertz);
+
+    auto peaks = std::vector<ResponsePeak>{};
+    for (auto i{1UL}; i < freq.size() - 1U; ++i) {
+        if (freq[i] < lo or freq[i] > hi or db[i] <= db[i - 1] or db[i] < db[i + 1]) {
+            continue;
+        }
+
+        // Prominence against the lowest point on either side, up to the next higher sample
+        auto leftMin = db[i];
+        for (auto j = i; j > 0 and db[j - 1] <= db[i]; --j) {
+            leftMin = std::min(leftMin, db[j - 1]);
+        }
+        auto rightMin = db[i];
+        for (auto j = i; j + 1 < db.size() and db[j + 1] <= db[i]; ++j) {
+            rightMin = std::min(rightMin, db[j + 1]);
+        }
+        if (db[i] - std::max(leftMin, rightMin) < prominence) {
+            continue;
+        }
+
+        // Parabolic interpolation on the dB magnitude, b > a & b >= c so
+        // the parabola opens downwards
+        auto const a     = db[i - 1];
+        auto const b     = db[i];
+        auto const c     = db[i + 1];
+        auto const denom = a - 2.0 * b + c;
+        auto const p     = denom < 0.0 ? 0.5 * (a - c) / denom : 0.0;
+        auto const bin   = freq[1] - freq[0];
+
+        peaks.push_back({
+            .frequency = (freq[i] + p * bin) * si::hertz,
+            .level     = b - 0.25 * (a - c) * p,
+        });
+    }
+
+    return peaks;
+}
+
+auto octaveBandEnergies(
+    FrequencyResponse const& response,
+    std::span<quantity<isq::frequency[si::hertz]> const> centers
+) -> std::vector<double>
+{
+    auto const& freq = response.frequency;
+    auto const& mag  = response.magnitude;
+    auto const last  = freq.size() - 1U;
+    auto const scale = 1.0 / static_cast<double>(response.fftSize);
+
+    auto energies = std::vector<double>(centers.size(), 0.0);
+    for (auto b{0UL}; b < centers.size(); ++b) {
+        auto const center = centers[b].numerical_value_in(si::hertz);
+        auto const lo     = center / std::numbers::sqrt2;
+        auto const hi     = center * std::numbers::sqrt2;
+
+        for (auto i{0UL}; i < freq.size(); ++i) {
+            if (freq[i] >= lo and freq[i] < hi) {
+                // DC and Nyquist exist once, all other bins twice in the full spectrum
+                auto const weight = (i == 0 or i == last) ? 1.0 : 2.0;
+                energies[b] += weight * mag[i] * mag[i] * scale;
+            }
+        }
+    }
+    return energies;
+}
+
+}  // namespace ra
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ra/unit/frequency.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// One-sided spectrum of an impulse response
+struct FrequencyResponse
+{
+    double sampleRate{0.0};
+    std::size_t fftSize{0};
+    std::vector<double> frequency;
+
+    /// Linear magnitude
+    std::vector<double> magnitude;
+
+    /// Unwrapped phase in radians
+    std::vector<double> phase;
+};
+
+struct ResponsePeak
+{
+    quantity<isq::frequency[si::hertz]> frequency;
+
+    /// Magnitude in dB
+    double level{0.0};
+};
+
+/// Zero pads the impulse response to the next power of two.
+[[nodiscard]] auto frequencyResponse(std::span<double const> impulse, double sampleRate) -> FrequencyResponse;
+
+/// Local maxima of the magnitude response between fmin and fmax that stand
+/// out at least prominence dB against their neighbourhood, refined with
+/// parabolic interpolation on the dB magnitude. Sorted by frequency.
+[[nodiscard]] auto findPeaks(
+    FrequencyResponse const& response,
+    quantity<isq::frequency[si::hertz]> fmin,
+    quantity<isq::frequency[si::hertz]> fmax,
+    double prominence = 3.0
+) -> std::vector<ResponsePeak>;
+
+/// Energy of the response in octave bands around each center frequency,
+/// scaled so the sum over all bins equals the energy of the impulse response.
+[[nodiscard]] auto octaveBandEnergies(
+    FrequencyResponse const& response,
+    std::span<quantity<isq::frequency[si::hertz]> const> centers
+) -> std::vector<double>;
+
+}  // namespace ra
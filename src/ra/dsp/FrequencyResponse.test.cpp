@@ -0,0 +1,62 @@
+#include "FrequencyResponse.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+TEST_CASE("RaumAkustik: frequencyResponse", "")
+{
+    using namespace mp_units::si::unit_symbols;
+
+    SECTION("impulse")
+    {
+        auto impulse = std::vector<double>(1000, 0.0);
+        impulse[0]   = 1.0;
+
+        auto const response = ra::frequencyResponse(impulse, 48'000.0);
+        REQUIRE(response.fftSize == 1024);
+        REQUIRE(response.magnitude.size() == 513);
+        REQUIRE(response.frequency.back() == Catch::Approx(24'000.0));
+        for (auto i{0UL}; i < response.magnitude.size(); ++i) {
+            REQUIRE(response.magnitude[i] == Catch::Approx(1.0));
+            REQUIRE(response.phase[i] == Catch::Approx(0.0).margin(1e-9));
+        }
+
+        auto const all      = std::array{375.0 * Hz, 1'500.0 * Hz, 6'000.0 * Hz, 24'000.0 * Hz};
+        auto const energies = ra::octaveBandEnergies(response, all);
+        auto const total    = std::accumulate(energies.begin(), energies.end(), 0.0);
+        REQUIRE(energies[0] < energies[1]);
+        REQUIRE(total < 1.0);
+    }
+
+    SECTION("delay")
+    {
+        auto impulse = std::vector<double>(256, 0.0);
+        impulse[3]   = 1.0;
+
+        auto const response = ra::frequencyResponse(impulse, 256.0);
+        REQUIRE(response.phase[10] == Catch::Approx(-2.0 * std::numbers::pi * 10.0 * 3.0 / 256.0));
+        REQUIRE(response.phase[100] == Catch::Approx(-2.0 * std::numbers::pi * 100.0 * 3.0 / 256.0));
+    }
+
+    SECTION("modes")
+    {
+        auto const fs = 8'000.0;
+        auto impulse  = std::vector<double>(8'000, 0.0);
+        for (auto i{0UL}; i < impulse.size(); ++i) {
+            auto const t = static_cast<double>(i) / fs;
+            impulse[i]   = std::exp(-t * 20.0) * (std::sin(2.0 * std::numbers::pi * 57.3 * t)
+                                                + std::sin(2.0 * std::numbers::pi * 121.7 * t));
+        }
+
+        auto const response = ra::frequencyResponse(impulse, fs);
+        auto const peaks    = ra::findPeaks(response, 20.0 * Hz, 200.0 * Hz, 6.0);
+        REQUIRE(peaks.size() == 2);
+        REQUIRE(peaks[0].frequency.numerical_value_in(Hz) == Catch::Approx(57.3).margin(0.5));
+        REQUIRE(peaks[1].frequency.numerical_value_in(Hz) == Catch::Approx(121.7).margin(0.5));
+    }
+}
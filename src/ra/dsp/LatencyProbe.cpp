@@ -0,0 +1,232 @@
+#include "LatencyProbe.hpp"
+
+#include <ra/generator/MaximumLengthSequence.hpp>
+
+#include <neo/container/mdspan.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+namespace ra {
+
+namespace {
+
+using RealVector    = stdex::mdspan<double, stdex::dextents<std::size_t, 1>>;
+using ComplexVector = stdex::mdspan<std::complex<double>, stdex::dextents<std::size_t, 1>>;
+
+}  // namespace
+
+LatencyProbe::LatencyProbe(Spec const& spec)
+    : _spec{spec}
+    , _sequence{generate(MaximumLengthSequence{.order = spec.order})}
+    , _fftSize{std::bit_ceil(_sequence.size() * 2)}
+    , _rfft{neo::fft::from_order, static_cast<std::size_t>(std::countr_zero(_fftSize))}
+    , _reference(_fftSize / 2 + 1)
+    , _recording(_sequence.size())
+    , _time(_fftSize)
+    , _spectrum(_fftSize / 2 + 1)
+    , _correlation(_sequence.size())
+    , _historySize{std::max(spec.history, std::size_t(2))}
+{
+    // Two periods, so a linear correlation of one period of the recording
+    // against it covers every circular lag
+    auto const period = _sequence.size();
+    for (auto i{0UL}; i < period * 2; ++i) {
+        _time[i] = static_cast<double>(_sequence[i % period]);
+    }
+    _rfft(RealVector{_time.data(), _time.size()}, ComplexVector{_reference.data(), _reference.size()});
+
+    _history.reserve(_historySize);
+}
+
+auto LatencyProbe::period() const noexcept -> std::size_t { return _sequence.size(); }
+
+auto LatencyProbe::render(std::size_t position, std::span<float> out) const -> void
+{
+    auto const period = _sequence.size();
+    auto const level  = _spec.level;
+
+    while (not out.empty()) {
+        auto const offset = position % period;
+        auto const count  = std::min(out.size(), period - offset);
+        auto const first  = std::next(_sequence.begin(), static_cast<std::ptrdiff_t>(offset));
+        std::transform(first, std::next(first, static_cast<std::ptrdiff_t>(count)), out.begin(), [level](auto x) {
+            return x * level;
+        });
+
+        position += count;
+        out = out.subspan(count);
+    }
+}
+
+auto LatencyProbe::operator()(std::span<float const> input) -> std::size_t
+{
+    auto const period   = _sequence.size();
+    auto const accepted = _accepted;
+
+    while (not input.empty()) {
+        auto const offset = _position % period;
+        auto const count  = std::min(input.size(), period - offset);
+        std::copy_n(input.begin(), count, std::next(_recording.begin(), static_cast<std::ptrdiff_t>(offset)));
+
+        _position += count;
+        input = input.subspan(count);
+
+        // The first period still holds the onset, from the second on the
+        // recording is a steady state circular convolution
+        if (_position % period == 0 and _position > period) {
+            analyzePeriod();
+        }
+    }
+
+    return _accepted - accepted;
+}
+
+auto LatencyProbe::latest() const -> std::optional<LatencyEstimate>
+{
+    if (_history.empty()) {
+        return std::nullopt;
+    }
+    return _history.back();
+}
+
+auto LatencyProbe::accepted() const noexcept -> std::size_t { return _accepted; }
+
+auto LatencyProbe::rejected() const noexcept -> std::size_t { return _rejected; }
+
+auto LatencyProbe::drift() const -> double
+{
+    if (_history.size() < 2) {
+        return 0.0;
+    }
+
+    auto const count = static_cast<double>(_history.size());
+    auto meanX       = 0.0;
+    auto meanY       = 0.0;
+    for (auto const& estimate : _history) {
+        meanX += static_cast<double>(estimate.position) / count;
+        meanY += estimate.latency / count;
+    }
+
+    auto covariance = 0.0;
+    auto variance   = 0.0;
+    for (auto const& estimate : _history) {
+        auto const x = static_cast<double>(estimate.position) - meanX;
+        covariance += x * (estimate.latency - meanY);
+        variance += x * x;
+    }
+
+    return variance > 0.0 ? covariance / variance * 1e6 : 0.0;
+}
+
+auto LatencyProbe::reset() -> void
+{
+    std::fill(_recording.begin(), _recording.end(), 0.0F);
+    _history.clear();
+    _position = 0;
+    _accepted = 0;
+    _rejected = 0;
+}
+
+auto LatencyProbe::analyzePeriod() -> void
+{
+    auto const period = _sequence.size();
+
+    std::fill(_time.begin(), _time.end(), 0.0);
+    std::copy(_recording.begin(), _recording.end(), _time.begin());
+    _rfft(RealVector{_time.data(), _time.size()}, ComplexVector{_spectrum.data(), _spectrum.size()});
+
+    // The inverse transform is unscaled
+    auto const scale = 1.0 / static_cast<double>(_fftSize);
+    for (auto k{0UL}; k < _spectrum.size(); ++k) {
+        _spectrum[k] = std::conj(_spectrum[k]) * _reference[k] * scale;
+    }
+    _rfft(ComplexVector{_spectrum.data(), _spectrum.size()}, RealVector{_time.data(), _time.size()});
+
+    // Lag j of the linear correlation is the circular lag period - j
+    for (auto k{0UL}; k < period; ++k) {
+        _correlation[k] = _time[period - k];
+    }
+
+    auto const peak = std::max_element(_correlation.begin(), _correlation.end(), [](auto l, auto r) {
+        return std::abs(l) < std::abs(r);
+    });
+
+    auto const power = std::inner_product(_correlation.begin(), _correlation.end(), _correlation.begin(), 0.0);
+    auto const rms   = std::sqrt(power / static_cast<double>(period));
+
+    auto const confidence = rms > 0.0 ? std::abs(*peak) / rms : 0.0;
+    if (confidence < _spec.minConfidence) {
+        ++_rejected;
+        return;
+    }
+
+    auto const index = static_cast<std::size_t>(std::distance(_correlation.begin(), peak));
+    auto latency     = detail::interpolatePeak(_correlation, index);
+
+    // Stay within half a period of the last estimate
+    if (not _history.empty()) {
+        auto const size = static_cast<double>(period);
+        latency += std::round((_history.back().latency - latency) / size) * size;
+    }
+
+    if (_history.size() >= _historySize) {
+        _history.erase(_history.begin());
+    }
+    _history.push_back({.latency = latency, .confidence = confidence, .position = _position});
+    ++_accepted;
+}
+
+namespace detail {
+
+auto interpolatePeak(std::span<double const> periodic, std::size_t index) -> double
+{
+    static constexpr auto halfTaps = 32L;
+    static constexpr auto steps    = 32;
+
+    auto const size = static_cast<std::ptrdiff_t>(periodic.size());
+    auto const sign = periodic[index] < 0.0 ? -1.0 : 1.0;
+
+    // Hann windowed sinc reconstruction at a fractional position
+    auto const value = [=](double t) {
+        auto const center = static_cast<std::ptrdiff_t>(std::floor(t));
+        auto sum          = 0.0;
+        for (auto n{center - halfTaps + 1}; n <= center + halfTaps; ++n) {
+            auto const x      = t - static_cast<double>(n);
+            auto const sinc   = std::abs(x) < 1e-9 ? 1.0 : std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+            auto const window = 0.5 + 0.5 * std::cos(std::numbers::pi * x / static_cast<double>(halfTaps));
+            sum += periodic[static_cast<std::size_t>(((n % size) + size) % size)] * sinc * window;
+        }
+        return sum * sign;
+    };
+
+    // Grid search between the neighbours, then a parabola through the best
+    // grid point & its neighbours
+    auto const step = 1.0 / static_cast<double>(steps);
+    auto const peak = static_cast<double>(index);
+    auto best       = peak;
+    auto bestValue  = value(peak);
+    for (auto i{-steps}; i <= steps; ++i) {
+        auto const t = peak + static_cast<double>(i) * step;
+        auto const v = value(t);
+        if (v > bestValue) {
+            best      = t;
+            bestValue = v;
+        }
+    }
+
+    auto const before = value(best - step);
+    auto const after  = value(best + step);
+    auto const denom  = before - 2.0 * bestValue + after;
+    auto const offset = denom < 0.0 ? 0.5 * (before - after) / denom * step : 0.0;
+
+    auto const position = best + offset;
+    return position < 0.0 ? position + static_cast<double>(size) : position;
+}
+
+}  // namespace detail
+
+}  // namespace ra
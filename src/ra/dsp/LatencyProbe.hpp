@@ -0,0 +1,103 @@
+#pragma once
+
+#include <neo/fft.hpp>
+
+#include <complex>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+struct LatencyEstimate
+{
+    /// Round trip in samples, with sub-sample resolution. Unwrapped, so it
+    /// follows the drift instead of jumping by a period.
+    double latency{0.0};
+
+    /// Peak of the correlation over its RMS
+    double confidence{0.0};
+
+    /// Input sample at the end of the analyzed period
+    std::size_t position{0};
+};
+
+/// Round trip latency & clock drift from a looping maximum length sequence
+///
+/// Every period of the recording is circularly correlated with the
+/// sequence through one FFT pair. The peak is refined with band-limited
+/// interpolation. The estimates are tracked over time, the slope of a line
+/// through them is the drift between the input & output clocks. Latencies
+/// have to be shorter than one period.
+struct LatencyProbe
+{
+    struct Spec
+    {
+        /// 2^order - 1 samples per period, 1.37 s at 48 kHz for 16
+        std::size_t order{16};
+
+        float level{0.25F};
+
+        /// Estimates with a weaker correlation peak are dropped
+        double minConfidence{10.0};
+
+        /// Estimates kept for the drift
+        std::size_t history{64};
+    };
+
+    explicit LatencyProbe(Spec const& spec);
+
+    [[nodiscard]] auto period() const noexcept -> std::size_t;
+
+    /// The probe from the given sample on. Only reads the sequence, so it
+    /// can run on the audio thread while another thread analyzes.
+    auto render(std::size_t position, std::span<float> out) const -> void;
+
+    /// The recording from the first rendered sample on, in blocks of any
+    /// size. Doesn't allocate. Returns the number of accepted estimates.
+    auto operator()(std::span<float const> input) -> std::size_t;
+
+    [[nodiscard]] auto latest() const -> std::optional<LatencyEstimate>;
+
+    /// Periods analyzed & dropped for a weak correlation since the last reset
+    [[nodiscard]] auto accepted() const noexcept -> std::size_t;
+    [[nodiscard]] auto rejected() const noexcept -> std::size_t;
+
+    /// Parts per million the latency grows by, 0 until two estimates exist
+    [[nodiscard]] auto drift() const -> double;
+
+    auto reset() -> void;
+
+private:
+    auto analyzePeriod() -> void;
+
+    Spec _spec;
+    std::vector<float> _sequence;
+    std::size_t _fftSize;
+    neo::fft::rfft_plan<double> _rfft;
+    std::vector<std::complex<double>> _reference;
+
+    std::vector<float> _recording;
+    std::size_t _position{0};
+
+    std::vector<double> _time;
+    std::vector<std::complex<double>> _spectrum;
+    std::vector<double> _correlation;
+
+    // reserve() may round the capacity up, the limit is kept separately
+    std::size_t _historySize;
+    std::vector<LatencyEstimate> _history;
+    std::size_t _accepted{0};
+    std::size_t _rejected{0};
+};
+
+namespace detail {
+
+/// Position of the peak of a periodic signal near index, from windowed
+/// sinc interpolation between the neighbouring samples
+[[nodiscard]] auto interpolatePeak(std::span<double const> periodic, std::size_t index) -> double;
+
+}  // namespace detail
+
+}  // namespace ra
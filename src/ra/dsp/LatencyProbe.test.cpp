@@ -0,0 +1,111 @@
+#include "LatencyProbe.hpp"
+
+#include <ra/generator/MaximumLengthSequence.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Recording of the looping probe through a delay that may change over time,
+// band-limited so fractional delays are exact
+auto loopback(ra::LatencyProbe const& probe, std::size_t size, std::function<double(std::size_t)> const& delay)
+    -> std::vector<float>
+{
+    auto const period = static_cast<std::ptrdiff_t>(probe.period());
+    auto played       = std::vector<float>(probe.period());
+    probe.render(0, played);
+
+    auto recording = std::vector<float>(size);
+    for (auto n{0UL}; n < size; ++n) {
+        auto const t = static_cast<double>(n) - delay(n);
+        auto sum     = 0.0;
+        for (auto m{static_cast<std::ptrdiff_t>(std::floor(t)) - 31}; m <= std::floor(t) + 32; ++m) {
+            auto const x      = t - static_cast<double>(m);
+            auto const sinc   = x == 0.0 ? 1.0 : std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+            auto const window = 0.5 + 0.5 * std::cos(std::numbers::pi * x / 32.0);
+            sum += static_cast<double>(played[static_cast<std::size_t>(((m % period) + period) % period)]) * sinc
+                 * window;
+        }
+        recording[n] = static_cast<float>(sum);
+    }
+    return recording;
+}
+
+}  // namespace
+
+TEST_CASE("RaumAkustik: LatencyProbe", "")
+{
+    auto probe = ra::LatencyProbe{{.order = 8, .level = 0.5F}};
+    REQUIRE(probe.period() == 255);
+    REQUIRE(not probe.latest().has_value());
+    REQUIRE(probe.drift() == 0.0);
+
+    SECTION("render")
+    {
+        auto const mls = ra::generate(ra::MaximumLengthSequence{.order = 8});
+        auto out       = std::vector<float>(300);
+        probe.render(250, out);
+        for (auto i{0UL}; i < out.size(); ++i) {
+            REQUIRE(out[i] == mls[(250 + i) % 255] * 0.5F);
+        }
+    }
+
+    SECTION("integer delay")
+    {
+        auto const recording = loopback(probe, 255 * 4, [](auto) { return 37.0; });
+
+        // Any block size, the first period is skipped
+        auto accepted = std::size_t{0};
+        for (auto i{0UL}; i < recording.size(); i += 64) {
+            accepted += probe(std::span{recording}.subspan(i, std::min(std::size_t(64), recording.size() - i)));
+        }
+        REQUIRE(accepted == 3);
+        REQUIRE(probe.accepted() == 3);
+        REQUIRE(probe.rejected() == 0);
+
+        auto const estimate = probe.latest();
+        REQUIRE(estimate.has_value());
+        REQUIRE(estimate->latency == Catch::Approx(37.0).margin(0.01));
+        REQUIRE(estimate->position == 255 * 4);
+        REQUIRE(estimate->confidence > 10.0);
+        REQUIRE(probe.drift() == Catch::Approx(0.0).margin(10.0));
+    }
+
+    SECTION("fractional delay")
+    {
+        for (auto const delay : {12.25, 100.5, 200.8}) {
+            probe.reset();
+            auto const recording = loopback(probe, 255 * 2, [delay](auto) { return delay; });
+            REQUIRE(probe(recording) == 1);
+            REQUIRE(probe.latest()->latency == Catch::Approx(delay).margin(0.02));
+        }
+    }
+
+    SECTION("drift")
+    {
+        // The input clock runs 1000 ppm slow
+        auto const recording = loopback(probe, 255 * 16, [](auto n) { return 20.0 + static_cast<double>(n) * 1e-3; });
+        REQUIRE(probe(recording) == 15);
+        REQUIRE(probe.drift() == Catch::Approx(1000.0).epsilon(0.02));
+        REQUIRE(probe.latest()->latency == Catch::Approx(20.0 + 255.0 * 16.0 * 1e-3).margin(0.5));
+    }
+
+    SECTION("noise")
+    {
+        auto rng   = std::mt19937{42};
+        auto dist  = std::uniform_real_distribution<float>{-1.0F, 1.0F};
+        auto noise = std::vector<float>(255 * 4);
+        std::generate(noise.begin(), noise.end(), [&] { return dist(rng); });
+
+        REQUIRE(probe(noise) == 0);
+        REQUIRE(probe.rejected() == 3);
+        REQUIRE(not probe.latest().has_value());
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+namespace ra {
+
+/// Copies up to out.size() latest entries of a ring, oldest first
+///
+/// The ring is filled by a single writer that never waits for readers.
+/// written() returns the number of entries stored so far & is read again
+/// after the copy, entries the writer lapped meanwhile are dropped. That
+/// includes the one it may be storing right now, so the result is always
+/// below the capacity. load(index) reads one slot of the ring & may be
+/// relaxed, a fence orders it before the re-read.
+template<typename T, typename Written, typename Load>
+[[nodiscard]] auto copyLatest(std::span<T> out, std::size_t capacity, Written written, Load load) -> std::size_t
+{
+    auto const end   = written();
+    auto const first = end - std::min({out.size(), end, capacity});
+    for (auto i{first}; i < end; ++i) {
+        out[i - first] = load(i % capacity);
+    }
+
+    // Keeps the relaxed slot loads above from moving past the re-read, like
+    // the read side of a seqlock
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    auto const now    = written() + 1;
+    auto const valid  = now > capacity ? now - capacity : 0;
+    auto const lapped = std::min(std::max(valid, first) - first, end - first);
+    if (lapped > 0) {
+        auto const from = std::next(out.begin(), static_cast<std::ptrdiff_t>(lapped));
+        auto const to   = std::next(out.begin(), static_cast<std::ptrdiff_t>(end - first));
+        std::copy(from, to, out.begin());
+    }
+
+    return end - first - lapped;
+}
+
+}  // namespace ra
@@ -0,0 +1,103 @@
+#include "MultiSweep.hpp"
+
+#include <ra/dsp/Deconvolver.hpp>
+#include <ra/dsp/PartitionedConvolver.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ra {
+
+MultiSweep::MultiSweep(Spec const& spec) : _spec{spec}, _signal{generate(spec.sweep)}
+{
+    auto const fs      = spec.sweep.sampleRate.numerical_value_in(si::hertz);
+    auto const samples = [fs](auto duration) {
+        return static_cast<std::size_t>(duration.numerical_value_in(si::second) * fs);
+    };
+
+    auto const rate = sweepRate(spec.sweep).numerical_value_in(si::second) * fs;
+    auto const lead = spec.harmonics > 1 ? static_cast<std::size_t>(std::lround(rate * std::log(spec.harmonics))) : 0;
+
+    _preRoll = samples(spec.preRoll);
+    _length  = samples(spec.length);
+    _spacing = _preRoll + _length + lead;
+
+    // Sweeps on the same channel must not overlap
+    _period = std::max(std::max(spec.channels, std::size_t(1)) * _spacing, _signal.sweep.size());
+}
+
+auto MultiSweep::spec() const noexcept -> Spec const& { return _spec; }
+
+auto MultiSweep::spacing() const noexcept -> std::size_t { return _spacing; }
+
+auto MultiSweep::period() const noexcept -> std::size_t { return _period; }
+
+auto MultiSweep::start(std::size_t repetition, std::size_t channel) const noexcept -> std::size_t
+{
+    return repetition * _period + channel * _spacing;
+}
+
+auto MultiSweep::size() const noexcept -> std::size_t
+{
+    auto const repetitions = std::max(_spec.repetitions, std::size_t(1));
+    auto const channels    = std::max(_spec.channels, std::size_t(1));
+    return start(repetitions - 1, channels - 1) + _signal.sweep.size() + _length;
+}
+
+auto MultiSweep::render(std::size_t channel, std::size_t position, std::span<float> out) const -> void
+{
+    std::fill(out.begin(), out.end(), 0.0F);
+
+    auto const& sweep = _signal.sweep;
+    for (auto repetition{0UL}; repetition < _spec.repetitions; ++repetition) {
+        auto const first = std::max(start(repetition, channel), position);
+        auto const last  = std::min(start(repetition, channel) + sweep.size(), position + out.size());
+        for (auto i{first}; i < last; ++i) {
+            out[i - position] = sweep[i - start(repetition, channel)];
+        }
+    }
+}
+
+auto MultiSweep::deconvolve(std::span<float const> recording) const -> std::vector<std::vector<double>>
+{
+    auto convolver = PartitionedConvolver{_signal.inverse, _spec.blockSize};
+    auto input     = std::vector<float>(convolver.blockSize());
+    auto output    = std::vector<float>(convolver.blockSize());
+
+    // The direct sound of each sweep sits at its last sample
+    auto const window = _preRoll + _length;
+    auto const begin  = [this](std::size_t repetition, std::size_t channel) {
+        auto const direct = start(repetition, channel) + _signal.sweep.size() - 1;
+        return direct - std::min(direct, _preRoll);
+    };
+
+    auto const scale = 1.0 / static_cast<double>(std::max(_spec.repetitions, std::size_t(1)));
+    auto responses   = std::vector<std::vector<double>>(_spec.channels, std::vector<double>(window, 0.0));
+
+    auto const end = size();
+    for (auto position{0UL}; position < end; position += input.size()) {
+        auto const first = std::min(position, recording.size());
+        auto const chunk = recording.subspan(first, std::min(recording.size() - first, input.size()));
+        std::fill(std::copy(chunk.begin(), chunk.end(), input.begin()), input.end(), 0.0F);
+        convolver(input, output);
+
+        for (auto repetition{0UL}; repetition < _spec.repetitions; ++repetition) {
+            for (auto channel{0UL}; channel < _spec.channels; ++channel) {
+                auto const offset = begin(repetition, channel);
+                auto const from   = std::max(offset, position);
+                auto const to     = std::min(offset + window, position + output.size());
+                for (auto i{from}; i < to; ++i) {
+                    responses[channel][i - offset] += scale * static_cast<double>(output[i - position]);
+                }
+            }
+        }
+    }
+
+    for (auto& response : responses) {
+        detail::taper(response, _preRoll);
+    }
+
+    return responses;
+}
+
+}  // namespace ra
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <ra/generator/ExponentialSweep.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Exponential sweeps on multiple channels with repetitions for synchronous
+/// averaging, multiple exponential sweep method (MESM), Majdak et al. (2007)
+///
+/// Channels start their sweeps overlapped, each one delayed by just enough
+/// to fit the impulse response and the harmonic responses of the following
+/// channel. A single deconvolution of the capture then yields the responses
+/// of all channels one after another. Every repetition of the schedule
+/// improves the SNR by 3 dB per doubling.
+struct MultiSweep
+{
+    struct Spec
+    {
+        ExponentialSweep sweep;
+
+        std::size_t channels{1};
+        std::size_t repetitions{1};
+
+        /// Longest expected impulse response
+        quantity<isq::duration[si::second]> length{1.0 * si::second};
+
+        /// Kept before the direct sound
+        quantity<isq::duration[si::second]> preRoll{0.005 * si::second};
+
+        /// Highest harmonic kept clear of the previous channel's response
+        std::size_t harmonics{5};
+
+        std::size_t blockSize{8192};
+    };
+
+    explicit MultiSweep(Spec const& spec);
+
+    [[nodiscard]] auto spec() const noexcept -> Spec const&;
+
+    /// Samples between the sweeps of neighbouring channels
+    [[nodiscard]] auto spacing() const noexcept -> std::size_t;
+
+    /// Samples between repetitions
+    [[nodiscard]] auto period() const noexcept -> std::size_t;
+
+    /// First sample of a sweep
+    [[nodiscard]] auto start(std::size_t repetition, std::size_t channel) const noexcept -> std::size_t;
+
+    /// Samples to play & record, including the decay of the last sweep
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    /// Overwrites out with the excitation of one channel, starting at the
+    /// given sample of the schedule. Doesn't allocate.
+    auto render(std::size_t channel, std::size_t position, std::span<float> out) const -> void;
+
+    /// Impulse response of each channel, averaged over all repetitions
+    [[nodiscard]] auto deconvolve(std::span<float const> recording) const -> std::vector<std::vector<double>>;
+
+private:
+    Spec _spec;
+    ExponentialSweepSignal _signal;
+    std::size_t _preRoll{0};
+    std::size_t _length{0};
+    std::size_t _spacing{0};
+    std::size_t _period{0};
+};
+
+}  // namespace ra
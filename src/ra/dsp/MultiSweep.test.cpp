@@ -0,0 +1,78 @@
+#include "MultiSweep.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("RaumAkustik: MultiSweep", "")
+{
+    using ra::si::unit_symbols::Hz;
+    using ra::si::unit_symbols::ms;
+    using ra::si::unit_symbols::s;
+
+    auto const spec = ra::MultiSweep::Spec{
+        .sweep =
+            ra::ExponentialSweep{
+                .from       = 50.0 * Hz,
+                .to         = 3'000.0 * Hz,
+                .duration   = 0.5 * s,
+                .sampleRate = 8'000.0 * Hz,
+                .fadeIn     = 10.0 * ms,
+                .fadeOut    = 5.0 * ms,
+            },
+        .channels    = 3,
+        .repetitions = 2,
+        .length      = 50.0 * ms,
+        .preRoll     = 5.0 * ms,
+        .harmonics   = 3,
+        .blockSize   = 256,
+    };
+
+    auto const sweeps = ra::MultiSweep{spec};
+    REQUIRE(sweeps.spacing() > 440);
+    REQUIRE(sweeps.period() == std::max(3 * sweeps.spacing(), std::size_t(4'000)));
+    REQUIRE(sweeps.start(1, 2) == sweeps.period() + 2 * sweeps.spacing());
+
+    // Shorter than six sweeps with their decay one after another
+    REQUIRE(sweeps.size() < 6 * (4'000 + 440) * 3 / 4);
+
+    // Speaker c reaches the microphone after 20 * (c + 1) samples with a
+    // gain of 1 / (c + 1)
+    auto recording = std::vector<float>(sweeps.size());
+    auto block     = std::vector<float>(64);
+    for (auto channel{0UL}; channel < spec.channels; ++channel) {
+        auto const delay = 20 * (channel + 1);
+        auto const gain  = 1.0F / static_cast<float>(channel + 1);
+        for (auto position{0UL}; position < sweeps.size(); position += block.size()) {
+            sweeps.render(channel, position, block);
+            for (auto i{0UL}; i < block.size() and position + i + delay < recording.size(); ++i) {
+                recording[position + i + delay] += gain * block[i];
+            }
+        }
+    }
+
+    auto const responses = sweeps.deconvolve(recording);
+    REQUIRE(responses.size() == 3);
+
+    auto const reference = responses[0][40 + 20];
+    for (auto channel{0UL}; channel < spec.channels; ++channel) {
+        auto const& response = responses[channel];
+        REQUIRE(response.size() == 440);
+
+        auto const peak = std::max_element(response.begin(), response.end(), [](auto l, auto r) {
+            return std::abs(l) < std::abs(r);
+        });
+        REQUIRE(std::distance(response.begin(), peak) == static_cast<std::ptrdiff_t>(40 + 20 * (channel + 1)));
+        REQUIRE(*peak == Catch::Approx(reference / static_cast<double>(channel + 1)).epsilon(0.01));
+
+        // No crosstalk at the direct sound of the other channels
+        for (auto other{0UL}; other < spec.channels; ++other) {
+            if (other != channel) {
+                REQUIRE(std::abs(response[40 + 20 * (other + 1)]) < 0.05 * std::abs(*peak));
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#include "PartitionedConvolver.hpp"
+
+#include <neo/container/mdspan.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace ra {
+
+namespace {
+
+using RealVector    = stdex::mdspan<double, stdex::dextents<std::size_t, 1>>;
+using ComplexVector = stdex::mdspan<std::complex<double>, stdex::dextents<std::size_t, 1>>;
+
+}  // namespace
+
+PartitionedConvolver::PartitionedConvolver(std::span<float const> filter, std::size_t blockSize)
+    : _blockSize{std::bit_ceil(std::max(blockSize, std::size_t(2)))}
+    , _partitions{std::max((filter.size() + _blockSize - 1) / _blockSize, std::size_t(1))}
+    , _rfft{neo::fft::from_order, static_cast<std::size_t>(std::countr_zero(_blockSize * 2))}
+    , _filter(_partitions * bins())
+    , _delayLine(_partitions * bins())
+    , _window(_blockSize * 2)
+    , _time(_blockSize * 2)
+    , _accumulator(bins())
+{
+    // Each partition is zero padded to two blocks, the inverse transform is
+    // unscaled so the normalization is folded into the filter spectra
+    auto const scale = 1.0 / static_cast<double>(_blockSize * 2);
+    for (auto p{0UL}; p < _partitions; ++p) {
+        std::fill(_time.begin(), _time.end(), 0.0);
+
+        auto const first = std::min(p * _blockSize, filter.size());
+        auto const last  = std::min(first + _blockSize, filter.size());
+        auto const begin = std::next(filter.begin(), static_cast<std::ptrdiff_t>(first));
+        auto const end   = std::next(filter.begin(), static_cast<std::ptrdiff_t>(last));
+        std::transform(begin, end, _time.begin(), [scale](auto x) { return static_cast<double>(x) * scale; });
+
+        _rfft(RealVector{_time.data(), _time.size()}, ComplexVector{&_filter[p * bins()], bins()});
+    }
+}
+
+auto PartitionedConvolver::blockSize() const noexcept -> std::size_t { return _blockSize; }
+
+auto PartitionedConvolver::partitions() const noexcept -> std::size_t { return _partitions; }
+
+auto PartitionedConvolver::bins() const noexcept -> std::size_t { return _blockSize + 1; }
+
+auto PartitionedConvolver::reset() -> void
+{
+    std::fill(_delayLine.begin(), _delayLine.end(), std::complex<double>{});
+    std::fill(_window.begin(), _window.end(), 0.0);
+    _head = 0;
+}
+
+auto PartitionedConvolver::spectrum(std::span<double const> samples) -> std::span<std::complex<double> const>
+{
+    auto const count = std::min(samples.size(), _time.size());
+    std::copy_n(samples.begin(), count, _time.begin());
+    std::fill(std::next(_time.begin(), static_cast<std::ptrdiff_t>(count)), _time.end(), 0.0);
+
+    _rfft(RealVector{_time.data(), _time.size()}, ComplexVector{_accumulator.data(), _accumulator.size()});
+    return _accumulator;
+}
+
+auto PartitionedConvolver::operator()(std::span<float const> in, std::span<float> out) -> void
+{
+    // Slide the input window by one block and transform it into the newest
+    // slot of the delay line
+    auto const half = static_cast<std::ptrdiff_t>(_blockSize);
+    std::copy(std::next(_window.begin(), half), _window.end(), _window.begin());
+    std::transform(in.begin(), in.end(), std::next(_window.begin(), half), [](auto x) {
+        return static_cast<double>(x);
+    });
+
+    _head = (_head + _partitions - 1) % _partitions;
+    _rfft(RealVector{_window.data(), _window.size()}, ComplexVector{&_delayLine[_head * bins()], bins()});
+
+    std::fill(_accumulator.begin(), _accumulator.end(), std::complex<double>{});
+    for (auto p{0UL}; p < _partitions; ++p) {
+        auto const* x = &_delayLine[((_head + p) % _partitions) * bins()];
+        auto const* h = &_filter[p * bins()];
+        for (auto bin{0UL}; bin < bins(); ++bin) {
+            _accumulator[bin] += x[bin] * h[bin];
+        }
+    }
+
+    // The first half is circular aliasing, only the second half is valid
+    _rfft(ComplexVector{_accumulator.data(), _accumulator.size()}, RealVector{_time.data(), _time.size()});
+    std::transform(std::next(_time.begin(), half), _time.end(), out.begin(), [](auto x) {
+        return static_cast<float>(x);
+    });
+}
+
+}  // namespace ra
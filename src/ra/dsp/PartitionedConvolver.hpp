@@ -0,0 +1,54 @@
+#pragma once
+
+#include <neo/fft.hpp>
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Uniformly partitioned overlap-save convolution
+///
+/// The filter is split into partitions of one block each. Every block of
+/// input is transformed once and kept in a frequency-domain delay line,
+/// the output block is the product with all partition spectra summed in
+/// the frequency domain. Latency is one block, memory & work per block only
+/// depend on the filter length and not on the length of the input.
+struct PartitionedConvolver
+{
+    /// The block size is rounded up to a power of two
+    PartitionedConvolver(std::span<float const> filter, std::size_t blockSize);
+
+    [[nodiscard]] auto blockSize() const noexcept -> std::size_t;
+    [[nodiscard]] auto partitions() const noexcept -> std::size_t;
+
+    /// Input & output hold exactly one block
+    auto operator()(std::span<float const> in, std::span<float> out) -> void;
+
+    auto reset() -> void;
+
+    /// Unscaled transform of up to two blocks of samples, zero padded. Shares
+    /// the plan & scratch buffers of the convolution, the result stays valid
+    /// until the next call.
+    [[nodiscard]] auto spectrum(std::span<double const> samples) -> std::span<std::complex<double> const>;
+
+private:
+    [[nodiscard]] auto bins() const noexcept -> std::size_t;
+
+    std::size_t _blockSize;
+    std::size_t _partitions;
+    neo::fft::rfft_plan<double> _rfft;
+
+    // Partition & input spectra, stored back to back with bins() entries each
+    std::vector<std::complex<double>> _filter;
+    std::vector<std::complex<double>> _delayLine;
+    std::size_t _head{0};
+
+    std::vector<double> _window;
+    std::vector<double> _time;
+    std::vector<std::complex<double>> _accumulator;
+};
+
+}  // namespace ra
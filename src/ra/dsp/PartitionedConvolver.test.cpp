@@ -0,0 +1,44 @@
+#include "PartitionedConvolver.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("RaumAkustik: PartitionedConvolver", "")
+{
+    auto filter = std::vector<float>(100);
+    for (auto i{0UL}; i < filter.size(); ++i) {
+        filter[i] = std::sin(static_cast<float>(i) * 0.3F) / static_cast<float>(i + 1);
+    }
+
+    auto input = std::vector<float>(256);
+    for (auto i{0UL}; i < input.size(); ++i) {
+        input[i] = std::cos(static_cast<float>(i * i) * 0.01F);
+    }
+
+    auto convolver = ra::PartitionedConvolver{filter, 30};
+    REQUIRE(convolver.blockSize() == 32);
+    REQUIRE(convolver.partitions() == 4);
+
+    auto output = std::vector<float>(input.size());
+    for (auto i{0UL}; i < input.size(); i += convolver.blockSize()) {
+        convolver(std::span{input}.subspan(i, 32), std::span{output}.subspan(i, 32));
+    }
+
+    for (auto n{0UL}; n < output.size(); ++n) {
+        auto expected = 0.0;
+        for (auto k{0UL}; k < filter.size() and k <= n; ++k) {
+            expected += static_cast<double>(filter[k]) * static_cast<double>(input[n - k]);
+        }
+        REQUIRE(output[n] == Catch::Approx(expected).margin(1e-5));
+    }
+
+    convolver.reset();
+    auto silence = std::vector<float>(32);
+    convolver(silence, std::span{output}.subspan(0, 32));
+    for (auto i{0UL}; i < 32; ++i) {
+        REQUIRE(output[i] == Catch::Approx(0.0).margin(1e-9));
+    }
+}
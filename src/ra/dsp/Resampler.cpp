@@ -0,0 +1,96 @@
+#include "Resampler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace ra {
+
+namespace detail {
+
+auto besselI0(double x) -> double
+{
+    auto sum  = 1.0;
+    auto term = 1.0;
+    for (auto k{1}; k < 50; ++k) {
+        auto const f = x / (2.0 * static_cast<double>(k));
+        term *= f * f;
+        sum += term;
+        if (term < sum * 1e-16) {
+            break;
+        }
+    }
+    return sum;
+}
+
+}  // namespace detail
+
+Resampler::Resampler(Spec const& spec) : _spec{spec}
+{
+    assert(spec.inputRate > 0.0);
+    assert(spec.outputRate > 0.0);
+    assert(spec.phases > 0);
+
+    // Kaiser window with ~90 dB stopband
+    static constexpr auto beta = 9.0;
+
+    _ratio = spec.outputRate / spec.inputRate;
+
+    // Cutoff in cycles per input sample. When downsampling, the kernel is
+    // stretched so it band-limits to the output Nyquist.
+    _cutoff    = 0.5 * std::min(1.0, _ratio) * spec.bandwidth;
+    _halfWidth = static_cast<double>(spec.zeroCrossings) / (2.0 * _cutoff);
+
+    // One-sided table from t=0 to t=halfWidth, plus a guard point for the interpolation
+    auto const size = spec.zeroCrossings * spec.phases + 2U;
+    _table.resize(size);
+
+    auto const norm = detail::besselI0(beta);
+    for (auto i{0UL}; i < size; ++i) {
+        auto const x    = static_cast<double>(i) / static_cast<double>(spec.phases);  // in zero crossings
+        auto const t    = x / (2.0 * _cutoff);                                          // in input samples
+        auto const arg  = std::numbers::pi * x;
+        auto const sinc = i == 0 ? 1.0 : std::sin(arg) / arg;
+        auto const w    = t / _halfWidth;
+        auto const win  = w < 1.0 ? detail::besselI0(beta * std::sqrt(1.0 - w * w)) / norm : 0.0;
+        _table[i]       = 2.0 * _cutoff * sinc * win;
+    }
+}
+
+auto Resampler::ratio() const noexcept -> double { return _ratio; }
+
+auto Resampler::kernel(double t) const noexcept -> double
+{
+    auto const pos   = std::abs(t) * 2.0 * _cutoff * static_cast<double>(_spec.phases);
+    auto const index = static_cast<std::size_t>(pos);
+    if (index + 1U >= _table.size()) {
+        return 0.0;
+    }
+
+    auto const frac = pos - static_cast<double>(index);
+    return _table[index] + frac * (_table[index + 1U] - _table[index]);
+}
+
+auto Resampler::operator()(std::span<double const> in) const -> std::vector<double>
+{
+    auto const numOut = static_cast<std::size_t>(std::floor(static_cast<double>(in.size()) * _ratio));
+    auto out          = std::vector<double>(numOut);
+
+    auto const last = static_cast<std::ptrdiff_t>(in.size()) - 1;
+    for (auto n{0UL}; n < numOut; ++n) {
+        auto const t     = static_cast<double>(n) / _ratio;
+        auto const first = std::max(static_cast<std::ptrdiff_t>(std::ceil(t - _halfWidth)), std::ptrdiff_t(0));
+        auto const end   = std::min(static_cast<std::ptrdiff_t>(std::floor(t + _halfWidth)), last);
+
+        auto sum = 0.0;
+        for (auto i = first; i <= end; ++i) {
+            sum += in[static_cast<std::size_t>(i)] * kernel(t - static_cast<double>(i));
+        }
+        out[n] = sum;
+    }
+
+    return out;
+}
+
+}  // namespace ra
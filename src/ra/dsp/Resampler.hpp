@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Windowed-sinc resampler for arbitrary (also irrational) rate ratios.
+/// The kernel is tabulated at a fixed number of sub-sample phases and
+/// linearly interpolated between them, so the ratio does not have to be a
+/// fraction of small integers like the solver rate 1/dt.
+struct Resampler
+{
+    struct Spec
+    {
+        double inputRate{0.0};
+        double outputRate{0.0};
+
+        /// Zero crossings of the sinc on each side of the center
+        std::size_t zeroCrossings{32};
+
+        /// Kernel table resolution per zero crossing
+        std::size_t phases{256};
+
+        /// Cutoff relative to the lower of both Nyquist frequencies
+        double bandwidth{0.95};
+    };
+
+    explicit Resampler(Spec const& spec);
+
+    [[nodiscard]] auto ratio() const noexcept -> double;
+
+    /// Resamples a whole buffer, the output is delay compensated.
+    [[nodiscard]] auto operator()(std::span<double const> in) const -> std::vector<double>;
+
+private:
+    [[nodiscard]] auto kernel(double t) const noexcept -> double;
+
+    Spec _spec;
+    double _ratio{1.0};
+    double _cutoff{0.5};
+    double _halfWidth{0.0};
+    std::vector<double> _table;
+};
+
+}  // namespace ra
@@ -0,0 +1,34 @@
+#include "Resampler.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <numbers>
+
+TEST_CASE("RaumAkustik: Resampler", "")
+{
+    auto const check = [](double inputRate, double outputRate) {
+        auto const resampler = ra::Resampler{{.inputRate = inputRate, .outputRate = outputRate}};
+        REQUIRE(resampler.ratio() == Catch::Approx(outputRate / inputRate));
+
+        auto const freq = 1'000.0;
+        auto in         = std::vector<double>(static_cast<std::size_t>(inputRate * 0.1));
+        for (auto i{0UL}; i < in.size(); ++i) {
+            in[i] = std::sin(2.0 * std::numbers::pi * freq * static_cast<double>(i) / inputRate);
+        }
+
+        auto const out = resampler(in);
+        REQUIRE(out.size() == static_cast<std::size_t>(std::floor(static_cast<double>(in.size()) * resampler.ratio())));
+
+        // Skip the edges where the kernel runs out of input
+        for (auto i = out.size() / 4; i < out.size() * 3 / 4; ++i) {
+            auto const expected = std::sin(2.0 * std::numbers::pi * freq * static_cast<double>(i) / outputRate);
+            REQUIRE(out[i] == Catch::Approx(expected).margin(1e-3));
+        }
+    };
+
+    check(48'000.0, 44'100.0);
+    check(44'100.0, 48'000.0);
+    check(1.0 / (std::sqrt(0.5) * 343.0 / 2'000.0 / 6.0 / 343.0), 48'000.0);
+}
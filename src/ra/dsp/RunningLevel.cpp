@@ -0,0 +1,102 @@
+#include "RunningLevel.hpp"
+
+#include <xsimd/xsimd.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ra {
+
+namespace {
+
+struct Segment
+{
+    double removed{0.0};
+    double added{0.0};
+    float peak{0.0F};
+};
+
+/// Replaces the squares with the ones of the input and sums both
+[[nodiscard]] auto ingest(std::span<float const> in, std::span<float> squares) -> Segment
+{
+    using Batch = xsimd::batch<float>;
+
+    auto removed = Batch{0.0F};
+    auto added   = Batch{0.0F};
+    auto peak    = Batch{0.0F};
+
+    auto const vectorized = in.size() - in.size() % Batch::size;
+    for (auto i{0UL}; i < vectorized; i += Batch::size) {
+        auto const x   = Batch::load_unaligned(&in[i]);
+        auto const old = Batch::load_unaligned(&squares[i]);
+        auto const sq  = x * x;
+        sq.store_unaligned(&squares[i]);
+
+        removed += old;
+        added += sq;
+        peak = xsimd::max(peak, xsimd::abs(x));
+    }
+
+    auto segment = Segment{
+        .removed = static_cast<double>(xsimd::reduce_add(removed)),
+        .added   = static_cast<double>(xsimd::reduce_add(added)),
+        .peak    = xsimd::reduce_max(peak),
+    };
+
+    for (auto i{vectorized}; i < in.size(); ++i) {
+        segment.removed += static_cast<double>(squares[i]);
+        squares[i] = in[i] * in[i];
+        segment.added += static_cast<double>(squares[i]);
+        segment.peak = std::max(segment.peak, std::abs(in[i]));
+    }
+
+    return segment;
+}
+
+}  // namespace
+
+RunningLevel::RunningLevel(std::size_t window) : _squares(std::max(window, std::size_t(1)), 0.0F) {}
+
+auto RunningLevel::window() const noexcept -> std::size_t { return _squares.size(); }
+
+auto RunningLevel::peak() const noexcept -> float { return _peak; }
+
+auto RunningLevel::rms() const noexcept -> float
+{
+    return static_cast<float>(std::sqrt(std::max(_sum, 0.0) / static_cast<double>(_squares.size())));
+}
+
+auto RunningLevel::operator()(std::span<float const> block) -> void
+{
+    _peak = 0.0F;
+
+    while (not block.empty()) {
+        auto const count   = std::min(block.size(), _squares.size() - _head);
+        auto const segment = ingest(block.first(count), std::span{_squares}.subspan(_head, count));
+
+        _sum += segment.added - segment.removed;
+        _lap += segment.added;
+        _peak = std::max(_peak, segment.peak);
+
+        _head += count;
+        block = block.subspan(count);
+
+        // The ring now only holds squares of this lap
+        if (_head == _squares.size()) {
+            _head = 0;
+            _sum  = _lap;
+            _lap  = 0.0;
+        }
+    }
+}
+
+auto RunningLevel::reset() -> void
+{
+    std::fill(_squares.begin(), _squares.end(), 0.0F);
+    _head = 0;
+    _sum  = 0.0;
+    _lap  = 0.0;
+    _peak = 0.0F;
+}
+
+}  // namespace ra
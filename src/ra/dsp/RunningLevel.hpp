@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Peak & RMS of one channel over a sliding window
+///
+/// The squared samples are kept in a ring buffer next to their running sum,
+/// so the cost per sample doesn't depend on the window length. Alongside,
+/// the squares of the current lap are summed from zero, they replace the
+/// running sum every time the ring wraps around. Rounding errors of the
+/// add & subtract updates can't accumulate over more than one window.
+struct RunningLevel
+{
+    explicit RunningLevel(std::size_t window = 1);
+
+    [[nodiscard]] auto window() const noexcept -> std::size_t;
+
+    /// Absolute peak of the last block
+    [[nodiscard]] auto peak() const noexcept -> float;
+
+    /// RMS over the last window samples
+    [[nodiscard]] auto rms() const noexcept -> float;
+
+    /// Any number of samples, doesn't allocate
+    auto operator()(std::span<float const> block) -> void;
+
+    auto reset() -> void;
+
+private:
+    std::vector<float> _squares;
+    std::size_t _head{0};
+    double _sum{0.0};
+    double _lap{0.0};
+    float _peak{0.0F};
+};
+
+}  // namespace ra
@@ -0,0 +1,56 @@
+#include "RunningLevel.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("RaumAkustik: RunningLevel", "")
+{
+    auto signal = std::vector<float>(10'000);
+    for (auto i{0UL}; i < signal.size(); ++i) {
+        signal[i] = std::sin(static_cast<float>(i * i) * 0.001F) * (1.0F + static_cast<float>(i % 7) * 0.1F);
+    }
+
+    auto level = ra::RunningLevel{300};
+    REQUIRE(level.window() == 300);
+    REQUIRE(level.rms() == 0.0F);
+
+    // Odd block sizes, larger & smaller than the window
+    auto position = 0UL;
+    for (auto size : {1UL, 37UL, 5UL, 300UL, 301UL, 999UL, 64UL, 1UL, 2'000UL}) {
+        auto const block = std::span{signal}.subspan(position, size);
+        level(block);
+        position += size;
+
+        auto const first = position - std::min(position, level.window());
+        auto sum         = 0.0;
+        for (auto i{first}; i < position; ++i) {
+            sum += static_cast<double>(signal[i]) * static_cast<double>(signal[i]);
+        }
+
+        auto const peak = std::ranges::max(block, {}, [](auto x) { return std::abs(x); });
+        REQUIRE(level.peak() == std::abs(peak));
+        REQUIRE(level.rms() == Catch::Approx(std::sqrt(sum / 300.0)).epsilon(1e-5));
+    }
+
+    // No residue of the running sum after one window of silence
+    auto const silence = std::vector<float>(300);
+    level(silence);
+    REQUIRE(level.peak() == 0.0F);
+    REQUIRE(level.rms() == Catch::Approx(0.0).margin(1e-6));
+
+    // Rounding errors don't pile up over many laps
+    for (auto i{0UL}; i < 1'000; ++i) {
+        level(signal);
+    }
+    level(silence);
+    REQUIRE(level.rms() == Catch::Approx(0.0).margin(1e-6));
+
+    level(std::span{signal}.first(10));
+    level.reset();
+    REQUIRE(level.rms() == 0.0F);
+    REQUIRE(level.peak() == 0.0F);
+}
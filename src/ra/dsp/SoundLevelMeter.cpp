@@ -0,0 +1,241 @@
+#include "SoundLevelMeter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+namespace ra {
+
+namespace {
+
+/// Analog section (b2 s^2 + b1 s + b0) / (a2 s^2 + a1 s + a0)
+struct AnalogBiquad
+{
+    double b2{0.0};
+    double b1{0.0};
+    double b0{1.0};
+    double a2{0.0};
+    double a1{0.0};
+    double a0{1.0};
+};
+
+[[nodiscard]] auto bilinear(AnalogBiquad const& s, double sampleRate) -> BiquadCoefficients
+{
+    auto const k  = 2.0 * sampleRate;
+    auto const kk = k * k;
+    auto const a0 = s.a2 * kk + s.a1 * k + s.a0;
+
+    return {
+        .b0 = (s.b2 * kk + s.b1 * k + s.b0) / a0,
+        .b1 = 2.0 * (s.b0 - s.b2 * kk) / a0,
+        .b2 = (s.b2 * kk - s.b1 * k + s.b0) / a0,
+        .a1 = 2.0 * (s.a0 - s.a2 * kk) / a0,
+        .a2 = (s.a2 * kk - s.a1 * k + s.a0) / a0,
+    };
+}
+
+[[nodiscard]] auto toDecibels(double energy) -> double { return 10.0 * std::log10(std::max(energy, 1e-20)); }
+
+[[nodiscard]] auto toEnergy(double level) -> double { return std::pow(10.0, level / 10.0); }
+
+}  // namespace
+
+auto makeWeighting(FrequencyWeighting weighting, double sampleRate) -> std::vector<BiquadCoefficients>
+{
+    if (weighting == FrequencyWeighting::Z) {
+        return {BiquadCoefficients{}};
+    }
+
+    // Pole frequencies of IEC 61672-1 Annex E
+    auto const w1 = 2.0 * std::numbers::pi * 20.598997;
+    auto const w2 = 2.0 * std::numbers::pi * 107.65265;
+    auto const w3 = 2.0 * std::numbers::pi * 737.86223;
+    auto const w4 = 2.0 * std::numbers::pi * 12'194.217;
+
+    auto const highpass = AnalogBiquad{.b2 = 1.0, .b0 = 0.0, .a2 = 1.0, .a1 = 2.0 * w1, .a0 = w1 * w1};
+    auto const lowpass  = AnalogBiquad{.a2 = 1.0, .a1 = 2.0 * w4, .a0 = w4 * w4};
+    auto const midband  = AnalogBiquad{.b2 = 1.0, .b0 = 0.0, .a2 = 1.0, .a1 = w2 + w3, .a0 = w2 * w3};
+
+    auto sections = std::vector<BiquadCoefficients>{bilinear(highpass, sampleRate), bilinear(lowpass, sampleRate)};
+    if (weighting == FrequencyWeighting::A) {
+        sections.push_back(bilinear(midband, sampleRate));
+    }
+
+    auto const gain = std::transform_reduce(
+        sections.begin(),
+        sections.end(),
+        1.0,
+        std::multiplies{},
+        [sampleRate](auto const& section) { return magnitude(section, 1'000.0, sampleRate); }
+    );
+
+    sections.front().b0 /= gain;
+    sections.front().b1 /= gain;
+    sections.front().b2 /= gain;
+    return sections;
+}
+
+LevelHistory::LevelHistory(std::size_t capacity) : _entries(std::max(capacity, std::size_t(1))) {}
+
+auto LevelHistory::capacity() const noexcept -> std::size_t { return _entries.size(); }
+
+auto LevelHistory::written() const noexcept -> std::size_t { return _written.load(std::memory_order_acquire); }
+
+auto LevelHistory::push(float level) noexcept -> void
+{
+    auto const index = _written.load(std::memory_order_relaxed);
+    _entries[index % _entries.size()].store(level, std::memory_order_relaxed);
+    _written.store(index + 1, std::memory_order_release);
+}
+
+auto LevelHistory::latest(std::size_t count) const -> std::vector<float>
+{
+    auto const end   = written();
+    auto const first = end - std::min({count, end, _entries.size()});
+
+    auto levels = std::vector<float>{};
+    levels.reserve(end - first);
+    for (auto i{first}; i < end; ++i) {
+        levels.push_back(_entries[i % _entries.size()].load(std::memory_order_relaxed));
+    }
+    return levels;
+}
+
+SoundLevelMeter::SoundLevelMeter(Spec const& spec)
+    : _spec{spec}
+    , _history{static_cast<std::size_t>(std::lround((spec.history / spec.interval).numerical_value_in(one)))}
+    , _weighting{spec.weighting}
+{}
+
+auto SoundLevelMeter::prepare(quantity<isq::frequency[si::hertz]> sampleRate) -> void
+{
+    _sampleRate = sampleRate.numerical_value_in(si::hertz);
+
+    for (auto w : {FrequencyWeighting::A, FrequencyWeighting::C, FrequencyWeighting::Z}) {
+        auto& coefficients = _coefficients[static_cast<std::size_t>(w)];
+        std::fill(coefficients.begin(), coefficients.end(), BiquadCoefficients{});
+
+        auto const sections = makeWeighting(w, _sampleRate);
+        std::copy(sections.begin(), sections.end(), coefficients.begin());
+    }
+
+    _fastCoefficient = 1.0 - std::exp(-1.0 / (0.125 * _sampleRate));
+    _slowCoefficient = 1.0 - std::exp(-1.0 / (1.0 * _sampleRate));
+
+    auto const interval = std::lround(_spec.interval.numerical_value_in(si::second) * _sampleRate);
+    _intervalSize       = static_cast<std::size_t>(std::max(interval, 1L));
+
+    applyWeighting(_weighting.load());
+}
+
+auto SoundLevelMeter::operator()(std::span<float const> block) -> void
+{
+    if (_sampleRate <= 0.0) {
+        return;
+    }
+
+    if (auto const weighting = _weighting.load(std::memory_order_relaxed); weighting != _active) {
+        applyWeighting(weighting);
+    }
+
+    if (_restart.exchange(false)) {
+        _sum     = 0.0;
+        _count   = 0;
+        _fastMax = 0.0;
+    }
+
+    for (auto const sample : block) {
+        auto x = static_cast<double>(sample);
+        for (auto& section : _filter) {
+            x = section(x);
+        }
+
+        auto const energy = x * x;
+        _fast += (energy - _fast) * _fastCoefficient;
+        _slow += (energy - _slow) * _slowCoefficient;
+        _fastMax = std::max(_fastMax, _fast);
+        _sum += energy;
+        _intervalSum += energy;
+
+        if (++_intervalCount == _intervalSize) {
+            _history.push(static_cast<float>(toDecibels(_intervalSum / static_cast<double>(_intervalSize))));
+            _intervalSum   = 0.0;
+            _intervalCount = 0;
+        }
+    }
+    _count += block.size();
+
+    _fastLevel.store(toDecibels(_fast), std::memory_order_relaxed);
+    _slowLevel.store(toDecibels(_slow), std::memory_order_relaxed);
+    _fastMaxLevel.store(toDecibels(_fastMax), std::memory_order_relaxed);
+    _leqLevel.store(toDecibels(_count > 0 ? _sum / static_cast<double>(_count) : 0.0), std::memory_order_relaxed);
+}
+
+auto SoundLevelMeter::setWeighting(FrequencyWeighting weighting) noexcept -> void { _weighting.store(weighting); }
+
+auto SoundLevelMeter::weighting() const noexcept -> FrequencyWeighting { return _weighting.load(); }
+
+auto SoundLevelMeter::fast() const noexcept -> double { return _fastLevel.load() + calibration(); }
+
+auto SoundLevelMeter::slow() const noexcept -> double { return _slowLevel.load() + calibration(); }
+
+auto SoundLevelMeter::fastMax() const noexcept -> double { return _fastMaxLevel.load() + calibration(); }
+
+auto SoundLevelMeter::leq() const noexcept -> double { return _leqLevel.load() + calibration(); }
+
+auto SoundLevelMeter::leq(quantity<isq::duration[si::second]> duration) const -> double
+{
+    auto const levels = _history.latest(entries(duration));
+    if (levels.empty()) {
+        return toDecibels(0.0) + calibration();
+    }
+
+    auto const energy = std::transform_reduce(levels.begin(), levels.end(), 0.0, std::plus{}, [](auto level) {
+        return toEnergy(static_cast<double>(level));
+    });
+    return toDecibels(energy / static_cast<double>(levels.size())) + calibration();
+}
+
+auto SoundLevelMeter::history(quantity<isq::duration[si::second]> duration) const -> std::vector<double>
+{
+    auto const levels = _history.latest(entries(duration));
+    auto const offset = calibration();
+
+    auto result = std::vector<double>(levels.size());
+    std::transform(levels.begin(), levels.end(), result.begin(), [offset](auto level) {
+        return static_cast<double>(level) + offset;
+    });
+    return result;
+}
+
+auto SoundLevelMeter::restart() noexcept -> void { _restart.store(true); }
+
+auto SoundLevelMeter::calibrate(double reference) noexcept -> void { setCalibration(reference - _slowLevel.load()); }
+
+auto SoundLevelMeter::setCalibration(double offset) noexcept -> void { _offset.store(offset); }
+
+auto SoundLevelMeter::calibration() const noexcept -> double { return _offset.load(); }
+
+auto SoundLevelMeter::applyWeighting(FrequencyWeighting weighting) -> void
+{
+    auto const& coefficients = _coefficients[static_cast<std::size_t>(weighting)];
+    for (auto i{0UL}; i < maxSections; ++i) {
+        _filter[i] = Biquad<double>{coefficients[i]};
+    }
+
+    _active  = weighting;
+    _fast    = 0.0;
+    _slow    = 0.0;
+    _fastMax = 0.0;
+    _sum     = 0.0;
+    _count   = 0;
+}
+
+auto SoundLevelMeter::entries(quantity<isq::duration[si::second]> duration) const -> std::size_t
+{
+    auto const count = std::lround((duration / _spec.interval).numerical_value_in(one));
+    return static_cast<std::size_t>(std::max(count, 1L));
+}
+
+}  // namespace ra
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <ra/dsp/Biquad.hpp>
+#include <ra/unit/unit.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// IEC 61672-1 frequency weightings
+enum struct FrequencyWeighting
+{
+    A,
+    C,
+    Z,
+};
+
+/// Bilinear transform of the analog weighting filter, 0 dB at 1 kHz. Z is
+/// a single pass-through section.
+[[nodiscard]] auto makeWeighting(FrequencyWeighting weighting, double sampleRate) -> std::vector<BiquadCoefficients>;
+
+/// Fixed size ring of levels with a single writer
+///
+/// Readers on other threads get a consistent copy of the latest entries,
+/// as long as they don't ask for entries close to being overwritten.
+struct LevelHistory
+{
+    explicit LevelHistory(std::size_t capacity);
+
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+
+    /// Entries written so far, including the overwritten ones
+    [[nodiscard]] auto written() const noexcept -> std::size_t;
+
+    /// Writer only, doesn't allocate
+    auto push(float level) noexcept -> void;
+
+    /// Up to count latest entries, oldest first
+    [[nodiscard]] auto latest(std::size_t count) const -> std::vector<float>;
+
+private:
+    std::vector<std::atomic<float>> _entries;
+    std::atomic<std::size_t> _written{0};
+};
+
+/// Sound level meter with frequency & time weighting, IEC 61672-1
+///
+/// The audio thread runs the weighting filter, the fast & slow exponential
+/// detectors and the Leq integrator at a fixed cost per sample. Every
+/// interval the equivalent level is appended to the history. All levels
+/// can be read from any thread, they're in dB relative to a full scale
+/// square wave until the meter is calibrated.
+struct SoundLevelMeter
+{
+    struct Spec
+    {
+        FrequencyWeighting weighting{FrequencyWeighting::A};
+
+        /// Resolution of the history
+        quantity<isq::duration[si::second]> interval{0.1 * si::second};
+
+        /// 24 hours take about 3.5 MB at the default interval
+        quantity<isq::duration[si::second]> history{86'400.0 * si::second};
+    };
+
+    explicit SoundLevelMeter(Spec const& spec);
+
+    /// Not concurrently with operator(), keeps history & calibration
+    auto prepare(quantity<isq::frequency[si::hertz]> sampleRate) -> void;
+
+    /// Audio thread only, doesn't allocate
+    auto operator()(std::span<float const> block) -> void;
+
+    /// Applied on the next block, resets the detectors
+    auto setWeighting(FrequencyWeighting weighting) noexcept -> void;
+    [[nodiscard]] auto weighting() const noexcept -> FrequencyWeighting;
+
+    /// Time weighted levels, 125 ms & 1 s
+    [[nodiscard]] auto fast() const noexcept -> double;
+    [[nodiscard]] auto slow() const noexcept -> double;
+
+    /// Highest fast level since the last restart
+    [[nodiscard]] auto fastMax() const noexcept -> double;
+
+    /// Equivalent continuous level since the last restart
+    [[nodiscard]] auto leq() const noexcept -> double;
+
+    /// Equivalent level over the latest duration of the history
+    [[nodiscard]] auto leq(quantity<isq::duration[si::second]> duration) const -> double;
+
+    /// Latest levels of the history, oldest first
+    [[nodiscard]] auto history(quantity<isq::duration[si::second]> duration) const -> std::vector<double>;
+
+    /// Restarts Leq & the maximum on the next block
+    auto restart() noexcept -> void;
+
+    /// Offsets all levels so the current slow level reads as the reference,
+    /// e.g. 94 dB SPL of a calibrator
+    auto calibrate(double reference) noexcept -> void;
+    auto setCalibration(double offset) noexcept -> void;
+    [[nodiscard]] auto calibration() const noexcept -> double;
+
+private:
+    static constexpr auto maxSections = std::size_t{3};
+
+    auto applyWeighting(FrequencyWeighting weighting) -> void;
+    [[nodiscard]] auto entries(quantity<isq::duration[si::second]> duration) const -> std::size_t;
+
+    Spec _spec;
+    double _sampleRate{0.0};
+    LevelHistory _history;
+
+    // Precomputed for every weighting, switching doesn't allocate
+    std::array<std::array<BiquadCoefficients, maxSections>, 3> _coefficients;
+    std::array<Biquad<double>, maxSections> _filter;
+    FrequencyWeighting _active{FrequencyWeighting::A};
+
+    // Audio thread state, energies relative to full scale
+    double _fastCoefficient{0.0};
+    double _slowCoefficient{0.0};
+    double _fast{0.0};
+    double _slow{0.0};
+    double _fastMax{0.0};
+    double _sum{0.0};
+    std::size_t _count{0};
+    double _intervalSum{0.0};
+    std::size_t _intervalCount{0};
+    std::size_t _intervalSize{1};
+
+    // Published once per block
+    std::atomic<FrequencyWeighting> _weighting;
+    std::atomic<bool> _restart{false};
+    std::atomic<double> _offset{0.0};
+    std::atomic<double> _fastLevel{0.0};
+    std::atomic<double> _slowLevel{0.0};
+    std::atomic<double> _fastMaxLevel{0.0};
+    std::atomic<double> _leqLevel{0.0};
+};
+
+}  // namespace ra
@@ -0,0 +1,118 @@
+#include "SoundLevelMeter.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+auto weightingAt(ra::FrequencyWeighting weighting, double frequency) -> double
+{
+    auto gain = 1.0;
+    for (auto const& section : ra::makeWeighting(weighting, 48'000.0)) {
+        gain *= ra::magnitude(section, frequency, 48'000.0);
+    }
+    return 20.0 * std::log10(gain);
+}
+
+auto sine(double frequency, double amplitude, std::size_t size) -> std::vector<float>
+{
+    auto signal = std::vector<float>(size);
+    for (auto i{0UL}; i < size; ++i) {
+        auto const phase = 2.0 * std::numbers::pi * frequency * static_cast<double>(i) / 48'000.0;
+        signal[i]        = static_cast<float>(amplitude * std::sin(phase));
+    }
+    return signal;
+}
+
+}  // namespace
+
+TEST_CASE("RaumAkustik: FrequencyWeighting", "")
+{
+    using ra::FrequencyWeighting;
+
+    // IEC 61672-1 Table 3
+    REQUIRE(weightingAt(FrequencyWeighting::A, 63.0) == Catch::Approx(-26.2).margin(0.2));
+    REQUIRE(weightingAt(FrequencyWeighting::A, 125.0) == Catch::Approx(-16.1).margin(0.2));
+    REQUIRE(weightingAt(FrequencyWeighting::A, 250.0) == Catch::Approx(-8.6).margin(0.2));
+    REQUIRE(weightingAt(FrequencyWeighting::A, 500.0) == Catch::Approx(-3.2).margin(0.2));
+    REQUIRE(weightingAt(FrequencyWeighting::A, 1'000.0) == Catch::Approx(0.0).margin(1e-9));
+    REQUIRE(weightingAt(FrequencyWeighting::A, 2'000.0) == Catch::Approx(1.2).margin(0.2));
+    REQUIRE(weightingAt(FrequencyWeighting::A, 4'000.0) == Catch::Approx(1.0).margin(0.2));
+
+    REQUIRE(weightingAt(FrequencyWeighting::C, 31.5) == Catch::Approx(-3.0).margin(0.2));
+    REQUIRE(weightingAt(FrequencyWeighting::C, 63.0) == Catch::Approx(-0.8).margin(0.2));
+    REQUIRE(weightingAt(FrequencyWeighting::C, 1'000.0) == Catch::Approx(0.0).margin(1e-9));
+    REQUIRE(weightingAt(FrequencyWeighting::C, 4'000.0) == Catch::Approx(-0.8).margin(0.2));
+
+    REQUIRE(weightingAt(FrequencyWeighting::Z, 20.0) == Catch::Approx(0.0));
+    REQUIRE(weightingAt(FrequencyWeighting::Z, 20'000.0) == Catch::Approx(0.0));
+}
+
+TEST_CASE("RaumAkustik: LevelHistory", "")
+{
+    auto history = ra::LevelHistory{4};
+    REQUIRE(history.latest(10).empty());
+
+    for (auto i{0}; i < 6; ++i) {
+        history.push(static_cast<float>(i));
+    }
+
+    REQUIRE(history.written() == 6);
+    REQUIRE(history.latest(2) == std::vector<float>{4.0F, 5.0F});
+    REQUIRE(history.latest(10) == std::vector<float>{2.0F, 3.0F, 4.0F, 5.0F});
+}
+
+TEST_CASE("RaumAkustik: SoundLevelMeter", "")
+{
+    using ra::si::unit_symbols::s;
+
+    auto meter = ra::SoundLevelMeter{{.weighting = ra::FrequencyWeighting::A, .history = 10.0 * s}};
+    meter.prepare(48'000.0 * ra::si::hertz);
+
+    // Full scale sine at 1 kHz, -3 dB relative to a full scale square
+    auto const tone = sine(1'000.0, 1.0, 48'000 * 6);
+    for (auto i{0UL}; i < tone.size(); i += 480) {
+        meter(std::span{tone}.subspan(i, 480));
+    }
+
+    REQUIRE(meter.fast() == Catch::Approx(-3.01).margin(0.05));
+    REQUIRE(meter.slow() == Catch::Approx(-3.01).margin(0.05));
+    REQUIRE(meter.leq() == Catch::Approx(-3.01).margin(0.05));
+    REQUIRE(meter.leq(1.0 * s) == Catch::Approx(-3.01).margin(0.05));
+
+    // Calibrator reference
+    meter.calibrate(94.0);
+    REQUIRE(meter.slow() == Catch::Approx(94.0));
+    REQUIRE(meter.calibration() == Catch::Approx(97.01).margin(0.05));
+
+    auto const history = meter.history(2.0 * s);
+    REQUIRE(history.size() == 20);
+    for (auto level : history) {
+        REQUIRE(level == Catch::Approx(94.0).margin(0.05));
+    }
+
+    // 20 dB step down, the fast detector settles within a second while
+    // slow & Leq lag behind
+    meter.restart();
+    auto const quiet = sine(1'000.0, 0.1, 48'000);
+    meter(quiet);
+    REQUIRE(meter.fast() == Catch::Approx(74.0).margin(0.2));
+    REQUIRE(meter.slow() > 75.0);
+    REQUIRE(meter.leq() == Catch::Approx(74.0).margin(0.1));
+    REQUIRE(meter.fastMax() > 90.0);
+    REQUIRE(meter.leq(2.0 * s) == Catch::Approx(10.0 * std::log10((1.0 + 0.01) / 2.0) + 94.0).margin(0.1));
+
+    // Low frequencies are attenuated by A but not by C weighting
+    auto const low = sine(63.0, 1.0, 48'000 * 2);
+    meter.setWeighting(ra::FrequencyWeighting::C);
+    meter(low);
+    REQUIRE(meter.fast() == Catch::Approx(94.0 - 0.8).margin(0.2));
+
+    meter.setWeighting(ra::FrequencyWeighting::A);
+    meter(low);
+    REQUIRE(meter.fast() == Catch::Approx(94.0 - 26.2).margin(0.2));
+}
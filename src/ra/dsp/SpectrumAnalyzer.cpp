@@ -0,0 +1,161 @@
+#include "SpectrumAnalyzer.hpp"
+
+#include <neo/container/mdspan.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+namespace ra {
+
+auto makeWindow(WindowFunction function, std::size_t size) -> std::vector<double>
+{
+    auto window      = std::vector<double>(size, 1.0);
+    auto const twoPi = 2.0 * std::numbers::pi;
+
+    for (auto n{0UL}; n < size; ++n) {
+        auto const x = twoPi * static_cast<double>(n) / static_cast<double>(size);
+        switch (function) {
+            case WindowFunction::Rectangular: break;
+            case WindowFunction::Hann: window[n] = 0.5 - 0.5 * std::cos(x); break;
+            case WindowFunction::BlackmanHarris:
+                window[n] = 0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2.0 * x) - 0.01168 * std::cos(3.0 * x);
+                break;
+        }
+    }
+
+    return window;
+}
+
+OctaveSmoothing::OctaveSmoothing(std::size_t bins, double fraction)
+    : _fraction{fraction}
+    , _first(bins)
+    , _last(bins)
+    , _prefix(bins + 1)
+{
+    // Bin k covers [k / d, k * d] with d = 2^(1 / 2N)
+    auto const d = fraction > 0.0 ? std::pow(2.0, 1.0 / (2.0 * fraction)) : 1.0;
+    for (auto k{0UL}; k < bins; ++k) {
+        auto const center = static_cast<double>(k);
+        _first[k]         = std::min(static_cast<std::size_t>(std::ceil(center / d - 1e-9)), k);
+        _last[k]          = std::clamp(static_cast<std::size_t>(std::floor(center * d + 1e-9)), k, bins - 1);
+    }
+}
+
+auto OctaveSmoothing::bins() const noexcept -> std::size_t { return _first.size(); }
+
+auto OctaveSmoothing::fraction() const noexcept -> double { return _fraction; }
+
+auto OctaveSmoothing::operator()(std::span<double const> in, std::span<double> out) -> void
+{
+    auto const bins = std::min({in.size(), out.size(), _first.size()});
+
+    auto const values = in.first(bins);
+    if (_fraction <= 0.0) {
+        std::copy(values.begin(), values.end(), out.begin());
+        return;
+    }
+
+    _prefix[0] = 0.0;
+    std::partial_sum(values.begin(), values.end(), std::next(_prefix.begin()));
+
+    for (auto k{0UL}; k < bins; ++k) {
+        auto const first = _first[k];
+        auto const last  = _last[k];
+        out[k]           = (_prefix[last + 1] - _prefix[first]) / static_cast<double>(last - first + 1);
+    }
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer(Spec const& spec)
+    : _spec{spec}
+    , _fftSize{std::bit_ceil(std::max(spec.fftSize, std::size_t(2)))}
+    , _hopSize{static_cast<std::size_t>(
+          std::max(std::lround(static_cast<double>(_fftSize) * (1.0 - std::clamp(spec.overlap, 0.0, 0.99))), 1L)
+      )}
+    , _rfft{neo::fft::from_order, static_cast<std::size_t>(std::countr_zero(_fftSize))}
+    , _window{makeWindow(spec.window, _fftSize)}
+    , _ring(_fftSize)
+    , _time(_fftSize)
+    , _spectrum(bins())
+    , _power(bins())
+    , _peak(bins())
+{
+    auto const gain = std::reduce(_window.begin(), _window.end(), 0.0) / 2.0;
+    _scale          = 1.0 / (gain * gain);
+}
+
+auto SpectrumAnalyzer::fftSize() const noexcept -> std::size_t { return _fftSize; }
+
+auto SpectrumAnalyzer::hopSize() const noexcept -> std::size_t { return _hopSize; }
+
+auto SpectrumAnalyzer::bins() const noexcept -> std::size_t { return _fftSize / 2 + 1; }
+
+auto SpectrumAnalyzer::frames() const noexcept -> std::size_t { return _frames; }
+
+auto SpectrumAnalyzer::operator()(std::span<float const> samples) -> std::size_t
+{
+    auto analyzed = std::size_t{0};
+
+    while (not samples.empty()) {
+        auto const count = std::min({samples.size(), _hopSize - _pending, _fftSize - _head});
+        std::copy_n(samples.begin(), count, std::next(_ring.begin(), static_cast<std::ptrdiff_t>(_head)));
+
+        samples = samples.subspan(count);
+        _head   = (_head + count) % _fftSize;
+        _filled = std::min(_filled + count, _fftSize);
+        _pending += count;
+
+        if (_pending == _hopSize) {
+            _pending = 0;
+            if (_filled == _fftSize) {
+                analyzeFrame();
+                ++analyzed;
+            }
+        }
+    }
+
+    return analyzed;
+}
+
+auto SpectrumAnalyzer::power() const noexcept -> std::span<double const> { return _power; }
+
+auto SpectrumAnalyzer::peakHold() const noexcept -> std::span<double const> { return _peak; }
+
+auto SpectrumAnalyzer::resetPeakHold() -> void { std::copy(_power.begin(), _power.end(), _peak.begin()); }
+
+auto SpectrumAnalyzer::reset() -> void
+{
+    std::fill(_ring.begin(), _ring.end(), 0.0F);
+    std::fill(_power.begin(), _power.end(), 0.0);
+    std::fill(_peak.begin(), _peak.end(), 0.0);
+    _head    = 0;
+    _pending = 0;
+    _filled  = 0;
+    _frames  = 0;
+}
+
+auto SpectrumAnalyzer::analyzeFrame() -> void
+{
+    // The oldest sample sits at the head of the ring
+    for (auto i{0UL}; i < _fftSize; ++i) {
+        _time[i] = static_cast<double>(_ring[(_head + i) % _fftSize]) * _window[i];
+    }
+
+    _rfft(
+        stdex::mdspan<double, stdex::dextents<std::size_t, 1>>{_time.data(), _time.size()},
+        stdex::mdspan<std::complex<double>, stdex::dextents<std::size_t, 1>>{_spectrum.data(), _spectrum.size()}
+    );
+
+    auto const alpha = _frames == 0 ? 1.0 : std::clamp(_spec.averaging, 0.0, 1.0);
+    for (auto k{0UL}; k < _spectrum.size(); ++k) {
+        auto const power = std::norm(_spectrum[k]) * _scale;
+        _power[k] += alpha * (power - _power[k]);
+        _peak[k] = std::max(_peak[k], _power[k]);
+    }
+
+    ++_frames;
+}
+
+}  // namespace ra
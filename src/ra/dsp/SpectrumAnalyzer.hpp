@@ -0,0 +1,108 @@
+#pragma once
+
+#include <neo/fft.hpp>
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+enum struct WindowFunction
+{
+    Rectangular,
+    Hann,
+    BlackmanHarris,
+};
+
+/// Periodic window, for overlapped spectral analysis
+[[nodiscard]] auto makeWindow(WindowFunction function, std::size_t size) -> std::vector<double>;
+
+/// 1/N octave smoothing of a one-sided spectrum
+///
+/// Every bin is replaced by the mean over the bins within half a fraction
+/// of an octave around it. The bin ranges are tabulated up front & the
+/// means come from a prefix sum, so the cost is O(bins) for any fraction.
+struct OctaveSmoothing
+{
+    /// A fraction of 0 passes the spectrum through
+    OctaveSmoothing(std::size_t bins, double fraction);
+
+    [[nodiscard]] auto bins() const noexcept -> std::size_t;
+    [[nodiscard]] auto fraction() const noexcept -> double;
+
+    /// Doesn't allocate, in & out may be the same
+    auto operator()(std::span<double const> in, std::span<double> out) -> void;
+
+private:
+    double _fraction;
+    std::vector<std::size_t> _first;
+    std::vector<std::size_t> _last;
+    std::vector<double> _prefix;
+};
+
+/// Welch averaged power spectrum for real-time analyzers
+///
+/// Samples are collected in a ring of one FFT frame, every hop the frame is
+/// windowed & transformed. The power of each frame is folded into an
+/// exponential average and a peak hold. The power is scaled so a full
+/// scale sine centered on a bin reads 1.
+struct SpectrumAnalyzer
+{
+    struct Spec
+    {
+        /// Rounded up to a power of two
+        std::size_t fftSize{8192};
+
+        WindowFunction window{WindowFunction::Hann};
+
+        /// Fraction of a frame shared with the previous one, below 1
+        double overlap{0.5};
+
+        /// Weight of the newest frame, 1 only keeps the latest one
+        double averaging{0.25};
+    };
+
+    explicit SpectrumAnalyzer(Spec const& spec);
+
+    [[nodiscard]] auto fftSize() const noexcept -> std::size_t;
+    [[nodiscard]] auto hopSize() const noexcept -> std::size_t;
+    [[nodiscard]] auto bins() const noexcept -> std::size_t;
+
+    /// Frames analyzed since the last reset
+    [[nodiscard]] auto frames() const noexcept -> std::size_t;
+
+    /// Any number of samples, doesn't allocate. Returns the number of
+    /// frames analyzed.
+    auto operator()(std::span<float const> samples) -> std::size_t;
+
+    [[nodiscard]] auto power() const noexcept -> std::span<double const>;
+    [[nodiscard]] auto peakHold() const noexcept -> std::span<double const>;
+
+    auto resetPeakHold() -> void;
+    auto reset() -> void;
+
+private:
+    auto analyzeFrame() -> void;
+
+    Spec _spec;
+    std::size_t _fftSize;
+    std::size_t _hopSize;
+    neo::fft::rfft_plan<double> _rfft;
+    std::vector<double> _window;
+    double _scale{1.0};
+
+    std::vector<float> _ring;
+    std::size_t _head{0};
+    std::size_t _pending{0};
+    std::size_t _filled{0};
+    std::size_t _frames{0};
+
+    std::vector<double> _time;
+    std::vector<std::complex<double>> _spectrum;
+    std::vector<double> _power;
+    std::vector<double> _peak;
+};
+
+}  // namespace ra
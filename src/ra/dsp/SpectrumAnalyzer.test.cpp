@@ -0,0 +1,97 @@
+#include "SpectrumAnalyzer.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+TEST_CASE("RaumAkustik: OctaveSmoothing", "")
+{
+    auto rng    = std::mt19937{42};
+    auto dist   = std::uniform_real_distribution<double>{0.0, 1.0};
+    auto random = std::vector<double>(513);
+    std::generate(random.begin(), random.end(), [&] { return dist(rng); });
+
+    // Pass through
+    auto out = std::vector<double>(random.size());
+    ra::OctaveSmoothing{random.size(), 0.0}(random, out);
+    REQUIRE(out == random);
+
+    for (auto fraction : {1.0, 3.0, 6.0, 24.0}) {
+        auto smoothing = ra::OctaveSmoothing{random.size(), fraction};
+        REQUIRE(smoothing.bins() == 513);
+        smoothing(random, out);
+
+        // Same as scanning every band like the Python prototype
+        auto const d = std::pow(2.0, 1.0 / (2.0 * fraction));
+        for (auto k{1UL}; k < random.size(); ++k) {
+            auto sum   = 0.0;
+            auto count = 0;
+            for (auto i{0UL}; i < random.size(); ++i) {
+                auto const bin = static_cast<double>(i);
+                if (bin >= static_cast<double>(k) / d - 1e-9 and bin <= static_cast<double>(k) * d + 1e-9) {
+                    sum += random[i];
+                    ++count;
+                }
+            }
+            REQUIRE(out[k] == Catch::Approx(sum / count));
+        }
+    }
+
+    // In-place
+    auto constant = std::vector<double>(100, 2.0);
+    ra::OctaveSmoothing{constant.size(), 3.0}(constant, constant);
+    for (auto x : constant) {
+        REQUIRE(x == Catch::Approx(2.0));
+    }
+}
+
+TEST_CASE("RaumAkustik: SpectrumAnalyzer", "")
+{
+    auto analyzer = ra::SpectrumAnalyzer{{.fftSize = 200, .window = ra::WindowFunction::Hann, .overlap = 0.5}};
+    REQUIRE(analyzer.fftSize() == 256);
+    REQUIRE(analyzer.hopSize() == 128);
+    REQUIRE(analyzer.bins() == 129);
+
+    // Sine centered on bin 16 with half the full scale
+    auto signal = std::vector<float>(256 * 8);
+    for (auto i{0UL}; i < signal.size(); ++i) {
+        signal[i] = 0.5F * static_cast<float>(std::sin(2.0 * std::numbers::pi * 16.0 * static_cast<double>(i) / 256.0));
+    }
+
+    auto position = 0UL;
+    for (auto size : {100UL, 1UL, 300UL, 27UL, 1'000UL, 620UL}) {
+        analyzer(std::span{signal}.subspan(position, size));
+        position += size;
+
+        auto const expected = position < 256 ? 0 : (position - 256) / 128 + 1;
+        REQUIRE(analyzer.frames() == expected);
+    }
+
+    REQUIRE(analyzer.power()[16] == Catch::Approx(0.25).epsilon(1e-6));
+    REQUIRE(analyzer.power()[15] == Catch::Approx(0.25 / 4.0).epsilon(1e-6));
+    REQUIRE(analyzer.power()[40] < 1e-12);
+
+    // The average decays while the peak hold stays
+    auto const silence = std::vector<float>(256 * 4);
+    REQUIRE(analyzer(silence) == 8);
+    REQUIRE(analyzer.power()[16] < 0.25 * 0.2);
+    REQUIRE(analyzer.peakHold()[16] == Catch::Approx(0.25).epsilon(1e-6));
+
+    analyzer.resetPeakHold();
+    REQUIRE(analyzer.peakHold()[16] == analyzer.power()[16]);
+
+    analyzer.reset();
+    REQUIRE(analyzer.frames() == 0);
+    REQUIRE(analyzer.power()[16] == 0.0);
+
+    auto const rectangular = ra::makeWindow(ra::WindowFunction::Rectangular, 8);
+    REQUIRE(rectangular == std::vector<double>(8, 1.0));
+
+    auto const harris = ra::makeWindow(ra::WindowFunction::BlackmanHarris, 8);
+    REQUIRE(harris[0] == Catch::Approx(6e-5).margin(1e-5));
+    REQUIRE(harris[4] == Catch::Approx(1.0));
+}
@@ -0,0 +1,175 @@
+#include "TransferFunction.hpp"
+
+#include <neo/container/mdspan.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+
+namespace ra {
+
+namespace {
+
+using RealVector    = stdex::mdspan<double, stdex::dextents<std::size_t, 1>>;
+using ComplexVector = stdex::mdspan<std::complex<double>, stdex::dextents<std::size_t, 1>>;
+
+}  // namespace
+
+TransferFunction::TransferFunction(Spec const& spec)
+    : _spec{spec}
+    , _fftSize{std::bit_ceil(std::max(spec.fftSize, std::size_t(2)))}
+    , _hopSize{static_cast<std::size_t>(
+          std::max(std::lround(static_cast<double>(_fftSize) * (1.0 - std::clamp(spec.overlap, 0.0, 0.99))), 1L)
+      )}
+    , _rfft{neo::fft::from_order, static_cast<std::size_t>(std::countr_zero(_fftSize))}
+    , _window{makeWindow(spec.window, _fftSize)}
+    , _delayLine(_fftSize)
+    , _reference(_fftSize)
+    , _measurement(_fftSize)
+    , _time(_fftSize)
+    , _x(bins())
+    , _y(bins())
+    , _gxx(bins())
+    , _gyy(bins())
+    , _gxy(bins())
+    , _impulse(_fftSize)
+{
+    auto const gain = std::reduce(_window.begin(), _window.end(), 0.0) / 2.0;
+    _scale          = 1.0 / (gain * gain);
+}
+
+auto TransferFunction::fftSize() const noexcept -> std::size_t { return _fftSize; }
+
+auto TransferFunction::hopSize() const noexcept -> std::size_t { return _hopSize; }
+
+auto TransferFunction::bins() const noexcept -> std::size_t { return _fftSize / 2 + 1; }
+
+auto TransferFunction::frames() const noexcept -> std::size_t { return _frames; }
+
+auto TransferFunction::delay() const noexcept -> std::size_t { return _delay; }
+
+auto TransferFunction::setDelay(std::size_t samples) -> void
+{
+    _delay = std::min(samples, _fftSize - 1);
+
+    // The frame rings hold samples with the old alignment
+    std::fill(_gxx.begin(), _gxx.end(), 0.0);
+    std::fill(_gyy.begin(), _gyy.end(), 0.0);
+    std::fill(_gxy.begin(), _gxy.end(), std::complex<double>{});
+    _pending = 0;
+    _filled  = 0;
+    _frames  = 0;
+}
+
+auto TransferFunction::operator()(std::span<float const> reference, std::span<float const> measurement)
+    -> std::size_t
+{
+    auto const size = _fftSize;
+    auto analyzed   = std::size_t{0};
+
+    for (auto i{0UL}; i < std::min(reference.size(), measurement.size()); ++i) {
+        _delayLine[_delayHead] = reference[i];
+        _reference[_head]      = _delayLine[(_delayHead + size - _delay) % size];
+        _measurement[_head]    = measurement[i];
+
+        _delayHead = (_delayHead + 1) % size;
+        _head      = (_head + 1) % size;
+        _filled    = std::min(_filled + 1, size);
+
+        if (++_pending == _hopSize) {
+            _pending = 0;
+            if (_filled == size) {
+                analyzeFrame();
+                ++analyzed;
+            }
+        }
+    }
+
+    return analyzed;
+}
+
+auto TransferFunction::referencePower() const noexcept -> std::span<double const> { return _gxx; }
+
+auto TransferFunction::measurementPower() const noexcept -> std::span<double const> { return _gyy; }
+
+auto TransferFunction::crossSpectrum() const noexcept -> std::span<std::complex<double> const> { return _gxy; }
+
+auto TransferFunction::h1(std::span<std::complex<double>> out) const -> void
+{
+    for (auto k{0UL}; k < std::min(out.size(), bins()); ++k) {
+        out[k] = _gxx[k] > 0.0 ? _gxy[k] / _gxx[k] : std::complex<double>{};
+    }
+}
+
+auto TransferFunction::h2(std::span<std::complex<double>> out) const -> void
+{
+    for (auto k{0UL}; k < std::min(out.size(), bins()); ++k) {
+        auto const cross = std::conj(_gxy[k]);
+        out[k]           = std::norm(cross) > 0.0 ? _gyy[k] / cross : std::complex<double>{};
+    }
+}
+
+auto TransferFunction::coherence(std::span<double> out) const -> void
+{
+    for (auto k{0UL}; k < std::min(out.size(), bins()); ++k) {
+        auto const power = _gxx[k] * _gyy[k];
+        out[k]           = power > 0.0 ? std::min(std::norm(_gxy[k]) / power, 1.0) : 0.0;
+    }
+}
+
+auto TransferFunction::impulseResponse() -> std::span<double const>
+{
+    // The inverse transform is unscaled
+    h1(_x);
+    auto const scale = 1.0 / static_cast<double>(_fftSize);
+    std::transform(_x.begin(), _x.end(), _x.begin(), [scale](auto h) { return h * scale; });
+
+    _rfft(ComplexVector{_x.data(), _x.size()}, RealVector{_impulse.data(), _impulse.size()});
+    return _impulse;
+}
+
+auto TransferFunction::findDelay() -> std::ptrdiff_t
+{
+    auto const ir   = impulseResponse();
+    auto const peak = std::max_element(ir.begin(), ir.end(), [](auto l, auto r) { return std::abs(l) < std::abs(r); });
+
+    // The second half of the circular response is before the reference
+    auto const index = std::distance(ir.begin(), peak);
+    auto const size  = static_cast<std::ptrdiff_t>(_fftSize);
+    return index < size / 2 ? index : index - size;
+}
+
+auto TransferFunction::reset() -> void
+{
+    std::fill(_delayLine.begin(), _delayLine.end(), 0.0F);
+    _delayHead = 0;
+    setDelay(_delay);
+}
+
+auto TransferFunction::analyzeFrame() -> void
+{
+    // The oldest samples sit at the head of the rings
+    for (auto i{0UL}; i < _fftSize; ++i) {
+        _time[i] = static_cast<double>(_reference[(_head + i) % _fftSize]) * _window[i];
+    }
+    _rfft(RealVector{_time.data(), _time.size()}, ComplexVector{_x.data(), _x.size()});
+
+    for (auto i{0UL}; i < _fftSize; ++i) {
+        _time[i] = static_cast<double>(_measurement[(_head + i) % _fftSize]) * _window[i];
+    }
+    _rfft(RealVector{_time.data(), _time.size()}, ComplexVector{_y.data(), _y.size()});
+
+    auto const alpha = _frames == 0 ? 1.0 : std::clamp(_spec.averaging, 0.0, 1.0);
+    for (auto k{0UL}; k < bins(); ++k) {
+        auto const x = _x[k];
+        auto const y = _y[k];
+        _gxx[k] += alpha * (std::norm(x) * _scale - _gxx[k]);
+        _gyy[k] += alpha * (std::norm(y) * _scale - _gyy[k]);
+        _gxy[k] += alpha * (std::conj(x) * y * _scale - _gxy[k]);
+    }
+
+    ++_frames;
+}
+
+}  // namespace ra
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <ra/dsp/SpectrumAnalyzer.hpp>
+
+#include <neo/fft.hpp>
+
+#include <complex>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Dual channel FFT transfer function from a reference to a measurement
+///
+/// Both streams are windowed & transformed every hop. Their auto spectra
+/// and the cross spectrum are exponentially averaged, the H1 & H2
+/// estimates, the coherence and the impulse response are derived from the
+/// averages. Any broadband excitation works, so it runs while music or
+/// pink noise is playing.
+///
+/// The reference is delayed before the analysis to line it up with the
+/// measurement, otherwise the window only captures part of the correlation
+/// and the coherence drops.
+struct TransferFunction
+{
+    struct Spec
+    {
+        /// Rounded up to a power of two
+        std::size_t fftSize{32768};
+
+        WindowFunction window{WindowFunction::Hann};
+
+        /// Fraction of a frame shared with the previous one, below 1
+        double overlap{0.75};
+
+        /// Weight of the newest frame, 1 only keeps the latest one
+        double averaging{0.125};
+    };
+
+    explicit TransferFunction(Spec const& spec);
+
+    [[nodiscard]] auto fftSize() const noexcept -> std::size_t;
+    [[nodiscard]] auto hopSize() const noexcept -> std::size_t;
+    [[nodiscard]] auto bins() const noexcept -> std::size_t;
+
+    /// Frames analyzed since the last reset
+    [[nodiscard]] auto frames() const noexcept -> std::size_t;
+
+    /// Samples the reference is delayed by, below the FFT size
+    [[nodiscard]] auto delay() const noexcept -> std::size_t;
+
+    /// Restarts the averages
+    auto setDelay(std::size_t samples) -> void;
+
+    /// The same number of samples from both streams, doesn't allocate.
+    /// Returns the number of frames analyzed.
+    auto operator()(std::span<float const> reference, std::span<float const> measurement) -> std::size_t;
+
+    /// Averaged auto spectrum of the reference
+    [[nodiscard]] auto referencePower() const noexcept -> std::span<double const>;
+
+    /// Averaged auto spectrum of the measurement
+    [[nodiscard]] auto measurementPower() const noexcept -> std::span<double const>;
+
+    /// Averaged cross spectrum, conj(reference) * measurement
+    [[nodiscard]] auto crossSpectrum() const noexcept -> std::span<std::complex<double> const>;
+
+    /// Gxy / Gxx, unbiased by noise on the measurement
+    auto h1(std::span<std::complex<double>> out) const -> void;
+
+    /// Gyy / conj(Gxy), unbiased by noise on the reference
+    auto h2(std::span<std::complex<double>> out) const -> void;
+
+    /// |Gxy|^2 / (Gxx * Gyy), 1 where the measurement is fully explained by
+    /// the reference
+    auto coherence(std::span<double> out) const -> void;
+
+    /// Inverse transform of H1, circular over one frame. Doesn't allocate.
+    [[nodiscard]] auto impulseResponse() -> std::span<double const>;
+
+    /// Position of the impulse response peak relative to the current delay,
+    /// negative if the measurement leads. Add to delay() to line up both.
+    [[nodiscard]] auto findDelay() -> std::ptrdiff_t;
+
+    auto reset() -> void;
+
+private:
+    auto analyzeFrame() -> void;
+
+    Spec _spec;
+    std::size_t _fftSize;
+    std::size_t _hopSize;
+    neo::fft::rfft_plan<double> _rfft;
+    std::vector<double> _window;
+    double _scale{1.0};
+
+    std::vector<float> _delayLine;
+    std::size_t _delayHead{0};
+    std::size_t _delay{0};
+
+    std::vector<float> _reference;
+    std::vector<float> _measurement;
+    std::size_t _head{0};
+    std::size_t _pending{0};
+    std::size_t _filled{0};
+    std::size_t _frames{0};
+
+    std::vector<double> _time;
+    std::vector<std::complex<double>> _x;
+    std::vector<std::complex<double>> _y;
+    std::vector<double> _gxx;
+    std::vector<double> _gyy;
+    std::vector<std::complex<double>> _gxy;
+    std::vector<double> _impulse;
+};
+
+}  // namespace ra
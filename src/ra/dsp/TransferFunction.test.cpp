@@ -0,0 +1,155 @@
+#include "TransferFunction.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <complex>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+auto makeNoise(std::size_t size, unsigned seed) -> std::vector<float>
+{
+    auto rng   = std::mt19937{seed};
+    auto dist  = std::uniform_real_distribution<float>{-1.0F, 1.0F};
+    auto noise = std::vector<float>(size);
+    std::generate(noise.begin(), noise.end(), [&] { return dist(rng); });
+    return noise;
+}
+
+// Reference delayed by a number of samples & scaled
+auto makeMeasurement(std::vector<float> const& reference, std::ptrdiff_t delay, float gain) -> std::vector<float>
+{
+    auto measurement = std::vector<float>(reference.size());
+    for (auto i{0L}; i < static_cast<std::ptrdiff_t>(reference.size()); ++i) {
+        auto const n = i - delay;
+        if (n >= 0 and n < static_cast<std::ptrdiff_t>(reference.size())) {
+            measurement[static_cast<std::size_t>(i)] = reference[static_cast<std::size_t>(n)] * gain;
+        }
+    }
+    return measurement;
+}
+
+auto mean(std::vector<double> const& values) -> double
+{
+    return std::reduce(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+}
+
+}  // namespace
+
+TEST_CASE("RaumAkustik: TransferFunction", "")
+{
+    auto tf = ra::TransferFunction{{.fftSize = 200, .overlap = 0.75, .averaging = 0.1}};
+    REQUIRE(tf.fftSize() == 256);
+    REQUIRE(tf.hopSize() == 64);
+    REQUIRE(tf.bins() == 129);
+    REQUIRE(tf.delay() == 0);
+
+    auto const reference = makeNoise(256 * 32, 1);
+    auto h               = std::vector<std::complex<double>>(tf.bins());
+    auto coherence       = std::vector<double>(tf.bins());
+
+    SECTION("gain")
+    {
+        auto const measurement = makeMeasurement(reference, 0, 0.5F);
+
+        // Any block size
+        auto frames = std::size_t{0};
+        for (auto i{0UL}; i < reference.size(); i += 100) {
+            auto const count = std::min(std::size_t(100), reference.size() - i);
+            frames += tf(std::span{reference}.subspan(i, count), std::span{measurement}.subspan(i, count));
+        }
+        REQUIRE(frames == (reference.size() - 256) / 64 + 1);
+        REQUIRE(tf.frames() == frames);
+
+        tf.h1(h);
+        tf.coherence(coherence);
+        for (auto k{1UL}; k < tf.bins(); ++k) {
+            REQUIRE(std::abs(h[k]) == Catch::Approx(0.5).margin(1e-6));
+            REQUIRE(std::arg(h[k]) == Catch::Approx(0.0).margin(1e-6));
+            REQUIRE(coherence[k] == Catch::Approx(1.0).margin(1e-6));
+        }
+
+        tf.h2(h);
+        for (auto k{1UL}; k < tf.bins(); ++k) {
+            REQUIRE(std::abs(h[k]) == Catch::Approx(0.5).margin(1e-6));
+        }
+
+        auto const ir = tf.impulseResponse();
+        REQUIRE(ir.size() == 256);
+        REQUIRE(ir[0] == Catch::Approx(0.5).margin(1e-6));
+        REQUIRE(std::abs(ir[1]) < 1e-6);
+        REQUIRE(tf.findDelay() == 0);
+    }
+
+    SECTION("delay")
+    {
+        auto const measurement = makeMeasurement(reference, 32, 1.0F);
+        auto const half        = reference.size() / 2;
+        std::ignore            = tf(std::span{reference}.first(half), std::span{measurement}.first(half));
+
+        // The window only covers part of the correlation
+        tf.coherence(coherence);
+        REQUIRE(mean(coherence) < 0.9);
+        REQUIRE(tf.findDelay() == 32);
+
+        tf.setDelay(tf.delay() + 32);
+        REQUIRE(tf.delay() == 32);
+        REQUIRE(tf.frames() == 0);
+
+        std::ignore = tf(std::span{reference}.subspan(half), std::span{measurement}.subspan(half));
+        REQUIRE(tf.frames() > 0);
+
+        tf.h1(h);
+        tf.coherence(coherence);
+        for (auto k{1UL}; k < tf.bins(); ++k) {
+            REQUIRE(std::abs(h[k]) == Catch::Approx(1.0).margin(1e-6));
+            REQUIRE(std::arg(h[k]) == Catch::Approx(0.0).margin(1e-6));
+            REQUIRE(coherence[k] == Catch::Approx(1.0).margin(1e-6));
+        }
+        REQUIRE(tf.findDelay() == 0);
+    }
+
+    SECTION("measurement leads")
+    {
+        auto const measurement = makeMeasurement(reference, -5, 1.0F);
+        std::ignore            = tf(reference, measurement);
+        REQUIRE(tf.findDelay() == -5);
+    }
+
+    SECTION("noise")
+    {
+        // Uncorrelated noise on the measurement biases H2 up, H1 stays put
+        auto const noise = makeNoise(reference.size(), 2);
+        auto measurement = makeMeasurement(reference, 0, 0.5F);
+        for (auto i{0UL}; i < measurement.size(); ++i) {
+            measurement[i] += noise[i] * 0.5F;
+        }
+        std::ignore = tf(reference, measurement);
+
+        auto magnitude = std::vector<double>(tf.bins());
+        tf.h1(h);
+        std::transform(h.begin(), h.end(), magnitude.begin(), [](auto x) { return std::abs(x); });
+        auto const h1 = mean(magnitude);
+
+        tf.h2(h);
+        std::transform(h.begin(), h.end(), magnitude.begin(), [](auto x) { return std::abs(x); });
+        auto const h2 = mean(magnitude);
+
+        REQUIRE(h1 == Catch::Approx(0.5).margin(0.05));
+        REQUIRE(h2 > h1 * 1.5);
+
+        tf.coherence(coherence);
+        REQUIRE(mean(coherence) == Catch::Approx(0.5).margin(0.15));
+
+        // Unrelated streams
+        tf.reset();
+        std::ignore = tf(reference, noise);
+        tf.coherence(coherence);
+        REQUIRE(mean(coherence) < 0.2);
+    }
+}
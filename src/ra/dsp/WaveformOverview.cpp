@@ -0,0 +1,172 @@
+#include "WaveformOverview.hpp"
+
+#include <ra/dsp/LatestRing.hpp>
+
+#include <xsimd/xsimd.hpp>
+
+#include <algorithm>
+
+namespace ra {
+
+namespace {
+
+[[nodiscard]] auto merge(PeakPair lhs, PeakPair rhs) noexcept -> PeakPair
+{
+    return PeakPair{.min = std::min(lhs.min, rhs.min), .max = std::max(lhs.max, rhs.max)};
+}
+
+[[nodiscard]] auto minMax(std::span<float const> samples) -> PeakPair
+{
+    using Batch = xsimd::batch<float>;
+
+    auto pair = PeakPair{.min = samples[0], .max = samples[0]};
+
+    auto const vectorized = samples.size() - samples.size() % Batch::size;
+    if (vectorized > 0) {
+        auto low  = Batch::load_unaligned(samples.data());
+        auto high = low;
+        for (auto i{Batch::size}; i < vectorized; i += Batch::size) {
+            auto const x = Batch::load_unaligned(&samples[i]);
+            low          = xsimd::min(low, x);
+            high         = xsimd::max(high, x);
+        }
+        pair = PeakPair{.min = xsimd::reduce_min(low), .max = xsimd::reduce_max(high)};
+    }
+
+    for (auto i{vectorized}; i < samples.size(); ++i) {
+        pair = merge(pair, PeakPair{.min = samples[i], .max = samples[i]});
+    }
+
+    return pair;
+}
+
+/// out += in
+auto accumulate(std::span<float const> in, std::span<float> out) -> void
+{
+    using Batch = xsimd::batch<float>;
+
+    auto const vectorized = in.size() - in.size() % Batch::size;
+    for (auto i{0UL}; i < vectorized; i += Batch::size) {
+        auto const sum = Batch::load_unaligned(&out[i]) + Batch::load_unaligned(&in[i]);
+        sum.store_unaligned(&out[i]);
+    }
+
+    for (auto i{vectorized}; i < in.size(); ++i) {
+        out[i] += in[i];
+    }
+}
+
+}  // namespace
+
+WaveformOverview::WaveformOverview(Spec const& spec)
+    : _spec{
+          .decimation = std::max(spec.decimation, std::size_t(1)),
+          .factor     = std::max(spec.factor, std::size_t(2)),
+          .levels     = std::max(spec.levels, std::size_t(1)),
+          .capacity   = std::max(spec.capacity, std::size_t(1)),
+      }
+    , _pairs(_spec.levels * _spec.capacity)
+    , _written(_spec.levels)
+    , _pending(_spec.levels)
+    , _count(_spec.levels)
+{}
+
+auto WaveformOverview::levels() const noexcept -> std::size_t { return _spec.levels; }
+
+auto WaveformOverview::capacity() const noexcept -> std::size_t { return _spec.capacity; }
+
+auto WaveformOverview::samplesPerPair(std::size_t level) const noexcept -> std::size_t
+{
+    auto samples = _spec.decimation;
+    for (auto i{0UL}; i < level; ++i) {
+        samples *= _spec.factor;
+    }
+    return samples;
+}
+
+auto WaveformOverview::operator()(std::span<float const* const> channels, std::size_t numSamples) -> void
+{
+    for (auto offset{0UL}; offset < numSamples; offset += _sum.size()) {
+        auto const count = std::min(_sum.size(), numSamples - offset);
+        auto const sum   = std::span{_sum}.first(count);
+        std::fill(sum.begin(), sum.end(), 0.0F);
+
+        for (auto const* channel : channels) {
+            if (channel != nullptr) {
+                accumulate({std::next(channel, static_cast<std::ptrdiff_t>(offset)), count}, sum);
+            }
+        }
+
+        ingest(sum);
+    }
+}
+
+auto WaveformOverview::operator()(std::span<float const> samples) -> void { ingest(samples); }
+
+auto WaveformOverview::written(std::size_t level) const noexcept -> std::size_t
+{
+    return _written[level].load(std::memory_order_acquire);
+}
+
+auto WaveformOverview::latest(std::size_t level, std::span<PeakPair> out) const -> std::size_t
+{
+    auto const capacity = _spec.capacity;
+    auto const* pairs   = &_pairs[level * capacity];
+
+    return copyLatest(
+        out,
+        capacity,
+        [this, level] { return written(level); },
+        [pairs](std::size_t index) { return pairs[index].load(std::memory_order_relaxed); }
+    );
+}
+
+auto WaveformOverview::reset() -> void
+{
+    for (auto& pair : _pairs) {
+        pair.store(PeakPair{}, std::memory_order_relaxed);
+    }
+    for (auto& written : _written) {
+        written.store(0, std::memory_order_release);
+    }
+    std::fill(_pending.begin(), _pending.end(), PeakPair{});
+    std::fill(_count.begin(), _count.end(), std::size_t(0));
+}
+
+auto WaveformOverview::ingest(std::span<float const> samples) -> void
+{
+    while (not samples.empty()) {
+        auto const count = std::min(samples.size(), _spec.decimation - _count[0]);
+        auto const pair  = minMax(samples.first(count));
+
+        _pending[0] = _count[0] == 0 ? pair : merge(_pending[0], pair);
+        _count[0] += count;
+        samples = samples.subspan(count);
+
+        if (_count[0] == _spec.decimation) {
+            _count[0] = 0;
+            push(0, _pending[0]);
+        }
+    }
+}
+
+auto WaveformOverview::push(std::size_t level, PeakPair pair) -> void
+{
+    auto& written = _written[level];
+    auto const n  = written.load(std::memory_order_relaxed);
+    _pairs[level * _spec.capacity + n % _spec.capacity].store(pair, std::memory_order_relaxed);
+    written.store(n + 1, std::memory_order_release);
+
+    auto const next = level + 1;
+    if (next == _spec.levels) {
+        return;
+    }
+
+    _pending[next] = _count[next] == 0 ? pair : merge(_pending[next], pair);
+    if (++_count[next] == _spec.factor) {
+        _count[next] = 0;
+        push(next, _pending[next]);
+    }
+}
+
+}  // namespace ra
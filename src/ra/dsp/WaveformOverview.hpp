@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+struct PeakPair
+{
+    float min{0.0F};
+    float max{0.0F};
+};
+
+/// Min/max overview of a stream at several resolutions
+///
+/// The first level holds one pair per decimation samples, every further
+/// level merges factor pairs of the level below, like the mip-maps of a
+/// texture. Each level is a ring of the same capacity, so zooming out only
+/// reads a coarser level instead of rescanning the audio.
+///
+/// One thread writes whole blocks without allocating or locking, any
+/// number of threads may read the latest pairs at the same time.
+struct WaveformOverview
+{
+    struct Spec
+    {
+        /// Samples per pair on the first level
+        std::size_t decimation{64};
+
+        /// Pairs of a level merged into one pair of the next
+        std::size_t factor{8};
+
+        std::size_t levels{5};
+
+        /// Pairs kept per level
+        std::size_t capacity{4096};
+    };
+
+    explicit WaveformOverview(Spec const& spec);
+
+    [[nodiscard]] auto levels() const noexcept -> std::size_t;
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+    [[nodiscard]] auto samplesPerPair(std::size_t level) const noexcept -> std::size_t;
+
+    /// Writer only, the sum of all channels. Null channels are skipped.
+    auto operator()(std::span<float const* const> channels, std::size_t numSamples) -> void;
+
+    /// Writer only
+    auto operator()(std::span<float const> samples) -> void;
+
+    /// Pairs written to the level so far, including the overwritten ones
+    [[nodiscard]] auto written(std::size_t level) const noexcept -> std::size_t;
+
+    /// Copies up to out.size() latest pairs of the level, oldest first.
+    /// Returns the number of pairs copied, below the capacity since the
+    /// writer may be overwriting the oldest one.
+    [[nodiscard]] auto latest(std::size_t level, std::span<PeakPair> out) const -> std::size_t;
+
+    /// Not safe while the writer is running
+    auto reset() -> void;
+
+private:
+    auto ingest(std::span<float const> samples) -> void;
+    auto push(std::size_t level, PeakPair pair) -> void;
+
+    Spec _spec;
+
+    // Level after level, capacity pairs each
+    std::vector<std::atomic<PeakPair>> _pairs;
+    std::vector<std::atomic<std::size_t>> _written;
+
+    // Writer only, the pair being merged on every level
+    std::vector<PeakPair> _pending;
+    std::vector<std::size_t> _count;
+
+    // The channels are summed in chunks of this size
+    std::array<float, 512> _sum{};
+};
+
+}  // namespace ra
@@ -0,0 +1,74 @@
+#include "WaveformOverview.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+TEST_CASE("RaumAkustik: WaveformOverview", "")
+{
+    auto overview = ra::WaveformOverview{{.decimation = 10, .factor = 4, .levels = 3, .capacity = 64}};
+    REQUIRE(overview.levels() == 3);
+    REQUIRE(overview.capacity() == 64);
+    REQUIRE(overview.samplesPerPair(0) == 10);
+    REQUIRE(overview.samplesPerPair(1) == 40);
+    REQUIRE(overview.samplesPerPair(2) == 160);
+
+    auto rng   = std::mt19937{42};
+    auto dist  = std::uniform_real_distribution<float>{-1.0F, 1.0F};
+    auto left  = std::vector<float>(1600);
+    auto right = std::vector<float>(left.size());
+    std::generate(left.begin(), left.end(), [&] { return dist(rng); });
+    std::generate(right.begin(), right.end(), [&] { return dist(rng); });
+
+    // Blocks not aligned to the decimation, one channel missing
+    auto const channels = std::array<float const*, 3>{left.data(), nullptr, right.data()};
+    for (auto offset{0UL}; offset < left.size(); offset += 37) {
+        auto const count = std::min(std::size_t(37), left.size() - offset);
+        auto block       = std::array<float const*, 3>{};
+        std::transform(channels.begin(), channels.end(), block.begin(), [offset](auto const* channel) {
+            return channel == nullptr ? channel : std::next(channel, static_cast<std::ptrdiff_t>(offset));
+        });
+        overview(block, count);
+    }
+
+    auto sum = std::vector<float>(left.size());
+    std::transform(left.begin(), left.end(), right.begin(), sum.begin(), std::plus{});
+
+    for (auto level{0UL}; level < overview.levels(); ++level) {
+        auto const samples = overview.samplesPerPair(level);
+        REQUIRE(overview.written(level) == sum.size() / samples);
+
+        // Rings that wrapped keep the latest pairs
+        auto pairs       = std::vector<ra::PeakPair>(100);
+        auto const count = overview.latest(level, pairs);
+        REQUIRE(count == std::min(overview.written(level), overview.capacity() - 1));
+
+        auto const oldest = overview.written(level) - count;
+        for (auto i{0UL}; i < count; ++i) {
+            auto const index = (oldest + i) * samples;
+            auto const first = std::next(sum.begin(), static_cast<std::ptrdiff_t>(index));
+            auto const [min, max] = std::minmax_element(first, std::next(first, static_cast<std::ptrdiff_t>(samples)));
+            REQUIRE(pairs[i].min == Catch::Approx(*min));
+            REQUIRE(pairs[i].max == Catch::Approx(*max));
+        }
+    }
+
+    auto pairs = std::vector<ra::PeakPair>(100);
+
+    // Fewer requested than written
+    REQUIRE(overview.latest(0, std::span{pairs}.first(5)) == 5);
+
+    overview.reset();
+    REQUIRE(overview.written(0) == 0);
+    REQUIRE(overview.latest(0, pairs) == 0);
+
+    overview(std::vector<float>(10, 0.5F));
+    REQUIRE(overview.written(0) == 1);
+    REQUIRE(overview.latest(0, pairs) == 1);
+    REQUIRE(pairs[0].min == Catch::Approx(0.5F));
+    REQUIRE(pairs[0].max == Catch::Approx(0.5F));
+}
@@ -0,0 +1,143 @@
+#include "ExponentialSweep.hpp"
+
+#include <xsimd/xsimd.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <span>
+
+namespace ra {
+
+namespace {
+
+/// Magnitude of a single DFT bin, Goertzel's recurrence needs no trig per sample
+[[nodiscard]] auto binMagnitude(std::span<float const> x, double w) -> double
+{
+    auto const coeff = 2.0 * std::cos(w);
+    auto s1          = 0.0;
+    auto s2          = 0.0;
+    for (auto const sample : x) {
+        auto const s0 = static_cast<double>(sample) + coeff * s1 - s2;
+        s2            = s1;
+        s1            = s0;
+    }
+    return std::hypot(s1 - s2 * std::cos(w), s2 * std::sin(w));
+}
+
+}  // namespace
+
+auto sweepRate(ExponentialSweep const& spec) -> quantity<isq::duration[si::second]>
+{
+    auto const ratio = (spec.to / spec.from).numerical_value_in(one);
+    return spec.duration / std::log(ratio);
+}
+
+auto generate(ExponentialSweep const& spec) -> ExponentialSweepSignal
+{
+    using Batch = xsimd::batch<double>;
+
+    auto const fs         = spec.sampleRate.numerical_value_in(si::hertz);
+    auto const f1         = spec.from.numerical_value_in(si::hertz);
+    auto const rate       = sweepRate(spec).numerical_value_in(si::second);
+    auto const numSamples = static_cast<std::size_t>((spec.duration * spec.sampleRate).numerical_value_in(one));
+    if (numSamples == 0) {
+        return {};
+    }
+
+    // phase[n] = K * (g[n] - 1) with g[n] = exp(n / (fs * L)) = r^n. The
+    // growth is advanced one register at a time and re-anchored with an
+    // exact exp every few blocks, so rounding errors can't accumulate into
+    // the phase.
+    static constexpr auto anchorInterval = std::size_t{1024};
+    static_assert(anchorInterval % Batch::size == 0);
+
+    auto const k     = 2.0 * std::numbers::pi * f1 * rate;
+    auto const r     = std::exp(1.0 / (fs * rate));
+    auto const gEnd  = std::exp(static_cast<double>(numSamples - 1) / (fs * rate));
+    auto const block = std::pow(r, static_cast<double>(Batch::size));
+
+    auto lanes = std::array<double, Batch::size>{};
+    for (auto i{0UL}; i < Batch::size; ++i) {
+        lanes[i] = std::pow(r, static_cast<double>(i));
+    }
+    auto const laneGrowth = Batch::load_unaligned(lanes.data());
+
+    auto signal = ExponentialSweepSignal{
+        .sweep   = std::vector<float>(numSamples),
+        .inverse = std::vector<float>(numSamples),
+    };
+
+    // The inverse is the reversed sweep scaled with exp(-t' / L), which at
+    // reversed time t' = T - t equals g[n] / g[N - 1]
+    auto const store = [&](std::size_t n, double x, double g) {
+        signal.sweep[n]                    = static_cast<float>(x);
+        signal.inverse[numSamples - 1 - n] = static_cast<float>(x * g / gEnd);
+    };
+
+    // Rising half of a Hann window
+    auto const fade = [](std::size_t index, std::size_t count) {
+        auto const t = (static_cast<double>(index) + 0.5) / static_cast<double>(count);
+        return 0.5 - 0.5 * std::cos(std::numbers::pi * t);
+    };
+
+    auto const samples = [&](auto duration) {
+        return std::min(static_cast<std::size_t>(duration.numerical_value_in(si::second) * fs), numSamples);
+    };
+
+    auto const vectorized = numSamples - numSamples % Batch::size;
+    auto growth           = 1.0;
+    auto growths          = std::array<double, Batch::size>{};
+    auto values           = std::array<double, Batch::size>{};
+    for (auto n{0UL}; n < vectorized; n += Batch::size) {
+        if (n % anchorInterval == 0) {
+            growth = std::exp(static_cast<double>(n) / (fs * rate));
+        }
+
+        auto const g     = Batch(growth) * laneGrowth;
+        auto const phase = Batch(k) * (g - Batch(1.0));
+        xsimd::sin(phase).store_unaligned(values.data());
+        g.store_unaligned(growths.data());
+
+        for (auto i{0UL}; i < Batch::size; ++i) {
+            store(n + i, values[i], growths[i]);
+        }
+
+        growth *= block;
+    }
+
+    for (auto n{vectorized}; n < numSamples; ++n) {
+        auto const g = std::exp(static_cast<double>(n) / (fs * rate));
+        store(n, std::sin(k * (g - 1.0)), g);
+    }
+
+    // Only the ends are faded, the loops above stay branch-free. The inverse
+    // is the scaled reverse, so it's faded at the mirrored positions.
+    auto const applyFade = [&](std::size_t n, double g) {
+        signal.sweep[n] *= static_cast<float>(g);
+        signal.inverse[numSamples - 1 - n] *= static_cast<float>(g);
+    };
+
+    auto const fadeIn  = samples(spec.fadeIn);
+    auto const fadeOut = samples(spec.fadeOut);
+    for (auto n{0UL}; n < fadeIn; ++n) {
+        applyFade(n, fade(n, fadeIn));
+    }
+    for (auto n{numSamples - fadeOut}; n < numSamples; ++n) {
+        applyFade(n, fade(numSamples - 1 - n, fadeOut));
+    }
+
+    // Unity gain at the geometric center of the sweep range, the product of
+    // both spectra is flat in between
+    auto const center = std::sqrt(f1 * spec.to.numerical_value_in(si::hertz));
+    auto const w      = 2.0 * std::numbers::pi * center / fs;
+    auto const scale  = static_cast<float>(1.0 / (binMagnitude(signal.sweep, w) * binMagnitude(signal.inverse, w)));
+    std::transform(signal.inverse.begin(), signal.inverse.end(), signal.inverse.begin(), [scale](auto x) {
+        return x * scale;
+    });
+
+    return signal;
+}
+
+}  // namespace ra
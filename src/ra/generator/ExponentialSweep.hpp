@@ -0,0 +1,45 @@
+#pragma once
+
+#include <mp-units/systems/isq.h>
+#include <mp-units/systems/si.h>
+
+#include <vector>
+
+namespace ra {
+
+using namespace mp_units;
+
+/// Exponential sine sweep, Farina (2000)
+///
+/// x(t) = sin(2 * π * f1 * L * (exp(t / L) - 1)),  L = T / ln(f2 / f1)
+///
+/// The instantaneous frequency f1 * exp(t / L) rises by the same number of
+/// octaves per second over the whole sweep.
+struct ExponentialSweep
+{
+    quantity<isq::frequency[si::hertz]> from{20.0 * si::hertz};
+    quantity<isq::frequency[si::hertz]> to{20'000.0 * si::hertz};
+    quantity<isq::duration[si::second]> duration{1.0 * si::second};
+    quantity<isq::frequency[si::hertz]> sampleRate{44'100.0 * si::hertz};
+
+    /// Raised cosine fades against clicks at both ends
+    quantity<isq::duration[si::second]> fadeIn{0.0 * si::second};
+    quantity<isq::duration[si::second]> fadeOut{0.0 * si::second};
+};
+
+struct ExponentialSweepSignal
+{
+    std::vector<float> sweep;
+
+    /// Time reversed sweep with a +6 dB/octave envelope. Convolving a
+    /// recording of the sweep with it yields the impulse response, scaled to
+    /// unity gain inside the sweep range.
+    std::vector<float> inverse;
+};
+
+/// Sweep rate L in seconds, the time the sweep needs to rise by a factor of e
+[[nodiscard]] auto sweepRate(ExponentialSweep const& spec) -> quantity<isq::duration[si::second]>;
+
+[[nodiscard]] auto generate(ExponentialSweep const& spec) -> ExponentialSweepSignal;
+
+}  // namespace ra
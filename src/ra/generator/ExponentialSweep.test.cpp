@@ -0,0 +1,98 @@
+#include "ExponentialSweep.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+auto magnitudeAt(std::vector<double> const& x, double frequency, double fs) -> double
+{
+    auto bin = std::complex<double>{};
+    for (auto n{0UL}; n < x.size(); ++n) {
+        bin += x[n] * std::polar(1.0, -2.0 * std::numbers::pi * frequency * static_cast<double>(n) / fs);
+    }
+    return std::abs(bin);
+}
+
+}  // namespace
+
+TEST_CASE("RaumAkustik: ExponentialSweep", "")
+{
+    using ra::si::unit_symbols::Hz;
+    using ra::si::unit_symbols::s;
+
+    auto const spec = ra::ExponentialSweep{
+        .from       = 20.0 * Hz,
+        .to         = 20'000.0 * Hz,
+        .duration   = 2.0 * s,
+        .sampleRate = 44'100.0 * Hz,
+    };
+
+    auto const rate = ra::sweepRate(spec).numerical_value_in(ra::si::second);
+    REQUIRE(rate == Catch::Approx(2.0 / std::log(1'000.0)));
+
+    auto const signal = ra::generate(spec);
+    REQUIRE(signal.sweep.size() == 88'200);
+    REQUIRE(signal.inverse.size() == 88'200);
+
+    // Closed-form phase
+    auto const k = 2.0 * std::numbers::pi * 20.0 * rate;
+    for (auto n{0UL}; n < signal.sweep.size(); ++n) {
+        auto const t        = static_cast<double>(n) / 44'100.0;
+        auto const expected = std::sin(k * (std::exp(t / rate) - 1.0));
+        REQUIRE(signal.sweep[n] == Catch::Approx(expected).margin(1e-5));
+    }
+
+    // The inverse starts with the end of the sweep at full level and decays
+    // by 60 dB, the frequency ratio of the sweep
+    auto const peak = [](auto first, auto last) {
+        return *std::max_element(first, last, [](auto l, auto r) { return std::abs(l) < std::abs(r); });
+    };
+    auto const head = std::abs(peak(signal.inverse.begin(), signal.inverse.begin() + 1'000));
+    auto const tail = std::abs(peak(signal.inverse.end() - 1'000, signal.inverse.end()));
+    REQUIRE(20.0 * std::log10(head / tail) == Catch::Approx(60.0).margin(0.5));
+}
+
+TEST_CASE("RaumAkustik: ExponentialSweep(inverse)", "")
+{
+    using ra::si::unit_symbols::Hz;
+    using ra::si::unit_symbols::s;
+
+    auto const fs   = 8'000.0;
+    auto const spec = ra::ExponentialSweep{
+        .from       = 50.0 * Hz,
+        .to         = 3'000.0 * Hz,
+        .duration   = 0.5 * s,
+        .sampleRate = fs * Hz,
+        .fadeIn     = 0.01 * s,
+        .fadeOut    = 0.005 * s,
+    };
+
+    auto const signal = ra::generate(spec);
+    REQUIRE(signal.sweep.front() == Catch::Approx(0.0).margin(1e-3));
+    REQUIRE(signal.sweep.back() == Catch::Approx(0.0).margin(1e-3));
+
+    // Sweep convolved with its inverse is a band-limited impulse
+    auto const size = signal.sweep.size();
+    auto impulse    = std::vector<double>(size * 2 - 1);
+    for (auto i{0UL}; i < size; ++i) {
+        for (auto j{0UL}; j < size; ++j) {
+            impulse[i + j] += static_cast<double>(signal.sweep[i]) * static_cast<double>(signal.inverse[j]);
+        }
+    }
+
+    auto const peak = std::max_element(impulse.begin(), impulse.end(), [](auto l, auto r) {
+        return std::abs(l) < std::abs(r);
+    });
+    REQUIRE(std::distance(impulse.begin(), peak) == static_cast<std::ptrdiff_t>(size - 1));
+
+    for (auto const frequency : {200.0, 387.3, 1'000.0, 2'000.0}) {
+        REQUIRE(magnitudeAt(impulse, frequency, fs) == Catch::Approx(1.0).margin(0.12));
+    }
+}
@@ -27,7 +27,7 @@ auto generate(GlideSweep const& spec) -> std::vector<float>
 {
     auto scaleFrequency = [curve = spec.curve](auto f1, auto f2, auto t) {
         if (curve == GlideSweep::Curve::Logarithmic) {
-            return std::pow(f1 * (f2 / f1), t);
+            return f1 * std::pow(f2 / f1, t);
         }
         return std::lerp(f1, f2, t);
     };
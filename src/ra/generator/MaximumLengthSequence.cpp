@@ -0,0 +1,42 @@
+#include "MaximumLengthSequence.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace ra {
+
+namespace {
+
+// Feedback masks of maximal length Galois registers, indexed by order
+constexpr auto taps = std::array<std::uint32_t, 25>{
+    0x0,      0x0,      0x3,      0x6,      0xC,      //
+    0x14,     0x30,     0x60,     0xB8,     0x110,    //
+    0x240,    0x500,    0x829,    0x100D,   0x2015,   //
+    0x6000,   0xD008,   0x12000,  0x20400,  0x40023,  //
+    0x90000,  0x140000, 0x300000, 0x420000, 0xE10000, //
+};
+
+}  // namespace
+
+auto generate(MaximumLengthSequence const& spec) -> std::vector<float>
+{
+    auto const order  = std::clamp(spec.order, std::size_t(2), taps.size() - 1);
+    auto const mask   = taps[order];
+    auto const period = (std::size_t(1) << order) - 1;
+
+    auto sequence = std::vector<float>(period);
+    auto state    = std::uint32_t{1};
+    for (auto& sample : sequence) {
+        auto const bit = state & 1U;
+        sample         = bit != 0U ? 1.0F : -1.0F;
+        state >>= 1U;
+        if (bit != 0U) {
+            state ^= mask;
+        }
+    }
+
+    return sequence;
+}
+
+}  // namespace ra
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace ra {
+
+/// Maximum length sequence of a linear feedback shift register
+///
+/// Periodic with 2^order - 1 samples of +1 & -1. The circular
+/// autocorrelation is the period at lag 0 and -1 at every other lag, so
+/// correlating a recording of it yields the impulse response.
+struct MaximumLengthSequence
+{
+    /// From 2 to 24
+    std::size_t order{16};
+};
+
+[[nodiscard]] auto generate(MaximumLengthSequence const& spec) -> std::vector<float>;
+
+}  // namespace ra
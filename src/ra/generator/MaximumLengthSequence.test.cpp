@@ -0,0 +1,31 @@
+#include "MaximumLengthSequence.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+TEST_CASE("RaumAkustik: MaximumLengthSequence", "")
+{
+    for (auto order{2UL}; order <= 18UL; ++order) {
+        auto const mls    = ra::generate(ra::MaximumLengthSequence{.order = order});
+        auto const period = (std::size_t(1) << order) - 1;
+        REQUIRE(mls.size() == period);
+
+        // One more +1 than -1 in every period
+        auto const ones = std::count(mls.begin(), mls.end(), 1.0F);
+        REQUIRE(static_cast<std::size_t>(ones) == (period + 1) / 2);
+        REQUIRE(std::all_of(mls.begin(), mls.end(), [](auto x) { return x == 1.0F or x == -1.0F; }));
+    }
+
+    // Circular autocorrelation is an impulse
+    auto const mls    = ra::generate(ra::MaximumLengthSequence{.order = 10});
+    auto const period = mls.size();
+    for (auto lag{0UL}; lag < period; ++lag) {
+        auto sum = 0.0;
+        for (auto i{0UL}; i < period; ++i) {
+            sum += static_cast<double>(mls[i] * mls[(i + lag) % period]);
+        }
+        REQUIRE(sum == (lag == 0 ? static_cast<double>(period) : -1.0));
+    }
+}
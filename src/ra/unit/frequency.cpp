@@ -13,4 +13,21 @@ auto oactaveSubdivision(quantity<isq::frequency[si::hertz]> start, double numSub
     return std::pow(2.0, std::log2(start.numerical_value_in(si::hertz)) + index / numSubdivisions) * si::hertz;
 }
 
+auto thirdOctaveBands(quantity<isq::frequency[si::hertz]> fmin, quantity<isq::frequency[si::hertz]> fmax)
+    -> std::vector<quantity<isq::frequency[si::hertz]>>
+{
+    // Exact centers differ from the nominal ones by up to 2.5%, so
+    // 20Hz includes the 19.7Hz band and 20kHz includes 20.2kHz
+    static constexpr auto tolerance = 0.1;
+
+    auto const first = std::ceil(3.0 * std::log2(fmin.numerical_value_in(si::hertz) / 1000.0) - tolerance);
+    auto const last  = std::floor(3.0 * std::log2(fmax.numerical_value_in(si::hertz) / 1000.0) + tolerance);
+
+    auto bands = std::vector<quantity<isq::frequency[si::hertz]>>{};
+    for (auto n = first; n <= last; n += 1.0) {
+        bands.push_back(1000.0 * std::pow(2.0, n / 3.0) * si::hertz);
+    }
+    return bands;
+}
+
 }  // namespace ra
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <vector>
 
 #include <mp-units/systems/isq.h>
 #include <mp-units/systems/si.h>
@@ -12,4 +13,8 @@ using namespace mp_units;
 [[nodiscard]] auto oactaveSubdivision(quantity<isq::frequency[si::hertz]> start, double numSubdivisions, double index)
     -> quantity<isq::frequency[si::hertz]>;
 
+/// Base 2 third-octave centers 1kHz * 2^(n/3) between fmin & fmax (inclusive)
+[[nodiscard]] auto thirdOctaveBands(quantity<isq::frequency[si::hertz]> fmin, quantity<isq::frequency[si::hertz]> fmax)
+    -> std::vector<quantity<isq::frequency[si::hertz]>>;
+
 }  // namespace ra
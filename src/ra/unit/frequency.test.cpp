@@ -10,3 +10,16 @@ TEST_CASE("RaumAkustik: oactaveSubdivision", "")
     REQUIRE(ra::oactaveSubdivision(50.0 * Hz, 6, 1).numerical_value_in(Hz) == Catch::Approx(56.1231024));
     REQUIRE(ra::oactaveSubdivision(50.0 * Hz, 6, 2).numerical_value_in(Hz) == Catch::Approx(62.9960524));
 }
+
+TEST_CASE("RaumAkustik: thirdOctaveBands", "")
+{
+    using namespace mp_units::si::unit_symbols;
+
+    auto const bands = ra::thirdOctaveBands(20.0 * Hz, 20'000.0 * Hz);
+    REQUIRE(bands.size() == 31);
+    REQUIRE(bands.front().numerical_value_in(Hz) == Catch::Approx(19.6862664));
+    REQUIRE(bands[17].numerical_value_in(Hz) == Catch::Approx(1000.0));
+    REQUIRE(bands.back().numerical_value_in(Hz) == Catch::Approx(20'158.7368));
+
+    REQUIRE(ra::thirdOctaveBands(125.0 * Hz, 500.0 * Hz).size() == 7);
+}
@@ -60,6 +60,7 @@ auto RaumAkustikApplication::initialise(juce::String const& commandLine) -> void
     // code..
     juce::ignoreUnused(commandLine);
 
+    _deviceManager.addAudioCallback(&_audioDispatcher);
     _mainWindow = std::make_unique<MainWindow>(getApplicationName());
 }
 
@@ -68,6 +69,7 @@ auto RaumAkustikApplication::shutdown() -> void
     // Add your application's shutdown code here..
 
     _mainWindow = nullptr;  // (deletes our window)
+    _deviceManager.removeAudioCallback(&_audioDispatcher);
 }
 
 auto RaumAkustikApplication::systemRequestedQuit() -> void
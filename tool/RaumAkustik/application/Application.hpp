@@ -1,5 +1,7 @@
 #pragma once
 
+#include "application/AudioDispatcher.hpp"
+
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
@@ -18,8 +20,10 @@ struct RaumAkustikApplication : juce::JUCEApplication
     auto anotherInstanceStarted(juce::String const& commandLine) -> void override;
 
     auto deviceManager() -> juce::AudioDeviceManager& { return _deviceManager; }
+    auto audioDispatcher() -> AudioDispatcher& { return _audioDispatcher; }
 
 private:
+    AudioDispatcher _audioDispatcher;
     juce::AudioDeviceManager _deviceManager;
     std::unique_ptr<juce::DocumentWindow> _mainWindow;
 };
@@ -0,0 +1,283 @@
+#include "AudioDispatcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace ra {
+
+namespace {
+
+[[nodiscard]] auto now() noexcept -> std::uint64_t
+{
+    auto const time = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+}
+
+[[nodiscard]] auto blockDuration(std::size_t numSamples, double sampleRate) noexcept -> std::uint64_t
+{
+    if (sampleRate <= 0.0) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(static_cast<double>(numSamples) * 1e9 / sampleRate);
+}
+
+}  // namespace
+
+auto AudioInput::channel(std::size_t index) const -> std::span<float const>
+{
+    if (index >= channels.size() or channels[index] == nullptr) {
+        return {};
+    }
+    return {channels[index], numSamples};
+}
+
+AudioOutput::AudioOutput(std::span<float* const> channels, std::span<float> scratch)
+    : _channels{channels}
+    , _scratch{scratch}
+{}
+
+auto AudioOutput::channels() const -> std::size_t { return _channels.size(); }
+
+auto AudioOutput::scratch() const -> std::span<float> { return _scratch; }
+
+auto AudioOutput::add(std::size_t channel, std::span<float const> block) const -> void
+{
+    if (channel >= _channels.size() or _channels[channel] == nullptr) {
+        return;
+    }
+
+    auto const size = static_cast<int>(std::min(block.size(), _scratch.size()));
+    juce::FloatVectorOperations::add(_channels[channel], block.data(), size);
+}
+
+auto AudioOutput::addToAll(std::span<float const> block) const -> void
+{
+    for (auto channel{0UL}; channel < _channels.size(); ++channel) {
+        add(channel, block);
+    }
+}
+
+auto AudioDispatcher::add(AudioConsumer& consumer, juce::String const& name) -> void
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // remove() only clears the first slot, a second one would outlive it
+    auto const registered = [&consumer](auto const& slot) { return slot.load() == &consumer; };
+    if (std::any_of(_consumers.begin(), _consumers.end(), registered)) {
+        jassertfalse;
+        return;
+    }
+
+    // Not visible to the audio thread yet
+    if (_device != nullptr) {
+        consumer.audioStarted(*_device);
+    }
+
+    for (auto i{0UL}; i < maxConsumers; ++i) {
+        auto* expected = static_cast<AudioConsumer*>(nullptr);
+        if (_consumers[i].compare_exchange_strong(expected, &consumer)) {
+            _names[i] = name;
+            return;
+        }
+    }
+
+    // More consumers than slots
+    jassertfalse;
+}
+
+auto AudioDispatcher::remove(AudioConsumer& consumer) -> void
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto slot = maxConsumers;
+    for (auto i{0UL}; i < maxConsumers; ++i) {
+        auto* expected = &consumer;
+        if (_consumers[i].compare_exchange_strong(expected, nullptr)) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot == maxConsumers) {
+        return;
+    }
+
+    // A callback that started before the swap may still use the consumer,
+    // the ones after can't see it anymore
+    auto const sequence = _sequence.load();
+    if (sequence % 2 == 1) {
+        while (_sequence.load() == sequence) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Nobody writes to the slot anymore
+    _consumerProfilers[slot].reset();
+    _names[slot] = {};
+
+    if (_device != nullptr) {
+        consumer.audioStopped();
+    }
+}
+
+auto AudioDispatcher::profile() const -> std::vector<Profile>
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto profiles = std::vector<Profile>{};
+    auto timings  = std::vector<CallbackTiming>(_callbackProfiler.capacity());
+
+    auto const collect = [&profiles, &timings](juce::String const& name, CallbackProfiler const& profiler) {
+        auto const count = profiler.latest(timings);
+        profiles.push_back({name, analyze(std::span{timings}.first(count))});
+    };
+
+    collect("Callback", _callbackProfiler);
+    for (auto i{0UL}; i < maxConsumers; ++i) {
+        if (_consumers[i].load() != nullptr) {
+            collect(_names[i], _consumerProfilers[i]);
+        }
+    }
+
+    return profiles;
+}
+
+void AudioDispatcher::audioDeviceAboutToStart(juce::AudioIODevice* device)
+{
+    auto const blockSize  = static_cast<std::size_t>(std::max(device->getCurrentBufferSizeSamples(), 1));
+    auto const sampleRate = device->getCurrentSampleRate();
+    auto const inputs     = static_cast<std::size_t>(device->getActiveInputChannels().countNumberOfSetBits());
+    auto const outputs    = static_cast<std::size_t>(device->getActiveOutputChannels().countNumberOfSetBits());
+    auto const window     = static_cast<std::size_t>(juce::roundToInt(0.3 * sampleRate));
+
+    _inputs.assign(inputs, nullptr);
+    _outputs.assign(outputs, nullptr);
+    _sum.assign(blockSize, 0.0F);
+    _scratch.assign(blockSize, 0.0F);
+    _levels.assign(inputs, RunningLevel{window});
+    _sampleRate = sampleRate;
+
+    _device = device;
+    for (auto& slot : _consumers) {
+        if (auto* consumer = slot.load(); consumer != nullptr) {
+            consumer->audioStarted(*device);
+        }
+    }
+}
+
+void AudioDispatcher::audioDeviceStopped()
+{
+    _device = nullptr;
+    for (auto& slot : _consumers) {
+        if (auto* consumer = slot.load(); consumer != nullptr) {
+            consumer->audioStopped();
+        }
+    }
+}
+
+void AudioDispatcher::audioDeviceIOCallbackWithContext(
+    float const* const* inputChannelData,
+    int numInputChannels,
+    float* const* outputChannelData,
+    int numOutputChannels,
+    int numSamples,
+    juce::AudioIODeviceCallbackContext const& context
+)
+{
+    juce::ignoreUnused(context);
+
+    _sequence.fetch_add(1);
+    auto const begin = now();
+
+    // The only place the output is cleared, everyone else adds to it
+    for (auto channel{0}; channel < numOutputChannels; ++channel) {
+        if (outputChannelData[channel] != nullptr) {
+            juce::FloatVectorOperations::clear(outputChannelData[channel], numSamples);
+        }
+    }
+
+    auto const inputs   = std::min(static_cast<std::size_t>(std::max(numInputChannels, 0)), _inputs.size());
+    auto const outputs  = std::min(static_cast<std::size_t>(std::max(numOutputChannels, 0)), _outputs.size());
+    auto const samples  = static_cast<std::size_t>(std::max(numSamples, 0));
+    auto const capacity = _scratch.size();
+
+    // Some drivers deliver more than the buffer size they reported
+    for (auto offset{0UL}; capacity > 0 and offset < samples; offset += capacity) {
+        auto const at = static_cast<std::ptrdiff_t>(offset);
+        for (auto channel{0UL}; channel < inputs; ++channel) {
+            auto const* in   = inputChannelData[channel];
+            _inputs[channel] = in != nullptr ? std::next(in, at) : nullptr;
+        }
+        for (auto channel{0UL}; channel < outputs; ++channel) {
+            auto* out         = outputChannelData[channel];
+            _outputs[channel] = out != nullptr ? std::next(out, at) : nullptr;
+        }
+
+        dispatch(inputs, outputs, std::min(capacity, samples - offset));
+    }
+
+    auto const end = now();
+    _callbackProfiler({.start = begin, .duration = end - begin, .deadline = blockDuration(samples, _sampleRate)});
+    _sequence.fetch_add(1);
+}
+
+auto AudioDispatcher::dispatch(std::size_t inputs, std::size_t outputs, std::size_t numSamples) -> void
+{
+    // Consumers added halfway through get the next block
+    auto consumers = std::array<AudioConsumer*, maxConsumers>{};
+    auto slots     = std::array<std::size_t, maxConsumers>{};
+    auto count     = std::size_t{0};
+    auto needs     = AudioProducts{};
+    for (auto i{0UL}; i < maxConsumers; ++i) {
+        if (auto* consumer = _consumers[i].load(); consumer != nullptr) {
+            auto const products = consumer->audioProducts();
+            needs.channelSum    = needs.channelSum or products.channelSum;
+            needs.levels        = needs.levels or products.levels;
+            consumers[count]    = consumer;
+            slots[count]        = i;
+            ++count;
+        }
+    }
+
+    auto input = AudioInput{
+        .channels   = std::span{_inputs}.first(inputs),
+        .numSamples = numSamples,
+        .sum        = {},
+        .levels     = {},
+    };
+
+    if (needs.channelSum) {
+        auto const sum = std::span{_sum}.first(numSamples);
+        std::fill(sum.begin(), sum.end(), 0.0F);
+        for (auto const* channel : input.channels) {
+            if (channel != nullptr) {
+                juce::FloatVectorOperations::add(sum.data(), channel, static_cast<int>(numSamples));
+            }
+        }
+        input.sum = sum;
+    }
+
+    if (needs.levels) {
+        for (auto channel{0UL}; channel < inputs; ++channel) {
+            if (auto const in = input.channel(channel); not in.empty()) {
+                _levels[channel](in);
+            }
+        }
+        input.levels = std::span{_levels}.first(inputs);
+    }
+
+    auto const output = AudioOutput{std::span{_outputs}.first(outputs), std::span{_scratch}.first(numSamples)};
+    // The end of one consumer is the start of the next
+    auto const deadline = blockDuration(numSamples, _sampleRate);
+    auto start          = now();
+    for (auto i{0UL}; i < count; ++i) {
+        consumers[i]->processAudio(input, output);
+
+        auto const end = now();
+        _consumerProfilers[slots[i]]({.start = start, .duration = end - start, .deadline = deadline});
+        start = end;
+    }
+}
+
+}  // namespace ra
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <ra/dsp/CallbackProfiler.hpp>
+#include <ra/dsp/RunningLevel.hpp>
+
+#include <juce_audio_devices/juce_audio_devices.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ra {
+
+/// Shared analysis of the input, computed once per block for all consumers
+/// that asked for it
+struct AudioProducts
+{
+    /// Sum of all input channels
+    bool channelSum{false};
+
+    /// Peak of the block & RMS over the last 300 ms, per input channel
+    bool levels{false};
+};
+
+struct AudioInput
+{
+    /// Inactive channels are null
+    std::span<float const* const> channels;
+    std::size_t numSamples{0};
+
+    /// Empty unless requested
+    std::span<float const> sum;
+    std::span<RunningLevel const> levels;
+
+    /// Empty if the channel doesn't exist or is inactive
+    [[nodiscard]] auto channel(std::size_t index) const -> std::span<float const>;
+};
+
+/// Producers can only add to the output, they never overwrite each other
+struct AudioOutput
+{
+    AudioOutput(std::span<float* const> channels, std::span<float> scratch);
+
+    [[nodiscard]] auto channels() const -> std::size_t;
+
+    /// Block sized buffer to render into before adding it to the output.
+    /// Shared by all consumers, only valid during the call.
+    [[nodiscard]] auto scratch() const -> std::span<float>;
+
+    /// Missing or inactive channels are skipped
+    auto add(std::size_t channel, std::span<float const> block) const -> void;
+    auto addToAll(std::span<float const> block) const -> void;
+
+private:
+    std::span<float* const> _channels;
+    std::span<float> _scratch;
+};
+
+struct AudioConsumer
+{
+    virtual ~AudioConsumer() = default;
+
+    [[nodiscard]] virtual auto audioProducts() const -> AudioProducts { return {}; }
+
+    /// Message thread, before the first block
+    virtual auto audioStarted(juce::AudioIODevice& device) -> void = 0;
+    virtual auto audioStopped() -> void {}
+
+    /// Audio thread
+    virtual auto processAudio(AudioInput const& input, AudioOutput const& output) -> void = 0;
+};
+
+/// The only callback of the audio device
+///
+/// Clears the output once, computes the requested products of the input &
+/// fans the block out to every registered consumer. Registering never
+/// blocks the audio thread, the consumers live in a fixed array of atomic
+/// pointers.
+///
+/// Every callback & every consumer in it is timed against the length of
+/// the block. That's one clock read per consumer plus two, stored in a
+/// lock-free ring per consumer.
+struct AudioDispatcher final : juce::AudioIODeviceCallback
+{
+    static constexpr auto maxConsumers = std::size_t{16};
+
+    struct Profile
+    {
+        juce::String name;
+        CallbackStatistics statistics;
+    };
+
+    AudioDispatcher() = default;
+    ~AudioDispatcher() override = default;
+
+    /// Message thread only. Starts the consumer right away if the device
+    /// is running already. The name shows up in the profile, adding the
+    /// same consumer twice is an error.
+    auto add(AudioConsumer& consumer, juce::String const& name) -> void;
+
+    /// Message thread only. Returns once the audio thread is done with the
+    /// consumer, so it can be destroyed right after.
+    auto remove(AudioConsumer& consumer) -> void;
+
+    /// Message thread only. The whole callback first, then every consumer
+    [[nodiscard]] auto profile() const -> std::vector<Profile>;
+
+    void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
+    void audioDeviceStopped() override;
+    void audioDeviceIOCallbackWithContext(
+        float const* const* inputChannelData,
+        int numInputChannels,
+        float* const* outputChannelData,
+        int numOutputChannels,
+        int numSamples,
+        juce::AudioIODeviceCallbackContext const& context
+    ) override;
+
+private:
+    auto dispatch(std::size_t inputs, std::size_t outputs, std::size_t numSamples) -> void;
+
+    std::array<std::atomic<AudioConsumer*>, maxConsumers> _consumers{};
+
+    // Odd while the audio thread is inside a callback
+    std::atomic<std::uint64_t> _sequence{0};
+
+    // Audio thread -> message thread
+    CallbackProfiler _callbackProfiler;
+    std::array<CallbackProfiler, maxConsumers> _consumerProfilers;
+
+    // Message thread only
+    juce::AudioIODevice* _device{nullptr};
+    std::array<juce::String, maxConsumers> _names;
+
+    // Audio thread only, sized while the device is stopped
+    double _sampleRate{0.0};
+    std::vector<float const*> _inputs;
+    std::vector<float*> _outputs;
+    std::vector<float> _sum;
+    std::vector<float> _scratch;
+    std::vector<RunningLevel> _levels;
+};
+
+}  // namespace ra
@@ -8,8 +8,9 @@
 namespace ra {
 
 MainComponent::MainComponent()
-    : _audioInputEditor{raumAkusticApplication().deviceManager()}
-    , _generatorEditor{raumAkusticApplication().deviceManager()}
+    : _audioInputEditor{raumAkusticApplication().deviceManager(), raumAkusticApplication().audioDispatcher()}
+    , _generatorEditor{raumAkusticApplication().audioDispatcher()}
+    , _diagnostics{raumAkusticApplication().audioDispatcher()}
 {
     auto room = juce::ValueTree{"Room"};
     setPropertyIfNotExist(room, "icon_size", 50.0);
@@ -48,8 +49,9 @@ MainComponent::MainComponent()
     setLookAndFeel(&_lnf);
     setSize(1280, 720);
 
-    raumAkusticApplication().deviceManager().addAudioCallback(&_levelMeter);
-    raumAkusticApplication().deviceManager().addAudioCallback(&_waveform);
+    raumAkusticApplication().audioDispatcher().add(_levelMeter, "Level Meter");
+    raumAkusticApplication().audioDispatcher().add(_waveform, "Waveform");
+    raumAkusticApplication().audioDispatcher().add(_transferFunction, "Transfer Function");
 
     reloadUI();
 }
@@ -57,8 +59,9 @@ MainComponent::MainComponent()
 MainComponent::~MainComponent()
 {
     DBG(_valueTree.toXmlString());
-    raumAkusticApplication().deviceManager().removeAudioCallback(&_levelMeter);
-    raumAkusticApplication().deviceManager().removeAudioCallback(&_waveform);
+    raumAkusticApplication().audioDispatcher().remove(_levelMeter);
+    raumAkusticApplication().audioDispatcher().remove(_waveform);
+    raumAkusticApplication().audioDispatcher().remove(_transferFunction);
     _threadPool.removeAllJobs(true, 500, nullptr);
     setLookAndFeel(nullptr);
 }
@@ -237,13 +240,15 @@ auto MainComponent::reloadUI() -> void
     _roomEditor               = std::make_unique<RoomEditor>(_valueTree, &_undoManager);
     _raytracingEditor         = std::make_unique<StochasticRaytracingEditor>(_threadPool, *_roomEditor);
     _waveEquationEditor       = std::make_unique<WaveEquation2DEditor>(_threadPool, *_roomEditor);
-    _absorberSimulationEditor = std::make_unique<PorousAbsorberEditor>(absorberTree, &_undoManager);
+    _absorberSimulationEditor = std::make_unique<PorousAbsorberEditor>(_threadPool, absorberTree, &_undoManager);
     _materialEditor           = std::make_unique<MaterialEditor>();
 
     auto const color = getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId);
     _tabs.addTab("Room", color, _roomEditor.get(), false);
     _tabs.addTab("Audio Input", color, std::addressof(_audioInputEditor), false);
     _tabs.addTab("Generator", color, std::addressof(_generatorEditor), false);
+    _tabs.addTab("Transfer Function", color, std::addressof(_transferFunction), false);
+    _tabs.addTab("Diagnostics", color, std::addressof(_diagnostics), false);
     _tabs.addTab("Raytracing", color, _raytracingEditor.get(), false);
     _tabs.addTab("Wave Equation 2D", color, _waveEquationEditor.get(), false);
     _tabs.addTab("Porous Absorber", color, _absorberSimulationEditor.get(), false);
@@ -2,8 +2,10 @@
 
 #include "application/MenuBar.hpp"
 #include "application/Settings.hpp"
+#include "component/AudioDiagnostics.hpp"
 #include "component/LevelMeter.hpp"
 #include "component/ScrollingWaveform.hpp"
+#include "component/TransferFunctionAnalyzer.hpp"
 #include "editor/AudioInterfaceEditor.hpp"
 #include "editor/MaterialEditor.hpp"
 #include "editor/PorousAbsorberEditor.hpp"
@@ -59,6 +61,8 @@ private:
     std::unique_ptr<RoomEditor> _roomEditor;
     AudioInterfaceEditor _audioInputEditor;
     ToneGeneratorEditor _generatorEditor;
+    TransferFunctionAnalyzer _transferFunction;
+    AudioDiagnostics _diagnostics;
     std::unique_ptr<StochasticRaytracingEditor> _raytracingEditor;
     std::unique_ptr<WaveEquation2DEditor> _waveEquationEditor;
     std::unique_ptr<PorousAbsorberEditor> _absorberSimulationEditor;
@@ -0,0 +1,96 @@
+#include "AudioDiagnostics.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace ra {
+
+namespace {
+
+[[nodiscard]] auto toPercent(double load) -> juce::String { return juce::String(load * 100.0, 1) + " %"; }
+
+auto drawHistogram(juce::Graphics& g, CallbackStatistics const& stats, juce::Rectangle<float> area) -> void
+{
+    auto const& histogram = stats.histogram;
+    auto const highest    = std::max(*std::max_element(histogram.begin(), histogram.end()), std::size_t(1));
+    auto const width      = area.getWidth() / static_cast<float>(histogram.size());
+
+    for (auto i{0UL}; i < histogram.size(); ++i) {
+        auto const ratio = static_cast<float>(histogram[i]) / static_cast<float>(highest);
+        auto const bar   = juce::Rectangle<float>{
+            area.getX() + width * static_cast<float>(i),
+            area.getBottom() - area.getHeight() * ratio,
+            width,
+            area.getHeight() * ratio,
+        };
+
+        // The last bin missed the deadline
+        auto const overrun = i + 1 == histogram.size();
+        g.setColour(overrun ? juce::Colours::red : juce::Colours::white.withAlpha(0.75F));
+        g.fillRect(bar.reduced(1.0F, 0.0F));
+    }
+}
+
+}  // namespace
+
+AudioDiagnostics::AudioDiagnostics(AudioDispatcher& dispatcher) : _dispatcher{dispatcher} { startTimerHz(4); }
+
+auto AudioDiagnostics::paint(juce::Graphics& g) -> void
+{
+    g.fillAll(juce::Colours::black);
+
+    auto area        = getLocalBounds().reduced(10);
+    auto const row   = 24;
+    auto const names = area.proportionOfWidth(0.2);
+    auto const cell  = area.proportionOfWidth(0.08);
+
+    auto const drawRow = [&](auto const& cells, juce::Rectangle<int> bounds) {
+        g.drawText(cells[0], bounds.removeFromLeft(names), juce::Justification::centredLeft);
+        for (auto i{1UL}; i < cells.size(); ++i) {
+            g.drawText(cells[i], bounds.removeFromLeft(cell), juce::Justification::centredRight);
+        }
+        return bounds;
+    };
+
+    g.setColour(juce::Colours::white.withAlpha(0.5F));
+    auto const header = std::array<juce::String, 6>{"Consumer", "p50", "p90", "p99", "max", "overruns"};
+    auto const legend = drawRow(header, area.removeFromTop(row)).reduced(10, 0);
+    g.drawText("< 0.1 %", legend, juce::Justification::centredLeft);
+    g.drawText(">= 100 %", legend, juce::Justification::centredRight);
+
+    for (auto const& profile : _profiles) {
+        auto const& stats = profile.statistics;
+        auto const cells  = std::array<juce::String, 6>{
+            profile.name,
+            toPercent(stats.median),
+            toPercent(stats.p90),
+            toPercent(stats.p99),
+            toPercent(stats.max),
+            juce::String(stats.overruns),
+        };
+
+        g.setColour(stats.overruns > 0 ? juce::Colours::red : juce::Colours::white);
+        auto const histogram = drawRow(cells, area.removeFromTop(row)).reduced(10, 2);
+        drawHistogram(g, stats, histogram.toFloat());
+    }
+
+    if (_profiles.empty()) {
+        return;
+    }
+
+    // Only meaningful for the whole callback, the consumers run back to back
+    auto const& callback = _profiles.front().statistics;
+    auto const summary   = juce::String(callback.callbacks) + " callbacks, " + juce::String(callback.xruns)
+                       + " dropped buffers, interval jitter (p99) " + toPercent(callback.jitter) + " of the block";
+
+    g.setColour(callback.xruns > 0 ? juce::Colours::red : juce::Colours::white);
+    g.drawText(summary, area.removeFromTop(row * 2), juce::Justification::centredLeft);
+}
+
+auto AudioDiagnostics::timerCallback() -> void
+{
+    _profiles = _dispatcher.profile();
+    repaint();
+}
+
+}  // namespace ra
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "application/AudioDispatcher.hpp"
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <vector>
+
+namespace ra {
+
+/// Load of the audio callback & of every consumer in it
+///
+/// One row per consumer with the percentiles of its duration relative to
+/// the length of the block and a histogram with one bar per octave of load.
+/// Below are the overruns, dropped buffers & the jitter of the callback
+/// interval, the usual suspects behind dropouts.
+struct AudioDiagnostics final
+    : juce::Component
+    , juce::Timer
+{
+    explicit AudioDiagnostics(AudioDispatcher& dispatcher);
+    ~AudioDiagnostics() override = default;
+
+    auto paint(juce::Graphics& g) -> void override;
+    auto timerCallback() -> void override;
+
+private:
+    AudioDispatcher& _dispatcher;
+    std::vector<AudioDispatcher::Profile> _profiles;
+};
+
+}  // namespace ra
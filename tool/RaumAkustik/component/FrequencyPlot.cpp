@@ -0,0 +1,90 @@
+#include "FrequencyPlot.hpp"
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ra {
+
+auto frequencyToX(float minFreq, float maxFreq, float freq, float width) -> float
+{
+    auto const logMin  = std::log(minFreq);
+    auto const logMax  = std::log(maxFreq);
+    auto const logFreq = std::log(freq);
+    auto const ratio   = (logFreq - logMin) / (logMax - logMin);
+    return width * ratio;
+}
+
+auto amplitudeToY(float amplitude, juce::Rectangle<float> const bounds) -> float
+{
+    auto const infinity = -96.0F;
+    auto const dB       = juce::Decibels::gainToDecibels(amplitude, infinity);
+    return juce::jmap(dB, infinity, 0.0F, bounds.getBottom(), bounds.getY());
+}
+
+auto makePathFromAnalysis(std::span<FrequencyAndAmplitude const> analysis, float fs, juce::Rectangle<float> bounds)
+    -> juce::Path
+{
+    auto const size = static_cast<int>(analysis.size());
+    if (size == 0) {
+        return {};
+    }
+
+    auto frequencyLess = [](auto bin, auto target) { return bin.frequency < target; };
+    auto first         = std::lower_bound(begin(analysis), end(analysis), 1.0F, frequencyLess);
+    if (first == end(analysis)) {
+        return {};
+    }
+
+    auto p = juce::Path{};
+    p.preallocateSpace(8 + size * 3);
+
+    auto const width  = bounds.getWidth();
+    auto const startY = amplitudeToY(first->amplitude, bounds);
+    p.startNewSubPath(bounds.getX() + frequencyToX(1.0F, fs * 0.5F, first->frequency, width), startY);
+
+    for (; first != end(analysis); ++first) {
+        auto const y = amplitudeToY(first->amplitude, bounds);
+        p.lineTo(bounds.getX() + frequencyToX(1.0F, fs * 0.5F, first->frequency, width), y);
+    }
+
+    return p;
+}
+
+auto drawDecadeLines(juce::Graphics& g, juce::Rectangle<float> bounds, float maxFreq) -> void
+{
+    auto const& b = bounds;
+
+    for (auto const decade : {10.0F, 100.0F, 1'000.0F}) {
+        auto x0 = juce::roundToInt(b.getX() + frequencyToX(1.0F, maxFreq, decade, b.getWidth()));
+        g.setColour(juce::Colours::white.withAlpha(0.5F));
+        g.drawVerticalLine(x0, b.getY(), b.getBottom());
+
+        for (auto i{1}; i < 10; ++i) {
+            auto const d = decade * static_cast<float>(i);
+            auto const x = juce::roundToInt(b.getX() + frequencyToX(1.0F, maxFreq, d, b.getWidth()));
+            g.setColour(juce::Colours::white.withAlpha(0.25F));
+            g.drawVerticalLine(x, b.getY(), b.getBottom());
+        }
+    }
+
+    auto x0 = juce::roundToInt(b.getX() + frequencyToX(1.0F, maxFreq, 10'000.0F, b.getWidth()));
+    g.setColour(juce::Colours::white.withAlpha(0.5F));
+    g.drawVerticalLine(x0, b.getY(), b.getBottom());
+}
+
+auto drawFrequencyGrid(juce::Graphics& g, juce::Rectangle<float> bounds, float maxFreq) -> void
+{
+    auto const& b = bounds;
+    drawDecadeLines(g, b, maxFreq);
+
+    for (auto i{0}; i < 90; i += 6) {
+        auto const amplitude = juce::Decibels::decibelsToGain(static_cast<float>(-i));
+        auto const y         = juce::roundToInt(amplitudeToY(amplitude, b));
+        g.setColour(juce::Colours::white.withAlpha(0.25F));
+        g.drawHorizontalLine(y, b.getX(), b.getRight());
+    }
+}
+
+}  // namespace ra
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <span>
+
+namespace ra {
+
+struct FrequencyAndAmplitude
+{
+    float frequency;
+    float amplitude;
+};
+
+/// Log frequency axis starting at minFreq
+[[nodiscard]] auto frequencyToX(float minFreq, float maxFreq, float freq, float width) -> float;
+
+/// Linear amplitude on a dB axis from -96 to 0 dB
+[[nodiscard]] auto amplitudeToY(float amplitude, juce::Rectangle<float> bounds) -> float;
+
+/// Log frequency path from 1 Hz up to Nyquist
+[[nodiscard]] auto makePathFromAnalysis(
+    std::span<FrequencyAndAmplitude const> analysis,
+    float fs,
+    juce::Rectangle<float> bounds
+) -> juce::Path;
+
+/// Vertical lines at every decade & its multiples, on the frequency axis of
+/// makePathFromAnalysis
+auto drawDecadeLines(juce::Graphics& g, juce::Rectangle<float> bounds, float maxFreq) -> void;
+
+/// Decade & 6 dB grid lines matching makePathFromAnalysis
+auto drawFrequencyGrid(juce::Graphics& g, juce::Rectangle<float> bounds, float maxFreq) -> void;
+
+}  // namespace ra
@@ -1,5 +1,7 @@
 #include "LevelMeter.hpp"
 
+#include <algorithm>
+
 namespace ra {
 
 namespace {  // V = Vmax * 10^(dBFS / 20)
@@ -28,7 +30,7 @@ LevelMeter::LevelMeter()
     _range.addItemList({"-96 dB", "-90 dB", "-84 dB", "-78 dB", "-72 dB", "-66 dB", "-60 dB"}, 1);
     _range.setSelectedId(1, juce::dontSendNotification);
 
-    _unit.addItemList({"dbFS", "dbV", "V"}, 1);
+    _unit.addItemList({"dbFS", "dbV", "V", "dB SPL"}, 1);
     _unit.setSelectedId(1, juce::dontSendNotification);
 
     _refVoltage.setRange({0.0001, 2.000}, 0.0001);
@@ -38,7 +40,25 @@ LevelMeter::LevelMeter()
     _smooth.onValueChange = [this] { _smoothValue.store(static_cast<float>(_smooth.getValue())); };
     _smooth.setValue(15.0, juce::sendNotification);
 
+    _leqLabel.setJustificationType(juce::Justification::centred);
+    _leqLabel.setColour(juce::Label::backgroundColourId, juce::Colours::black);
+    _leqLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+
+    _weighting.addItemList({"A", "C", "Z"}, 1);
+    _weighting.onChange = [this] {
+        _spl.setWeighting(static_cast<FrequencyWeighting>(_weighting.getSelectedId() - 1));
+    };
+    _weighting.setSelectedId(1, juce::dontSendNotification);
+
+    _calibrate.onClick = [this] {
+        _spl.calibrate(94.0);
+        _spl.restart();
+    };
+
     addAndMakeVisible(_peakLabel);
+    addAndMakeVisible(_leqLabel);
+    addAndMakeVisible(_weighting);
+    addAndMakeVisible(_calibrate);
     addAndMakeVisible(_range);
     addAndMakeVisible(_unit);
     addAndMakeVisible(_refVoltage);
@@ -61,6 +81,25 @@ auto LevelMeter::paint(juce::Graphics& g) -> void
 
     auto const unit = _unit.getSelectedId() - 1;
 
+    if (unit == 3) {
+        // Same span as the selected dBFS range, on top of 130 dB SPL
+        auto const top    = 130.0F;
+        auto const splToY = [area, minDB, top](float dB) {
+            return juce::jmap(dB, top + minDB, top, area.getBottom(), area.getY());
+        };
+
+        for (auto i{0}; i < juce::roundToInt(-minDB); i += 10) {
+            g.drawHorizontalLine(juce::roundToInt(splToY(top - static_cast<float>(i))), area.getX(), area.getRight());
+        }
+
+        g.setColour(juce::Colours::white.withAlpha(0.95F));
+        g.fillRect(area.withHeight(4.0F).withY(splToY(static_cast<float>(_spl.fastMax()))));
+
+        g.setColour(juce::Colours::white.withAlpha(0.75F));
+        g.fillRect(area.withTop(splToY(static_cast<float>(_spl.fast()))));
+        return;
+    }
+
     if (unit < 2) {
         for (auto i{0}; i < juce::roundToInt(-minDB); i += 6) {
             auto const y = juce::roundToInt(dBToY(static_cast<float>(-i)));
@@ -68,30 +107,41 @@ auto LevelMeter::paint(juce::Graphics& g) -> void
         }
     }
 
-    auto const peakDbFS  = juce::Decibels::gainToDecibels(_peak.load());
-    auto const peakVolts = dBFSToVolts(peakDbFS, vRef);
-    auto const peakDbV   = voltsTodBV(peakVolts, vRef);
-    auto const peaks     = std::array<float, 3>{dBToY(peakDbFS), dBToY(peakDbV), voltsToY(peakVolts)};
+    // One bar per channel, side by side
+    auto const numChannels = std::max(_numChannels.load(), std::size_t(1));
+    auto const barWidth    = area.getWidth() / static_cast<float>(numChannels);
+
+    for (auto channel{0UL}; channel < numChannels; ++channel) {
+        auto const bar = area.withWidth(barWidth).withX(area.getX() + barWidth * static_cast<float>(channel));
 
-    auto const rmsDbFS  = juce::Decibels::gainToDecibels(_rms.load());
-    auto const rmsVolts = dBFSToVolts(rmsDbFS, vRef);
-    auto const rmsDbV   = voltsTodBV(rmsVolts, vRef);
-    auto const rms      = std::array<float, 3>{dBToY(rmsDbFS), dBToY(rmsDbV), voltsToY(rmsVolts)};
+        auto const peakDbFS  = juce::Decibels::gainToDecibels(_levels[channel].peak.load());
+        auto const peakVolts = dBFSToVolts(peakDbFS, vRef);
+        auto const peakDbV   = voltsTodBV(peakVolts, vRef);
+        auto const peaks     = std::array<float, 3>{dBToY(peakDbFS), dBToY(peakDbV), voltsToY(peakVolts)};
 
-    g.setColour(juce::Colours::white.withAlpha(0.95F));
-    g.fillRect(area.withHeight(4.0F).withY(peaks[static_cast<size_t>(unit)]));
+        auto const rmsDbFS  = juce::Decibels::gainToDecibels(_levels[channel].rms.load());
+        auto const rmsVolts = dBFSToVolts(rmsDbFS, vRef);
+        auto const rmsDbV   = voltsTodBV(rmsVolts, vRef);
+        auto const rms      = std::array<float, 3>{dBToY(rmsDbFS), dBToY(rmsDbV), voltsToY(rmsVolts)};
 
-    g.setColour(juce::Colours::white.withAlpha(0.75F));
-    g.fillRect(area.withTop(rms[static_cast<size_t>(unit)]));
+        g.setColour(juce::Colours::white.withAlpha(0.95F));
+        g.fillRect(bar.withHeight(4.0F).withY(peaks[static_cast<size_t>(unit)]).reduced(1.0F, 0.0F));
+
+        g.setColour(juce::Colours::white.withAlpha(0.75F));
+        g.fillRect(bar.withTop(rms[static_cast<size_t>(unit)]).reduced(1.0F, 0.0F));
+    }
 }
 
 auto LevelMeter::resized() -> void
 {
     auto area         = getLocalBounds();
-    auto widgets      = area.removeFromBottom(area.proportionOfHeight(0.2));
-    auto widgetHeight = widgets.proportionOfHeight(0.25);
+    auto widgets      = area.removeFromBottom(area.proportionOfHeight(0.3));
+    auto widgetHeight = widgets.proportionOfHeight(1.0 / 6.0);
 
     _peakLabel.setBounds(area.removeFromTop(area.proportionOfHeight(0.075)));
+    _leqLabel.setBounds(area.removeFromTop(_peakLabel.getHeight()));
+    _weighting.setBounds(widgets.removeFromTop(widgetHeight));
+    _calibrate.setBounds(widgets.removeFromTop(widgetHeight));
     _range.setBounds(widgets.removeFromTop(widgetHeight));
     _unit.setBounds(widgets.removeFromTop(widgetHeight));
     _refVoltage.setBounds(widgets.removeFromTop(widgetHeight));
@@ -102,88 +152,84 @@ auto LevelMeter::resized() -> void
 
 auto LevelMeter::timerCallback() -> void
 {
-    if (_unit.getSelectedId() < 3) {
-        auto const peakDB = juce::Decibels::gainToDecibels(_peak.load());
+    auto peak = 0.0F;
+    for (auto channel{0UL}; channel < _numChannels.load(); ++channel) {
+        peak = std::max(peak, _levels[channel].peak.load());
+    }
+
+    auto const weighting = _weighting.getText();
+    auto const leq       = _spl.leq(60.0 * si::second);
+    _leqLabel.setText("L" + weighting + "eq,1min " + juce::String(leq, 1), juce::dontSendNotification);
+
+    if (_unit.getSelectedId() == 4) {
+        auto const label = "L" + weighting + "F " + juce::String(_spl.fast(), 1) + " dB";
+        _peakLabel.setText(label, juce::sendNotification);
+    } else if (_unit.getSelectedId() < 3) {
+        auto const peakDB = juce::Decibels::gainToDecibels(peak);
         auto const label  = juce::String(peakDB, 2) + " " + _unit.getText();
         _peakLabel.setText(label, juce::sendNotification);
     } else {
-        auto const label = juce::String(_peak.load(), 2) + " " + _unit.getText();
+        auto const label = juce::String(peak, 2) + " " + _unit.getText();
         _peakLabel.setText(label, juce::sendNotification);
     }
 
     repaint();
 }
 
-auto LevelMeter::audioDeviceAboutToStart(juce::AudioIODevice* device) -> void
+auto LevelMeter::audioProducts() const -> AudioProducts { return {.levels = true}; }
+
+auto LevelMeter::audioStarted(juce::AudioIODevice& device) -> void
 {
-    auto const maxNumChannels = device->getActiveInputChannels().countNumberOfSetBits();
-    auto const blockSize      = device->getCurrentBufferSizeSamples();
-    auto const sampleRate     = device->getCurrentSampleRate();
-    auto const blockRate      = sampleRate / blockSize;
+    auto const numChannels = device.getActiveInputChannels().countNumberOfSetBits();
+    auto const blockSize   = device.getCurrentBufferSizeSamples();
+    auto const sampleRate  = device.getCurrentSampleRate();
+    auto const blockRate   = sampleRate / blockSize;
 
-    if (maxNumChannels == 0) {
+    if (numChannels == 0) {
         return;
     }
 
-    _rmsBuffer.setSize(maxNumChannels, juce::roundToInt(0.3 * sampleRate), false, true);
-    _peakFilter.prepare({blockRate, 1, 1});
+    _spl.prepare(sampleRate * si::hertz);
+
+    auto const channels = std::min(static_cast<std::size_t>(numChannels), maxChannels);
+    _peakFilter.prepare({blockRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(channels)});
     _peakFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
     _peakFilter.setCutoffFrequency(15.0F);
-    _peak.store(0.0F);
-    _rms.store(0.0F);
-    _writePosition = 0;
+
+    for (auto& level : _levels) {
+        level.peak.store(0.0F);
+        level.rms.store(0.0F);
+    }
+    _numChannels.store(channels);
 }
 
-auto LevelMeter::audioDeviceStopped() -> void
+auto LevelMeter::audioStopped() -> void
 {
-    _peak.store(0.0F);
-    _rms.store(0.0F);
+    for (auto& level : _levels) {
+        level.peak.store(0.0F);
+        level.rms.store(0.0F);
+    }
+    _numChannels.store(0);
     _peakFilter.reset();
 }
 
-auto LevelMeter::audioDeviceIOCallbackWithContext(
-    float const* const* inputChannelData,
-    int numInputChannels,
-    float* const* outputChannelData,
-    int numOutputChannels,
-    int numberOfSamples,
-    juce::AudioIODeviceCallbackContext const& context
-) -> void
+auto LevelMeter::processAudio(AudioInput const& input, AudioOutput const& output) -> void
 {
-    juce::ignoreUnused(context);
+    juce::ignoreUnused(output);
 
-    if (numInputChannels == 0) {
-        return;
+    if (auto const first = input.channel(0); not first.empty()) {
+        _spl(first);
     }
 
-    auto const input = juce::dsp::AudioBlock<float const>{
-        inputChannelData,
-        static_cast<size_t>(numInputChannels),
-        static_cast<size_t>(numberOfSamples),
-    };
-
-    auto const output = juce::dsp::AudioBlock<float>{
-        outputChannelData,
-        static_cast<size_t>(numOutputChannels),
-        static_cast<size_t>(numberOfSamples),
-    };
-
-    auto const minmax = input.findMinAndMax();
-    auto const peak   = std::max(std::abs(minmax.getStart()), std::abs(minmax.getEnd()));
+    // The dispatcher keeps the running levels of every input
     _peakFilter.setCutoffFrequency(_smoothValue.load());
-    _peak.store(_peakFilter.processSample(0, peak));
-
-    for (auto i{0}; i < numberOfSamples; ++i) {
-        for (auto channel{0}; channel < numInputChannels; ++channel) {
-            _rmsBuffer.setSample(channel, _writePosition, inputChannelData[channel][i]);
-        }
-
-        _writePosition = (_writePosition + 1) % numberOfSamples;
+    auto const channels = std::min(input.levels.size(), _numChannels.load(std::memory_order_relaxed));
+    for (auto channel{0UL}; channel < channels; ++channel) {
+        auto const& meter = input.levels[channel];
+        auto const peak   = _peakFilter.processSample(static_cast<int>(channel), meter.peak());
+        _levels[channel].peak.store(peak, std::memory_order_relaxed);
+        _levels[channel].rms.store(meter.rms(), std::memory_order_relaxed);
     }
-
-    _rms.store(_rmsBuffer.getRMSLevel(0, 0, _rmsBuffer.getNumSamples()));
-
-    output.fill(0.0F);
 }
 
 }  // namespace ra
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <ra/dsp/SoundLevelMeter.hpp>
+
+#include "application/AudioDispatcher.hpp"
+
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_dsp/juce_dsp.h>
 
@@ -8,7 +12,7 @@ namespace ra {
 struct LevelMeter final
     : juce::Component
     , juce::Timer
-    , juce::AudioIODeviceCallback
+    , AudioConsumer
 {
     LevelMeter();
     ~LevelMeter() override = default;
@@ -17,26 +21,35 @@ struct LevelMeter final
     auto resized() -> void override;
     auto timerCallback() -> void override;
 
-    auto audioDeviceAboutToStart(juce::AudioIODevice* /*device*/) -> void override;
-    auto audioDeviceStopped() -> void override;
-    auto audioDeviceIOCallbackWithContext(
-        float const* const* inputChannelData,
-        int numInputChannels,
-        float* const* outputChannelData,
-        int numOutputChannels,
-        int numberOfSamples,
-        juce::AudioIODeviceCallbackContext const& context
-    ) -> void override;
+    [[nodiscard]] auto audioProducts() const -> AudioProducts override;
+    auto audioStarted(juce::AudioIODevice& device) -> void override;
+    auto audioStopped() -> void override;
+    auto processAudio(AudioInput const& input, AudioOutput const& output) -> void override;
 
 private:
-    std::atomic<float> _peak{0.0F};
-    std::atomic<float> _rms{0.0F};
+    static constexpr auto maxChannels = std::size_t{16};
+
+    // Written by the audio thread, read by the timer & paint
+    struct Level
+    {
+        std::atomic<float> peak{0.0F};
+        std::atomic<float> rms{0.0F};
+    };
+
+    std::array<Level, maxChannels> _levels;
+    std::atomic<std::size_t> _numChannels{0};
     std::atomic<float> _smoothValue{15.0F};
-    juce::AudioBuffer<float> _rmsBuffer;
+
+    // Audio thread only, prepared while the device is stopped
     juce::dsp::StateVariableTPTFilter<float> _peakFilter;
-    int _writePosition{0};
+
+    // Measurement microphone on the first input
+    SoundLevelMeter _spl{{}};
 
     juce::Label _peakLabel;
+    juce::Label _leqLabel;
+    juce::ComboBox _weighting;
+    juce::TextButton _calibrate{"Cal 94 dB"};
     juce::ComboBox _range;
     juce::ComboBox _unit;
     juce::Slider _refVoltage{juce::Slider::IncDecButtons, juce::Slider::TextBoxRight};
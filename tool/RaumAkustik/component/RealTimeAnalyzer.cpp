@@ -0,0 +1,239 @@
+#include "RealTimeAnalyzer.hpp"
+
+#include "component/FrequencyPlot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace ra {
+
+namespace {
+
+constexpr auto windows = std::array{
+    WindowFunction::Hann,
+    WindowFunction::BlackmanHarris,
+    WindowFunction::Rectangular,
+};
+
+constexpr auto overlaps    = std::array{0.0, 0.5, 0.75};
+constexpr auto averagings  = std::array{1.0, 0.25, 0.05};
+constexpr auto fractions   = std::array{0.0, 1.0, 3.0, 6.0, 12.0, 24.0};
+constexpr auto minFftOrder = 12;
+
+template<typename T, std::size_t Size>
+[[nodiscard]] auto selected(juce::ComboBox const& box, std::array<T, Size> const& values) -> T
+{
+    return values[static_cast<std::size_t>(std::clamp(box.getSelectedId() - 1, 0, int(Size) - 1))];
+}
+
+auto makeCurve(std::span<double const> power, std::size_t fftSize, double sampleRate)
+    -> std::vector<FrequencyAndAmplitude>
+{
+    auto curve = std::vector<FrequencyAndAmplitude>(power.size());
+    for (auto k{0UL}; k < power.size(); ++k) {
+        curve[k] = FrequencyAndAmplitude{
+            .frequency = static_cast<float>(static_cast<double>(k) * sampleRate / static_cast<double>(fftSize)),
+            .amplitude = static_cast<float>(std::sqrt(power[k])),
+        };
+    }
+    return curve;
+}
+
+}  // namespace
+
+RealTimeAnalyzer::RealTimeAnalyzer() : juce::Thread{"Real-Time Analyzer"}
+{
+    _fftSizeBox.addItemList({"4096", "8192", "16384", "32768", "65536"}, 1);
+    _fftSizeBox.setSelectedId(2, juce::dontSendNotification);
+
+    _windowBox.addItemList({"Hann", "Blackman-Harris", "Rectangular"}, 1);
+    _windowBox.setSelectedId(1, juce::dontSendNotification);
+
+    _overlapBox.addItemList({"0 %", "50 %", "75 %"}, 1);
+    _overlapBox.setSelectedId(2, juce::dontSendNotification);
+
+    _averagingBox.addItemList({"No Avg", "Fast Avg", "Slow Avg"}, 1);
+    _averagingBox.setSelectedId(2, juce::dontSendNotification);
+
+    _smoothingBox.addItemList({"No Smoothing", "1/1 oct", "1/3 oct", "1/6 oct", "1/12 oct", "1/24 oct"}, 1);
+    _smoothingBox.setSelectedId(3, juce::dontSendNotification);
+
+    for (auto* box : {&_fftSizeBox, &_windowBox, &_overlapBox, &_averagingBox, &_smoothingBox}) {
+        box->onChange = [this] { updateSettings(); };
+        addAndMakeVisible(*box);
+    }
+
+    _resetPeak.onClick = [this] { _resetPeakHold.store(true); };
+    addAndMakeVisible(_resetPeak);
+
+    updateSettings();
+    startThread();
+    startTimerHz(30);
+}
+
+RealTimeAnalyzer::~RealTimeAnalyzer() { stopThread(1000); }
+
+auto RealTimeAnalyzer::audioStarted(juce::AudioIODevice& device) -> void
+{
+    _sampleRate.store(device.getCurrentSampleRate());
+}
+
+auto RealTimeAnalyzer::processAudio(AudioInput const& input, AudioOutput const& output) -> void
+{
+    juce::ignoreUnused(output);
+
+    auto const in = input.channel(0);
+    if (in.empty()) {
+        return;
+    }
+
+    // Drops the tail of the block if the worker fell behind by a whole FIFO
+    auto const scope  = _fifo.write(static_cast<int>(in.size()));
+    auto const second = std::next(in.begin(), scope.blockSize1);
+    std::copy_n(in.begin(), scope.blockSize1, std::next(_fifoBuffer.begin(), scope.startIndex1));
+    std::copy_n(second, scope.blockSize2, std::next(_fifoBuffer.begin(), scope.startIndex2));
+}
+
+void RealTimeAnalyzer::paint(juce::Graphics& g)
+{
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+
+    g.setColour(juce::Colours::black);
+    g.fillRect(_plotBounds);
+
+    auto const sampleRate = _sampleRate.load();
+    if (sampleRate <= 0.0) {
+        return;
+    }
+
+    drawFrequencyGrid(g, _plotBounds.toFloat(), static_cast<float>(sampleRate * 0.5));
+
+    g.setColour(juce::Colours::orange.withAlpha(0.6F));
+    g.strokePath(_peakPath, juce::PathStrokeType{1.0F});
+
+    g.setColour(juce::Colours::white);
+    g.strokePath(_powerPath, juce::PathStrokeType{1.5F});
+}
+
+void RealTimeAnalyzer::resized()
+{
+    auto area     = getLocalBounds();
+    auto controls = area.removeFromTop(28).reduced(2);
+    auto width    = controls.proportionOfWidth(1.0 / 6.0);
+
+    for (auto* comp : std::array<juce::Component*, 6>{
+             &_fftSizeBox,
+             &_windowBox,
+             &_overlapBox,
+             &_averagingBox,
+             &_smoothingBox,
+             &_resetPeak,
+         }) {
+        comp->setBounds(controls.removeFromLeft(width).reduced(2, 0));
+    }
+
+    _plotBounds = area.reduced(4);
+}
+
+void RealTimeAnalyzer::timerCallback()
+{
+    auto power   = std::vector<double>{};
+    auto peak    = std::vector<double>{};
+    auto fftSize = std::size_t{0};
+
+    {
+        auto const lock = std::scoped_lock{_curvesMutex};
+        if (not _curvesChanged) {
+            return;
+        }
+
+        power          = _power;
+        peak           = _peak;
+        fftSize        = _fftSize;
+        _curvesChanged = false;
+    }
+
+    auto const sampleRate = _sampleRate.load();
+    if (sampleRate <= 0.0 or fftSize == 0) {
+        return;
+    }
+
+    auto const fs     = static_cast<float>(sampleRate);
+    auto const bounds = _plotBounds.toFloat();
+    _powerPath        = makePathFromAnalysis(makeCurve(power, fftSize, sampleRate), fs, bounds);
+    _peakPath         = makePathFromAnalysis(makeCurve(peak, fftSize, sampleRate), fs, bounds);
+    repaint();
+}
+
+void RealTimeAnalyzer::run()
+{
+    while (not threadShouldExit()) {
+        {
+            auto const lock = std::scoped_lock{_settingsMutex};
+            if (_pendingSettings.has_value()) {
+                _analyzer.emplace(_pendingSettings->spec);
+                _smoothing.emplace(_analyzer->bins(), _pendingSettings->fraction);
+                _smoothed.resize(_analyzer->bins());
+                _smoothedPeak.resize(_analyzer->bins());
+                _pendingSettings.reset();
+            }
+        }
+
+        if (_resetPeakHold.exchange(false) and _analyzer.has_value()) {
+            _analyzer->resetPeakHold();
+        }
+
+        auto frames = std::size_t{0};
+        {
+            auto const scope   = _fifo.read(_fifo.getNumReady());
+            auto const analyze = [this, &frames](int start, int size) {
+                if (_analyzer.has_value() and size > 0) {
+                    auto const first = std::next(_fifoBuffer.data(), start);
+                    frames += (*_analyzer)({first, static_cast<std::size_t>(size)});
+                }
+            };
+            analyze(scope.startIndex1, scope.blockSize1);
+            analyze(scope.startIndex2, scope.blockSize2);
+        }
+
+        if (frames > 0) {
+            publish();
+        }
+
+        wait(5);
+    }
+}
+
+auto RealTimeAnalyzer::updateSettings() -> void
+{
+    auto const order = minFftOrder + std::max(_fftSizeBox.getSelectedId() - 1, 0);
+
+    auto const settings = Settings{
+        .spec =
+            SpectrumAnalyzer::Spec{
+                .fftSize   = std::size_t(1) << static_cast<std::size_t>(order),
+                .window    = selected(_windowBox, windows),
+                .overlap   = selected(_overlapBox, overlaps),
+                .averaging = selected(_averagingBox, averagings),
+            },
+        .fraction = selected(_smoothingBox, fractions),
+    };
+
+    auto const lock  = std::scoped_lock{_settingsMutex};
+    _pendingSettings = settings;
+}
+
+auto RealTimeAnalyzer::publish() -> void
+{
+    (*_smoothing)(_analyzer->power(), _smoothed);
+    (*_smoothing)(_analyzer->peakHold(), _smoothedPeak);
+
+    auto const lock = std::scoped_lock{_curvesMutex};
+    _power.assign(_smoothed.begin(), _smoothed.end());
+    _peak.assign(_smoothedPeak.begin(), _smoothedPeak.end());
+    _fftSize       = _analyzer->fftSize();
+    _curvesChanged = true;
+}
+
+}  // namespace ra
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <ra/dsp/SpectrumAnalyzer.hpp>
+
+#include "application/AudioDispatcher.hpp"
+
+#include <juce_audio_utils/juce_audio_utils.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ra {
+
+/// Welch averaged, fractional octave smoothed spectrum of the first input
+///
+/// Same threading as the spectogram, the audio thread only fills a FIFO.
+/// The worker runs the analyzer & smoothing and hands the curves to the
+/// message thread, which only builds the paths.
+struct RealTimeAnalyzer final
+    : juce::Component
+    , juce::Timer
+    , AudioConsumer
+    , juce::Thread
+{
+    RealTimeAnalyzer();
+    ~RealTimeAnalyzer() override;
+
+    auto audioStarted(juce::AudioIODevice& device) -> void override;
+    auto processAudio(AudioInput const& input, AudioOutput const& output) -> void override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void timerCallback() override;
+    void run() override;
+
+private:
+    struct Settings
+    {
+        SpectrumAnalyzer::Spec spec;
+        double fraction{3.0};
+    };
+
+    auto updateSettings() -> void;
+    auto publish() -> void;
+
+    // Two 64k frames at 192 kHz & 50% overlap
+    juce::AbstractFifo _fifo{1 << 17};
+    std::vector<float> _fifoBuffer = std::vector<float>(1UL << 17UL);
+    std::atomic<double> _sampleRate{0.0};
+
+    // Message thread -> worker
+    std::mutex _settingsMutex;
+    std::optional<Settings> _pendingSettings;
+    std::atomic<bool> _resetPeakHold{false};
+
+    // Worker only
+    std::optional<SpectrumAnalyzer> _analyzer;
+    std::optional<OctaveSmoothing> _smoothing;
+    std::vector<double> _smoothed;
+    std::vector<double> _smoothedPeak;
+
+    // Worker -> message thread
+    std::mutex _curvesMutex;
+    std::vector<double> _power;
+    std::vector<double> _peak;
+    std::size_t _fftSize{0};
+    bool _curvesChanged{false};
+
+    juce::Rectangle<int> _plotBounds;
+    juce::Path _powerPath;
+    juce::Path _peakPath;
+
+    juce::ComboBox _fftSizeBox;
+    juce::ComboBox _windowBox;
+    juce::ComboBox _overlapBox;
+    juce::ComboBox _averagingBox;
+    juce::ComboBox _smoothingBox;
+    juce::TextButton _resetPeak{"Reset Peak"};
+};
+
+}  // namespace ra
@@ -1,48 +1,82 @@
 #include "ScrollingWaveform.hpp"
 
-#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
 
 namespace ra {
 
-ScrollingWaveform::ScrollingWaveform() : juce::AudioVisualiserComponent(1)
+ScrollingWaveform::ScrollingWaveform()
 {
-    setSamplesPerBlock(64);
-    setBufferSize(2048);
+    setOpaque(true);
+    startTimerHz(30);
 }
 
-auto ScrollingWaveform::audioDeviceAboutToStart(juce::AudioIODevice* /*device*/) -> void { clear(); }
+auto ScrollingWaveform::paint(juce::Graphics& g) -> void
+{
+    g.fillAll(juce::Colours::black);
 
-auto ScrollingWaveform::audioDeviceStopped() -> void { clear(); }
+    auto const area    = getLocalBounds().toFloat();
+    auto const centerY = area.getCentreY();
+    auto const scale   = area.getHeight() * 0.5F;
+    auto const right   = area.getRight();
 
-auto ScrollingWaveform::audioDeviceIOCallbackWithContext(
-    float const* const* inputChannelData,
-    int numInputChannels,
-    float* const* outputChannelData,
-    int numOutputChannels,
-    int numberOfSamples,
-    juce::AudioIODeviceCallbackContext const& context
-) -> void
-{
-    juce::ignoreUnused(context);
+    // The newest pair is drawn at the right edge
+    g.setColour(juce::Colours::white);
+    for (auto i{0UL}; i < _numPairs; ++i) {
+        auto const& pair = _pairs[_numPairs - 1 - i];
+        auto const top   = centerY - std::clamp(pair.max, -1.0F, 1.0F) * scale;
+        auto const bot   = centerY - std::clamp(pair.min, -1.0F, 1.0F) * scale;
+        g.drawVerticalLine(static_cast<int>(right) - 1 - static_cast<int>(i), top, std::max(bot, top + 1.0F));
+    }
+
+    auto const sampleRate = _sampleRate.load();
+    if (sampleRate > 0.0) {
+        auto const samples = static_cast<double>(_overview.samplesPerPair(_level) * _pairs.size());
+        auto const seconds = samples / sampleRate;
+        auto const text    = seconds < 1.0 ? juce::String(seconds * 1000.0, 0) + " ms"  //
+                                           : juce::String(seconds, 1) + " s";
+        g.setColour(juce::Colours::white.withAlpha(0.5F));
+        g.drawText(text, getLocalBounds().reduced(4), juce::Justification::topLeft);
+    }
+}
 
-    for (int i = 0; i < numberOfSamples; ++i) {
-        float inputSample = 0;
+auto ScrollingWaveform::resized() -> void
+{
+    _pairs.resize(static_cast<std::size_t>(std::max(getWidth(), 0)));
+    _numPairs = 0;
+}
 
-        for (int chan = 0; chan < numInputChannels; ++chan) {
-            if (float const* inputChannel = inputChannelData[chan]) {
-                inputSample += inputChannel[i];  // find the sum of all the channels
-            }
-        }
+auto ScrollingWaveform::mouseWheelMove(juce::MouseEvent const& event, juce::MouseWheelDetails const& wheel) -> void
+{
+    juce::ignoreUnused(event);
 
-        pushSample(&inputSample, 1);
+    if (wheel.deltaY > 0.0F and _level > 0) {
+        --_level;
+    } else if (wheel.deltaY < 0.0F and _level + 1 < _overview.levels()) {
+        ++_level;
     }
 
-    auto const output = juce::dsp::AudioBlock<float>{
-        outputChannelData,
-        static_cast<size_t>(numOutputChannels),
-        static_cast<size_t>(numberOfSamples),
-    };
-    output.fill(0.0F);
+    timerCallback();
+}
+
+auto ScrollingWaveform::timerCallback() -> void
+{
+    _numPairs = _overview.latest(_level, _pairs);
+    repaint();
+}
+
+auto ScrollingWaveform::audioProducts() const -> AudioProducts { return {.channelSum = true}; }
+
+auto ScrollingWaveform::audioStarted(juce::AudioIODevice& device) -> void
+{
+    // The audio thread isn't running yet
+    _overview.reset();
+    _sampleRate.store(device.getCurrentSampleRate());
+}
+
+auto ScrollingWaveform::processAudio(AudioInput const& input, AudioOutput const& output) -> void
+{
+    juce::ignoreUnused(output);
+    _overview(input.sum);
 }
 
 }  // namespace ra
@@ -1,26 +1,46 @@
 #pragma once
 
+#include <ra/dsp/WaveformOverview.hpp>
+
+#include "application/AudioDispatcher.hpp"
+
 #include <juce_audio_utils/juce_audio_utils.h>
 
+#include <atomic>
+#include <vector>
+
 namespace ra {
 
+/// Min/max overview of the sum of all inputs
+///
+/// The audio thread feeds whole blocks into the mip-mapped overview, the
+/// message thread reads one pair per pixel from the level matching the
+/// zoom. The mouse wheel zooms from milliseconds to minutes.
 struct ScrollingWaveform final
-    : juce::AudioVisualiserComponent
-    , juce::AudioIODeviceCallback
+    : juce::Component
+    , juce::Timer
+    , AudioConsumer
 {
     ScrollingWaveform();
     ~ScrollingWaveform() override = default;
 
-    auto audioDeviceAboutToStart(juce::AudioIODevice* /*device*/) -> void override;
-    auto audioDeviceStopped() -> void override;
-    auto audioDeviceIOCallbackWithContext(
-        float const* const* inputChannelData,
-        int numInputChannels,
-        float* const* outputChannelData,
-        int numOutputChannels,
-        int numberOfSamples,
-        juce::AudioIODeviceCallbackContext const& context
-    ) -> void override;
+    auto paint(juce::Graphics& g) -> void override;
+    auto resized() -> void override;
+    auto mouseWheelMove(juce::MouseEvent const& event, juce::MouseWheelDetails const& wheel) -> void override;
+    auto timerCallback() -> void override;
+
+    [[nodiscard]] auto audioProducts() const -> AudioProducts override;
+    auto audioStarted(juce::AudioIODevice& device) -> void override;
+    auto processAudio(AudioInput const& input, AudioOutput const& output) -> void override;
+
+private:
+    WaveformOverview _overview{{.decimation = 16, .factor = 4, .levels = 6, .capacity = 4096}};
+    std::atomic<double> _sampleRate{0.0};
+
+    // Message thread only
+    std::vector<PeakPair> _pairs;
+    std::size_t _numPairs{0};
+    std::size_t _level{1};
 };
 
 }  // namespace ra
@@ -1,118 +1,193 @@
 #include "Spectogram.hpp"
 
+#include "look/ColorMap.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 namespace ra {
 
-Spectogram::Spectogram()
+namespace {
+
+constexpr auto minFrequency = 20.0;
+constexpr auto minDB        = -100.0F;
+constexpr auto maxDB        = 0.0F;
+
+}  // namespace
+
+Spectogram::Spectogram() : juce::Thread{"Spectogram"}
 {
     setOpaque(true);
 
+    _window.resize(static_cast<std::size_t>(fftSize));
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(
+        _window.data(),
+        static_cast<std::size_t>(fftSize),
+        juce::dsp::WindowingFunction<float>::hann,
+        false
+    );
+
+    static_assert(CividisColorMap.size() == std::tuple_size_v<decltype(_colors)>);
+    std::transform(CividisColorMap.begin(), CividisColorMap.end(), _colors.begin(), [](auto color) {
+        return juce::Colour{color}.getPixelARGB();
+    });
+
+    _columns.resize(static_cast<std::size_t>(numColumns) * imageSize, _colors.front());
+    _image.clear(_image.getBounds(), juce::Colour{CividisColorMap.front()});
+
+    startThread();
     startTimerHz(60);
     setSize(700, 500);
 }
 
-void Spectogram::audioDeviceAboutToStart(juce::AudioIODevice* /*device*/) {}
+Spectogram::~Spectogram() { stopThread(1000); }
 
-void Spectogram::audioDeviceStopped() {}
+auto Spectogram::audioStarted(juce::AudioIODevice& device) -> void
+{
+    _sampleRate.store(device.getCurrentSampleRate());
+}
 
-void Spectogram::audioDeviceIOCallbackWithContext(
-    float const* const* inputChannelData,
-    int numInputChannels,
-    float* const* outputChannelData,
-    int numOutputChannels,
-    int numberOfSamples,
-    juce::AudioIODeviceCallbackContext const& context
-)
+auto Spectogram::processAudio(AudioInput const& input, AudioOutput const& output) -> void
 {
-    juce::ignoreUnused(context);
+    juce::ignoreUnused(output);
 
-    if (numInputChannels <= 0) {
+    auto const in = input.channel(0);
+    if (in.empty()) {
         return;
     }
-    for (auto i = 0; i < numberOfSamples; ++i) {
-        pushNextSampleIntoFifo(inputChannelData[0][i]);
-    }
 
-    auto const output = juce::dsp::AudioBlock<float>{
-        outputChannelData,
-        static_cast<size_t>(numOutputChannels),
-        static_cast<size_t>(numberOfSamples),
-    };
-    output.fill(0.0F);
+    // Drops the tail of the block if the worker fell behind by a whole FIFO
+    auto const scope  = _fifo.write(static_cast<int>(in.size()));
+    auto const second = std::next(in.begin(), scope.blockSize1);
+    std::copy_n(in.begin(), scope.blockSize1, std::next(_fifoBuffer.begin(), scope.startIndex1));
+    std::copy_n(second, scope.blockSize2, std::next(_fifoBuffer.begin(), scope.startIndex2));
 }
 
 void Spectogram::paint(juce::Graphics& g)
 {
     g.fillAll(juce::Colours::black);
-
     g.setOpacity(1.0F);
-    g.drawImage(_image, getLocalBounds().toFloat());
+
+    // Oldest column on the left, the ring wraps around at _writeX
+    auto const area   = getLocalBounds();
+    auto const older  = imageSize - _writeX;
+    auto const splitX = juce::roundToInt(area.getWidth() * older / static_cast<float>(imageSize));
+
+    g.drawImage(_image, area.getX(), area.getY(), splitX, area.getHeight(), _writeX, 0, older, imageSize);
+    if (_writeX > 0) {
+        auto const x = area.getX() + splitX;
+        g.drawImage(_image, x, area.getY(), area.getWidth() - splitX, area.getHeight(), 0, 0, _writeX, imageSize);
+    }
 }
 
 void Spectogram::timerCallback()
 {
-    if (_nextBlockReady.load()) {
-        drawNextLineOfSpectrogram();
-        _nextBlockReady.store(false);
-        repaint();
+    auto const written = _columnsWritten.load(std::memory_order_acquire);
+    if (written == _columnsDrawn) {
+        return;
+    }
+
+    // Columns older than the image width would be overwritten anyway
+    auto const first = written - std::min(written - _columnsDrawn, std::size_t(imageSize));
+
+    {
+        auto bitmap = juce::Image::BitmapData{_image, juce::Image::BitmapData::writeOnly};
+        for (auto c{first}; c < written; ++c) {
+            auto const* column = std::next(_columns.data(), static_cast<std::ptrdiff_t>((c % numColumns) * imageSize));
+            for (auto y{0}; y < imageSize; ++y) {
+                *reinterpret_cast<juce::PixelARGB*>(bitmap.getPixelPointer(_writeX, y)) = column[y];  // NOLINT
+            }
+            _writeX = (_writeX + 1) % imageSize;
+        }
     }
+
+    _columnsDrawn = written;
+    repaint();
 }
 
-void Spectogram::pushNextSampleIntoFifo(float sample) noexcept
+void Spectogram::run()
 {
-    // if the fifo contains enough data, set a flag to say
-    // that the next line should now be rendered..
-    if (_fifoIndex == fftSize) {
-        if (!_nextBlockReady.load()) {
-            _fftBuffer.fill(0.0F);
-            std::copy(_fifoBuffer.begin(), _fifoBuffer.end(), _fftBuffer.begin());
-
-            // TODO: Replace when AppleClang has shift_left
-            // std::shift_left(_fifoBuffer.begin(), _fifoBuffer.end(), hopSize);
-            std::rotate(_fifoBuffer.begin(), std::next(_fifoBuffer.begin(), hopSize), _fifoBuffer.end());
-
-            _nextBlockReady.store(true);
+    while (not threadShouldExit()) {
+        if (auto const rate = _sampleRate.load(); rate > 0.0 and not juce::exactlyEqual(rate, _rowsSampleRate)) {
+            updateRows(rate);
         }
 
-        _fifoIndex -= hopSize;
-    }
+        auto const consume = [this](int start, int size) {
+            for (auto i{start}; i < start + size; ++i) {
+                _history[_historyIndex] = _fifoBuffer[static_cast<std::size_t>(i)];
+                _historyIndex           = (_historyIndex + 1) % _history.size();
+
+                if (++_pending == static_cast<std::size_t>(hopSize)) {
+                    _pending = 0;
+                    analyzeHop();
+                }
+            }
+        };
+
+        {
+            auto const scope = _fifo.read(_fifo.getNumReady());
+            consume(scope.startIndex1, scope.blockSize1);
+            consume(scope.startIndex2, scope.blockSize2);
+        }
 
-    _fifoBuffer[static_cast<size_t>(_fifoIndex++)] = sample;
+        wait(5);
+    }
 }
 
-void Spectogram::drawNextLineOfSpectrogram()
+auto Spectogram::analyzeHop() -> void
 {
-    auto const rightHandEdge = _image.getWidth() - 1;
-    auto const imageHeight   = _image.getHeight();
+    if (_rows.empty()) {
+        return;
+    }
 
-    // first, shuffle our image leftwards by 1 pixel..
-    _image.moveImageSection(0, 0, 1, 0, rightHandEdge, imageHeight);
+    // Unroll the history, the oldest sample sits at the write index
+    auto const split = std::next(_history.begin(), static_cast<std::ptrdiff_t>(_historyIndex));
+    auto const tail  = std::copy(split, _history.end(), _fftBuffer.begin());
+    std::fill(std::copy(_history.begin(), split, tail), _fftBuffer.end(), 0.0F);
 
-    // then render our FFT data..
-    _window.multiplyWithWindowingTable(_fftBuffer.data(), fftSize);
-    _fft.performFrequencyOnlyForwardTransform(_fftBuffer.data());
+    juce::FloatVectorOperations::multiply(_fftBuffer.data(), _window.data(), fftSize);
+    _fft.performFrequencyOnlyForwardTransform(_fftBuffer.data(), true);
 
-    // find the range of values produced, so we can scale our rendering to
-    // show up the detail clearly
-    auto const maxLevel = juce::FloatVectorOperations::findMinAndMax(_fftBuffer.data(), fftSize / 2);
+    // 0 dB for a full scale sine
+    auto const scale = 2.0F / std::reduce(_window.begin(), _window.end(), 0.0F);
 
-    auto const maxGain = juce::jmax(maxLevel.getEnd(), 1e-5F);
-    // auto const maxDB   = juce::Decibels::gainToDecibels(maxGain);
-    // auto const minDB   = juce::Decibels::gainToDecibels(0.0F);
+    auto const written = _columnsWritten.load(std::memory_order_relaxed);
+    auto* column       = std::next(_columns.data(), static_cast<std::ptrdiff_t>((written % numColumns) * imageSize));
 
-    for (auto y = 1; y < imageHeight; ++y) {
-        auto const skewedY = 1.0F - std::exp(std::log((float)y / (float)imageHeight) * 0.2F);
-        auto const index   = static_cast<size_t>(juce::jlimit(0, fftSize / 2, (int)(skewedY * (int)fftSize / 2)));
+    for (auto y{0UL}; y < _rows.size(); ++y) {
+        auto const& row = _rows[y];
+        auto const bins = std::next(_fftBuffer.begin(), static_cast<std::ptrdiff_t>(row.first));
+        auto const peak = *std::max_element(bins, std::next(bins, static_cast<std::ptrdiff_t>(row.last - row.first)));
 
-        auto const gain      = _fftBuffer[index];
-        auto const levelGain = juce::jmap(gain, 0.0F, maxGain, 0.0F, 1.0F);
-        auto const colorGain = juce::Colour::fromHSV(levelGain, 1.0F, levelGain, 1.0F);
+        auto const dB    = juce::Decibels::gainToDecibels(peak * scale, minDB);
+        auto const level = juce::jmap(dB, minDB, maxDB, 0.0F, static_cast<float>(_colors.size() - 1));
+        column[y]        = _colors[static_cast<std::size_t>(juce::jlimit(0, int(_colors.size() - 1), int(level)))];
+    }
 
-        // auto const dB      = juce::Decibels::gainToDecibels(gain);
-        // auto const levelDB = juce::jmap(dB, minDB, maxDB, 0.0f, 1.0f);
-        // auto const colorDB = juce::Colour::fromHSV(levelDB, 1.0f, levelDB, 1.0f);
+    _columnsWritten.store(written + 1, std::memory_order_release);
+}
 
-        _image.setPixelAt(rightHandEdge, y, colorGain);
+auto Spectogram::updateRows(double sampleRate) -> void
+{
+    auto const maxFrequency = sampleRate * 0.5;
+    auto const ratio        = maxFrequency / minFrequency;
+    auto const maxBin       = static_cast<std::size_t>(fftSize / 2);
+    auto const toBin        = [sampleRate](double frequency) { return frequency / sampleRate * fftSize; };
+
+    // Top row is the highest frequency
+    _rows.resize(static_cast<std::size_t>(imageSize));
+    for (auto y{0UL}; y < _rows.size(); ++y) {
+        auto const position = static_cast<double>(imageSize - y);
+        auto const high     = minFrequency * std::pow(ratio, position / imageSize);
+        auto const low      = minFrequency * std::pow(ratio, (position - 1.0) / imageSize);
+
+        auto const first = std::min(static_cast<std::size_t>(std::floor(toBin(low))), maxBin);
+        auto const last  = std::clamp(static_cast<std::size_t>(std::ceil(toBin(high))), first + 1, maxBin + 1);
+        _rows[y]         = Row{.first = first, .last = last};
     }
+
+    _rowsSampleRate = sampleRate;
 }
 
 }  // namespace ra
@@ -1,54 +1,84 @@
 #pragma once
 
+#include "application/AudioDispatcher.hpp"
+
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_dsp/juce_dsp.h>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <vector>
 
 namespace ra {
 
+/// Scrolling spectrogram of the first input
+///
+/// The audio thread only copies blocks into a lock-free FIFO. A worker
+/// thread computes the FFT for every hop and renders each one into a pixel
+/// column through a log-frequency row table & a colour table. The message
+/// thread copies finished columns into the image and blits it.
 struct Spectogram
     : juce::Component
     , juce::Timer
-    , juce::AudioIODeviceCallback
+    , AudioConsumer
+    , juce::Thread
 {
     Spectogram();
-    ~Spectogram() override = default;
-
-    void audioDeviceAboutToStart(juce::AudioIODevice* /*device*/) override;
-    void audioDeviceStopped() override;
-    void audioDeviceIOCallbackWithContext(
-        float const* const* inputChannelData,
-        int numInputChannels,
-        float* const* outputChannelData,
-        int numOutputChannels,
-        int numberOfSamples,
-        juce::AudioIODeviceCallbackContext const& context
-    ) override;
+    ~Spectogram() override;
+
+    auto audioStarted(juce::AudioIODevice& device) -> void override;
+    auto processAudio(AudioInput const& input, AudioOutput const& output) -> void override;
 
     void paint(juce::Graphics& g) override;
     void timerCallback() override;
-
-    void pushNextSampleIntoFifo(float sample) noexcept;
-    void drawNextLineOfSpectrogram();
+    void run() override;
 
 private:
     enum
     {
-        fftOrder = 11,
-        fftSize  = int(1U << static_cast<unsigned>(fftOrder)),
-        hopSize  = fftSize / 4,
+        fftOrder   = 11,
+        fftSize    = int(1U << static_cast<unsigned>(fftOrder)),
+        hopSize    = fftSize / 4,
+        imageSize  = 512,
+        numColumns = imageSize * 2,
+        fifoSize   = fftSize * 16,
+    };
+
+    // Bins shown in one row of the image, at least one
+    struct Row
+    {
+        std::size_t first{0};
+        std::size_t last{1};
     };
 
-    juce::Image _image{juce::Image::RGB, 512, 512, true};
+    auto analyzeHop() -> void;
+    auto updateRows(double sampleRate) -> void;
 
+    // Audio thread -> worker
+    juce::AbstractFifo _fifo{fifoSize};
+    std::vector<float> _fifoBuffer = std::vector<float>(static_cast<std::size_t>(fifoSize));
+    std::atomic<double> _sampleRate{0.0};
+
+    // Worker only
     juce::dsp::FFT _fft{fftOrder};
-    juce::dsp::WindowingFunction<float> _window{fftSize, juce::dsp::WindowingFunction<float>::hamming};
+    std::vector<float> _window;
+    std::vector<float> _history = std::vector<float>(static_cast<std::size_t>(fftSize));
+    std::vector<float> _fftBuffer = std::vector<float>(static_cast<std::size_t>(fftSize) * 2UL);
+    std::size_t _historyIndex{0};
+    std::size_t _pending{0};
+    double _rowsSampleRate{0.0};
+    std::vector<Row> _rows;
+    std::array<juce::PixelARGB, 256> _colors{};
+
+    // Worker -> message thread, a ring of finished columns
+    std::vector<juce::PixelARGB> _columns;
+    std::atomic<std::size_t> _columnsWritten{0};
 
-    int _fifoIndex{0};
-    std::atomic<bool> _nextBlockReady{false};
-    std::array<float, static_cast<size_t>(fftSize) * 2UL> _fftBuffer{};
-    std::array<float, fftSize> _fifoBuffer{};
+    // Message thread only, the image is a ring as well
+    juce::Image _image{juce::Image::ARGB, imageSize, imageSize, true};
+    std::size_t _columnsDrawn{0};
+    int _writeX{0};
 };
 
 }  // namespace ra
@@ -0,0 +1,359 @@
+#include "TransferFunctionAnalyzer.hpp"
+
+#include "component/FrequencyPlot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace ra {
+
+namespace {
+
+constexpr auto averagings    = std::array{0.5, 0.125, 0.03};
+constexpr auto minFftOrder   = 13;
+constexpr auto maxChannels   = 16;
+constexpr auto trackingHops  = std::size_t{8};
+constexpr auto magnitudeSpan = 30.0F;
+
+// One value per bin on the frequency axis of the grid, values outside of
+// [minValue, maxValue] are clamped. Jumps larger than breakAbove start a
+// new sub path, so a wrapped phase doesn't draw vertical lines.
+auto makeBinPath(
+    std::span<float const> values,
+    std::size_t fftSize,
+    float fs,
+    float minValue,
+    float maxValue,
+    juce::Rectangle<float> bounds,
+    float breakAbove = std::numeric_limits<float>::max()
+) -> juce::Path
+{
+    auto path = juce::Path{};
+    if (values.size() < 2 or fftSize == 0) {
+        return path;
+    }
+
+    path.preallocateSpace(static_cast<int>(values.size()) * 3 + 8);
+
+    auto const toY = [=](float value) {
+        return juce::jmap(std::clamp(value, minValue, maxValue), minValue, maxValue, bounds.getBottom(), bounds.getY());
+    };
+
+    auto const binWidth = fs / static_cast<float>(fftSize);
+    for (auto k{1UL}; k < values.size(); ++k) {
+        auto const frequency = static_cast<float>(k) * binWidth;
+        auto const x         = bounds.getX() + frequencyToX(1.0F, fs * 0.5F, frequency, bounds.getWidth());
+        auto const y         = toY(values[k]);
+        if (k == 1 or std::abs(values[k] - values[k - 1]) > breakAbove) {
+            path.startNewSubPath(x, y);
+        } else {
+            path.lineTo(x, y);
+        }
+    }
+
+    return path;
+}
+
+}  // namespace
+
+TransferFunctionAnalyzer::TransferFunctionAnalyzer() : juce::Thread{"Transfer Function"}
+{
+    for (auto i{1}; i <= maxChannels; ++i) {
+        _referenceBox.addItem("Ref In " + juce::String(i), i);
+        _measurementBox.addItem("Meas In " + juce::String(i), i);
+    }
+    _referenceBox.setSelectedId(1, juce::dontSendNotification);
+    _measurementBox.setSelectedId(2, juce::dontSendNotification);
+    _referenceBox.onChange   = [this] { _referenceChannel.store(_referenceBox.getSelectedId() - 1); };
+    _measurementBox.onChange = [this] { _measurementChannel.store(_measurementBox.getSelectedId() - 1); };
+
+    _fftSizeBox.addItemList({"8192", "16384", "32768", "65536"}, 1);
+    _fftSizeBox.setSelectedId(3, juce::dontSendNotification);
+    _fftSizeBox.onChange = [this] { updateSettings(); };
+
+    _averagingBox.addItemList({"Fast Avg", "Medium Avg", "Slow Avg"}, 1);
+    _averagingBox.setSelectedId(2, juce::dontSendNotification);
+    _averagingBox.onChange = [this] { updateSettings(); };
+
+    _autoDelayToggle.setToggleState(true, juce::dontSendNotification);
+    _autoDelayToggle.onClick = [this] { _autoDelay.store(_autoDelayToggle.getToggleState()); };
+    _findDelayButton.onClick = [this] { _findDelay.store(true); };
+
+    addAndMakeVisible(_referenceBox);
+    addAndMakeVisible(_measurementBox);
+    addAndMakeVisible(_fftSizeBox);
+    addAndMakeVisible(_averagingBox);
+    addAndMakeVisible(_autoDelayToggle);
+    addAndMakeVisible(_findDelayButton);
+    addAndMakeVisible(_delayLabel);
+
+    updateSettings();
+    startThread();
+    startTimerHz(30);
+}
+
+TransferFunctionAnalyzer::~TransferFunctionAnalyzer() { stopThread(1000); }
+
+auto TransferFunctionAnalyzer::audioStarted(juce::AudioIODevice& device) -> void
+{
+    _sampleRate.store(device.getCurrentSampleRate());
+}
+
+auto TransferFunctionAnalyzer::processAudio(AudioInput const& input, AudioOutput const& output) -> void
+{
+    juce::ignoreUnused(output);
+
+    auto const channel = [&input](int index) {
+        return index >= 0 ? input.channel(static_cast<std::size_t>(index)) : std::span<float const>{};
+    };
+
+    // Both streams share the FIFO indices, so they can't drift apart
+    auto const write = [](auto const& scope, std::span<float const> in, std::vector<float>& buffer) {
+        auto const first  = std::next(buffer.begin(), scope.startIndex1);
+        auto const second = std::next(buffer.begin(), scope.startIndex2);
+        if (in.empty()) {
+            std::fill_n(first, scope.blockSize1, 0.0F);
+            std::fill_n(second, scope.blockSize2, 0.0F);
+            return;
+        }
+        std::copy_n(in.begin(), scope.blockSize1, first);
+        std::copy_n(std::next(in.begin(), scope.blockSize1), scope.blockSize2, second);
+    };
+
+    auto const scope = _fifo.write(static_cast<int>(input.numSamples));
+    write(scope, channel(_referenceChannel.load()), _referenceBuffer);
+    write(scope, channel(_measurementChannel.load()), _measurementBuffer);
+}
+
+void TransferFunctionAnalyzer::paint(juce::Graphics& g)
+{
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+
+    g.setColour(juce::Colours::black);
+    g.fillRect(_magnitudeBounds);
+    g.fillRect(_phaseBounds);
+    g.fillRect(_impulseBounds);
+
+    auto const sampleRate = _sampleRate.load();
+    if (sampleRate <= 0.0) {
+        return;
+    }
+
+    auto const maxFreq = static_cast<float>(sampleRate * 0.5);
+    drawDecadeLines(g, _magnitudeBounds.toFloat(), maxFreq);
+    drawDecadeLines(g, _phaseBounds.toFloat(), maxFreq);
+
+    g.setColour(juce::Colours::white.withAlpha(0.5F));
+    g.drawHorizontalLine(_magnitudeBounds.getCentreY(), _magnitudeBounds.getX(), _magnitudeBounds.getRight());
+    g.drawHorizontalLine(_phaseBounds.getCentreY(), _phaseBounds.getX(), _phaseBounds.getRight());
+    g.drawHorizontalLine(_impulseBounds.getCentreY(), _impulseBounds.getX(), _impulseBounds.getRight());
+
+    g.setColour(juce::Colours::red.withAlpha(0.6F));
+    g.strokePath(_coherencePath, juce::PathStrokeType{1.0F});
+
+    g.setColour(juce::Colours::white);
+    g.strokePath(_magnitudePath, juce::PathStrokeType{1.5F});
+
+    g.setColour(juce::Colours::cyan);
+    g.strokePath(_phasePath, juce::PathStrokeType{1.0F});
+
+    g.setColour(juce::Colours::white);
+    g.strokePath(_impulsePath, juce::PathStrokeType{1.0F});
+}
+
+void TransferFunctionAnalyzer::resized()
+{
+    auto area     = getLocalBounds();
+    auto controls = area.removeFromTop(28).reduced(2);
+    auto width    = controls.proportionOfWidth(1.0 / 7.0);
+
+    for (auto* comp : std::array<juce::Component*, 7>{
+             &_referenceBox,
+             &_measurementBox,
+             &_fftSizeBox,
+             &_averagingBox,
+             &_autoDelayToggle,
+             &_findDelayButton,
+             &_delayLabel,
+         }) {
+        comp->setBounds(controls.removeFromLeft(width).reduced(2, 0));
+    }
+
+    area             = area.reduced(4);
+    _magnitudeBounds = area.removeFromTop(area.proportionOfHeight(0.5)).reduced(0, 2);
+    _phaseBounds     = area.removeFromTop(area.proportionOfHeight(0.5)).reduced(0, 2);
+    _impulseBounds   = area.reduced(0, 2);
+}
+
+void TransferFunctionAnalyzer::timerCallback()
+{
+    {
+        auto const lock = std::scoped_lock{_curvesMutex};
+        if (not _curvesChanged) {
+            return;
+        }
+
+        // Hands the old buffers back to the worker
+        std::swap(_shown, _curves);
+        _curvesChanged = false;
+    }
+
+    auto const sampleRate = _sampleRate.load();
+    if (sampleRate <= 0.0 or _shown.fftSize == 0) {
+        return;
+    }
+
+    auto const fs     = static_cast<float>(sampleRate);
+    auto const size   = _shown.fftSize;
+    auto const mag    = _magnitudeBounds.toFloat();
+    auto const phase  = _phaseBounds.toFloat();
+    _magnitudePath    = makeBinPath(_shown.magnitude, size, fs, -magnitudeSpan, magnitudeSpan, mag);
+    _coherencePath    = makeBinPath(_shown.coherence, size, fs, 0.0F, 1.0F, mag);
+    _phasePath        = makeBinPath(_shown.phase, size, fs, -180.0F, 180.0F, phase, 180.0F);
+    _impulsePath.clear();
+
+    // The circular response is shown from a little before the reference
+    auto const bounds = _impulseBounds.toFloat();
+    auto const count  = _shown.impulse.size() / 2;
+    auto const before = count / 8;
+    for (auto i{0UL}; i < count; ++i) {
+        auto const index = (i + _shown.impulse.size() - before) % _shown.impulse.size();
+        auto const x     = juce::jmap(float(i), 0.0F, float(count - 1), bounds.getX(), bounds.getRight());
+        auto const y     = juce::jmap(_shown.impulse[index], -1.0F, 1.0F, bounds.getBottom(), bounds.getY());
+        if (i == 0) {
+            _impulsePath.startNewSubPath(x, y);
+        } else {
+            _impulsePath.lineTo(x, y);
+        }
+    }
+
+    auto const delay = static_cast<double>(_shown.delay);
+    _delayLabel.setText(
+        juce::String(delay * 1000.0 / sampleRate, 2) + " ms (" + juce::String(_shown.delay) + ")",
+        juce::dontSendNotification
+    );
+
+    repaint();
+}
+
+void TransferFunctionAnalyzer::run()
+{
+    while (not threadShouldExit()) {
+        {
+            auto const lock = std::scoped_lock{_settingsMutex};
+            if (_pendingSpec.has_value()) {
+                auto const delay = _transferFunction.has_value() ? _transferFunction->delay() : 0UL;
+                _transferFunction.emplace(*_pendingSpec);
+                _transferFunction->setDelay(delay);
+                _h1.resize(_transferFunction->bins());
+                _coherence.resize(_transferFunction->bins());
+                _framesSinceTracking = 0;
+                _pendingSpec.reset();
+            }
+        }
+
+        auto frames = std::size_t{0};
+        {
+            auto const scope   = _fifo.read(_fifo.getNumReady());
+            auto const analyze = [this, &frames](int start, int size) {
+                if (_transferFunction.has_value() and size > 0) {
+                    auto const ref  = std::span{_referenceBuffer}.subspan(static_cast<std::size_t>(start));
+                    auto const meas = std::span{_measurementBuffer}.subspan(static_cast<std::size_t>(start));
+                    auto const num  = static_cast<std::size_t>(size);
+                    frames += (*_transferFunction)(ref.first(num), meas.first(num));
+                }
+            };
+            analyze(scope.startIndex1, scope.blockSize1);
+            analyze(scope.startIndex2, scope.blockSize2);
+        }
+
+        if (_transferFunction.has_value() and frames > 0) {
+            _framesSinceTracking += frames;
+            trackDelay();
+            publish();
+        }
+
+        wait(5);
+    }
+}
+
+auto TransferFunctionAnalyzer::updateSettings() -> void
+{
+    auto const order     = minFftOrder + std::max(_fftSizeBox.getSelectedId() - 1, 0);
+    auto const averaging = std::clamp(_averagingBox.getSelectedId() - 1, 0, int(averagings.size()) - 1);
+
+    auto const spec = TransferFunction::Spec{
+        .fftSize   = std::size_t(1) << static_cast<std::size_t>(order),
+        .window    = WindowFunction::Hann,
+        .overlap   = 0.75,
+        .averaging = averagings[static_cast<std::size_t>(averaging)],
+    };
+
+    auto const lock = std::scoped_lock{_settingsMutex};
+    _pendingSpec    = spec;
+}
+
+auto TransferFunctionAnalyzer::trackDelay() -> void
+{
+    // Let the averages settle, every correction restarts them
+    auto const requested = _findDelay.exchange(false);
+    if (not requested and (not _autoDelay.load() or _framesSinceTracking < trackingHops)) {
+        return;
+    }
+
+    _framesSinceTracking = 0;
+    auto& tf             = *_transferFunction;
+    auto const offset    = tf.findDelay();
+    if (offset == 0) {
+        return;
+    }
+
+    // The measurement can't be delayed, a lead is only taken off the reference delay
+    auto const delay = std::max(static_cast<std::ptrdiff_t>(tf.delay()) + offset, std::ptrdiff_t(0));
+    if (static_cast<std::size_t>(delay) != tf.delay()) {
+        tf.setDelay(static_cast<std::size_t>(delay));
+    }
+}
+
+auto TransferFunctionAnalyzer::publish() -> void
+{
+    auto& tf = *_transferFunction;
+    if (tf.frames() == 0) {
+        return;
+    }
+
+    tf.h1(_h1);
+    tf.coherence(_coherence);
+    auto const impulse = tf.impulseResponse();
+
+    auto const peak  = std::abs(*std::max_element(impulse.begin(), impulse.end(), [](auto l, auto r) {
+        return std::abs(l) < std::abs(r);
+    }));
+    auto const scale = peak > 0.0 ? 1.0 / peak : 1.0;
+
+    auto const lock = std::scoped_lock{_curvesMutex};
+    _curves.magnitude.resize(_h1.size());
+    _curves.phase.resize(_h1.size());
+    _curves.coherence.resize(_coherence.size());
+    _curves.impulse.resize(impulse.size());
+
+    for (auto k{0UL}; k < _h1.size(); ++k) {
+        auto const gain      = static_cast<float>(std::abs(_h1[k]));
+        _curves.magnitude[k] = juce::Decibels::gainToDecibels(gain, -magnitudeSpan * 2.0F);
+        _curves.phase[k]     = static_cast<float>(std::arg(_h1[k]) * 180.0 / std::numbers::pi);
+        _curves.coherence[k] = static_cast<float>(_coherence[k]);
+    }
+
+    std::transform(impulse.begin(), impulse.end(), _curves.impulse.begin(), [scale](auto x) {
+        return static_cast<float>(x * scale);
+    });
+
+    _curves.fftSize = tf.fftSize();
+    _curves.delay   = tf.delay();
+    _curvesChanged  = true;
+}
+
+}  // namespace ra
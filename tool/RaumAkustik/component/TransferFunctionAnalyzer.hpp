@@ -0,0 +1,103 @@
+#pragma once
+
+#include <ra/dsp/TransferFunction.hpp>
+
+#include "application/AudioDispatcher.hpp"
+
+#include <juce_audio_utils/juce_audio_utils.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <atomic>
+#include <complex>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ra {
+
+/// Live transfer function between two inputs
+///
+/// The reference is a loopback of the signal sent to the speaker, the
+/// measurement is the microphone. Shows the H1 magnitude with its
+/// coherence, the phase and the impulse response. The delay between both
+/// is found from the impulse response peak and tracked automatically.
+///
+/// Same threading as the real-time analyzer, the audio thread only fills a
+/// FIFO per stream.
+struct TransferFunctionAnalyzer final
+    : juce::Component
+    , juce::Timer
+    , AudioConsumer
+    , juce::Thread
+{
+    TransferFunctionAnalyzer();
+    ~TransferFunctionAnalyzer() override;
+
+    auto audioStarted(juce::AudioIODevice& device) -> void override;
+    auto processAudio(AudioInput const& input, AudioOutput const& output) -> void override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void timerCallback() override;
+    void run() override;
+
+private:
+    // Worker -> message thread
+    struct Curves
+    {
+        std::vector<float> magnitude;
+        std::vector<float> phase;
+        std::vector<float> coherence;
+        std::vector<float> impulse;
+        std::size_t fftSize{0};
+        std::size_t delay{0};
+    };
+
+    auto updateSettings() -> void;
+    auto trackDelay() -> void;
+    auto publish() -> void;
+
+    // 32k frames at 96 kHz & 75% overlap with plenty of headroom
+    juce::AbstractFifo _fifo{1 << 17};
+    std::vector<float> _referenceBuffer   = std::vector<float>(1UL << 17UL);
+    std::vector<float> _measurementBuffer = std::vector<float>(1UL << 17UL);
+    std::atomic<double> _sampleRate{0.0};
+    std::atomic<int> _referenceChannel{0};
+    std::atomic<int> _measurementChannel{1};
+
+    // Message thread -> worker
+    std::mutex _settingsMutex;
+    std::optional<TransferFunction::Spec> _pendingSpec;
+    std::atomic<bool> _autoDelay{true};
+    std::atomic<bool> _findDelay{false};
+
+    // Worker only
+    std::optional<TransferFunction> _transferFunction;
+    std::vector<std::complex<double>> _h1;
+    std::vector<double> _coherence;
+    std::size_t _framesSinceTracking{0};
+
+    std::mutex _curvesMutex;
+    Curves _curves;
+    bool _curvesChanged{false};
+
+    // Message thread only
+    Curves _shown;
+    juce::Rectangle<int> _magnitudeBounds;
+    juce::Rectangle<int> _phaseBounds;
+    juce::Rectangle<int> _impulseBounds;
+    juce::Path _magnitudePath;
+    juce::Path _coherencePath;
+    juce::Path _phasePath;
+    juce::Path _impulsePath;
+
+    juce::ComboBox _referenceBox;
+    juce::ComboBox _measurementBox;
+    juce::ComboBox _fftSizeBox;
+    juce::ComboBox _averagingBox;
+    juce::ToggleButton _autoDelayToggle{"Track Delay"};
+    juce::TextButton _findDelayButton{"Find Delay"};
+    juce::Label _delayLabel;
+};
+
+}  // namespace ra
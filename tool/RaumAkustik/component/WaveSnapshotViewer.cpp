@@ -0,0 +1,139 @@
+#include "WaveSnapshotViewer.hpp"
+
+#include "look/ColorMap.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace ra {
+
+WaveSnapshotViewer::WaveSnapshotViewer()
+{
+    _info.setJustificationType(juce::Justification::centredLeft);
+    _info.setColour(juce::Label::ColourIds::textColourId, juce::Colours::black);
+
+    _position.setRange(0.0, 1.0, 1.0);
+    _position.onValueChange = [this] { showFrame(static_cast<std::size_t>(_position.getValue())); };
+
+    addAndMakeVisible(_position);
+    addAndMakeVisible(_info);
+}
+
+auto WaveSnapshotViewer::open(juce::File const& file) -> void
+{
+    close();
+
+    _map = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    if (_map->getData() == nullptr or _map->getSize() < sizeof(WaveSnapshotHeader)) {
+        _map.reset();
+        return;
+    }
+
+    _header = readHeader();
+    if (_header.magic != WaveSnapshotHeader::magicBytes or _header.version != WaveSnapshotHeader::currentVersion
+        or _map->getSize() < fileSize(_header)) {
+        _map.reset();
+        return;
+    }
+
+    _frame.resize(std::size_t{_header.width} * std::size_t{_header.height});
+    _image = juce::Image{juce::Image::ARGB, static_cast<int>(_header.width), static_cast<int>(_header.height), true};
+
+    // The file may still be written to, poll for new frames
+    startTimerHz(10);
+    timerCallback();
+}
+
+auto WaveSnapshotViewer::close() -> void
+{
+    stopTimer();
+    _map.reset();
+    _header = {};
+    _position.setRange(0.0, 1.0, 1.0);
+    _info.setText({}, juce::dontSendNotification);
+}
+
+auto WaveSnapshotViewer::paint(juce::Graphics& g) -> void
+{
+    auto area = getLocalBounds().toFloat();
+    area.removeFromBottom(static_cast<float>(_position.getHeight()));
+
+    g.setColour(juce::Colours::white);
+    g.fillRect(area);
+    g.drawImage(_image, area.reduced(4.0F), juce::RectanglePlacement::centred);
+}
+
+auto WaveSnapshotViewer::resized() -> void
+{
+    auto area   = getLocalBounds();
+    auto bottom = area.removeFromBottom(24);
+    _info.setBounds(bottom.removeFromLeft(bottom.proportionOfWidth(0.3)));
+    _position.setBounds(bottom);
+}
+
+auto WaveSnapshotViewer::timerCallback() -> void
+{
+    if (_map == nullptr) {
+        return;
+    }
+
+    auto const header = readHeader();
+    if (header.frameCount == _header.frameCount and _position.getMaximum() > 1.0) {
+        return;
+    }
+
+    auto const wasAtEnd = _position.getValue() >= _position.getMaximum();
+    _header.frameCount  = header.frameCount;
+
+    auto const numFrames = static_cast<double>(_header.frameCount);
+    _position.setRange(0.0, std::max(numFrames - 1.0, 1.0), 1.0);
+    if (wasAtEnd) {
+        _position.setValue(_position.getMaximum(), juce::sendNotificationSync);
+    }
+
+    if (_header.frameCount == _header.capacity) {
+        stopTimer();
+    }
+}
+
+auto WaveSnapshotViewer::readHeader() const -> WaveSnapshotHeader
+{
+    auto header = WaveSnapshotHeader{};
+    std::memcpy(&header, _map->getData(), sizeof(header));
+
+    // Records up to frameCount are complete once the header is seen
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return header;
+}
+
+auto WaveSnapshotViewer::showFrame(std::size_t index) -> void
+{
+    if (_map == nullptr or index >= _header.frameCount) {
+        return;
+    }
+
+    auto const* data  = static_cast<std::byte const*>(_map->getData());
+    auto const offset = static_cast<std::ptrdiff_t>(recordOffset(_header, index));
+    auto const record = std::span{std::next(data, offset), recordSize(_header)};
+    auto const info   = decodeWaveSnapshot(_header, record, _frame);
+
+    auto const absLess = [](auto l, auto r) { return std::abs(l) < std::abs(r); };
+    auto const peak    = std::max(std::abs(*std::max_element(_frame.begin(), _frame.end(), absLess)), 1e-9F);
+    auto const height  = static_cast<std::size_t>(_header.height);
+    auto const maxIdx  = static_cast<float>(BondColorMap.size() - 1U);
+
+    for (auto x{0}; x < _image.getWidth(); ++x) {
+        for (auto y{0}; y < _image.getHeight(); ++y) {
+            auto const val   = _frame[static_cast<std::size_t>(x) * height + static_cast<std::size_t>(y)];
+            auto const t     = static_cast<std::size_t>(juce::jmap(val, -peak, peak, 0.0F, maxIdx));
+            auto const color = BondColorMap[std::clamp(t, std::size_t(0), BondColorMap.size() - 1U)];
+            _image.setPixelAt(x, y, color);
+        }
+    }
+
+    auto const seconds = static_cast<double>(info.timeStep) / _header.sampleRate;
+    _info.setText(juce::String(seconds * 1'000.0, 2) + " ms", juce::dontSendNotification);
+    repaint();
+}
+
+}  // namespace ra
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <ra/acoustic/WaveSnapshot.hpp>
+
+#include <juce_gui_extra/juce_gui_extra.h>
+
+namespace ra {
+
+/// Scrubs through a file written by WaveSnapshotRecorder. Only the header
+/// and the currently displayed record are touched, so recordings larger
+/// than RAM can be viewed while they are still being written.
+struct WaveSnapshotViewer final
+    : juce::Component
+    , juce::Timer
+{
+    WaveSnapshotViewer();
+    ~WaveSnapshotViewer() override = default;
+
+    auto open(juce::File const& file) -> void;
+    auto close() -> void;
+
+    auto paint(juce::Graphics& g) -> void override;
+    auto resized() -> void override;
+    auto timerCallback() -> void override;
+
+private:
+    [[nodiscard]] auto readHeader() const -> WaveSnapshotHeader;
+    auto showFrame(std::size_t index) -> void;
+
+    std::unique_ptr<juce::MemoryMappedFile> _map;
+    WaveSnapshotHeader _header;
+    std::vector<float> _frame;
+    juce::Image _image{juce::Image::ARGB, 1, 1, true};
+
+    juce::Slider _position{juce::Slider::LinearHorizontal, juce::Slider::TextBoxRight};
+    juce::Label _info;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveSnapshotViewer)  // NOLINT
+};
+
+}  // namespace ra
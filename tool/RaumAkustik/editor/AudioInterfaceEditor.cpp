@@ -2,23 +2,26 @@
 
 namespace ra {
 
-AudioInterfaceEditor::AudioInterfaceEditor(juce::AudioDeviceManager& deviceManager)
-    : _deviceManager{deviceManager}
+AudioInterfaceEditor::AudioInterfaceEditor(juce::AudioDeviceManager& deviceManager, AudioDispatcher& dispatcher)
+    : _dispatcher{dispatcher}
     , _deviceSelector{deviceManager, 0, 256, 0, 256, true, true, true, false}
 {
     addAndMakeVisible(_deviceSelector);
     addAndMakeVisible(_latencyTester);
     addAndMakeVisible(_spectogram);
+    addAndMakeVisible(_analyzer);
     addAndMakeVisible(_noise);
 
-    _deviceManager.addAudioCallback(&_spectogram);
-    _deviceManager.addAudioCallback(&_noise);
+    _dispatcher.add(_spectogram, "Spectogram");
+    _dispatcher.add(_analyzer, "Real-Time Analyzer");
+    _dispatcher.add(_noise, "Noise Generator");
 }
 
 AudioInterfaceEditor::~AudioInterfaceEditor()
 {
-    _deviceManager.removeAudioCallback(&_spectogram);
-    _deviceManager.removeAudioCallback(&_noise);
+    _dispatcher.remove(_spectogram);
+    _dispatcher.remove(_analyzer);
+    _dispatcher.remove(_noise);
 }
 
 auto AudioInterfaceEditor::paint(juce::Graphics& /*g*/) -> void {}
@@ -31,7 +34,8 @@ auto AudioInterfaceEditor::resized() -> void
     _deviceSelector.setBounds(left.removeFromTop(left.proportionOfHeight(0.75)));
     _noise.setBounds(left);
 
-    _spectogram.setBounds(area.removeFromTop(area.proportionOfHeight(0.5)));
+    _spectogram.setBounds(area.removeFromTop(area.proportionOfHeight(0.33)));
+    _analyzer.setBounds(area.removeFromTop(area.proportionOfHeight(0.5)));
     _latencyTester.setBounds(area);
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "application/AudioDispatcher.hpp"
+#include "component/RealTimeAnalyzer.hpp"
 #include "component/Spectogram.hpp"
 #include "tool/LatencyTester.hpp"
 #include "tool/NoiseGenerator.hpp"
@@ -12,17 +14,18 @@ namespace ra {
 
 struct AudioInterfaceEditor final : juce::Component
 {
-    explicit AudioInterfaceEditor(juce::AudioDeviceManager& deviceManager);
+    AudioInterfaceEditor(juce::AudioDeviceManager& deviceManager, AudioDispatcher& dispatcher);
     ~AudioInterfaceEditor() override;
 
     auto paint(juce::Graphics& g) -> void override;
     auto resized() -> void override;
 
 private:
-    juce::AudioDeviceManager& _deviceManager;
+    AudioDispatcher& _dispatcher;
     juce::AudioDeviceSelectorComponent _deviceSelector;
-    LatencyTesterEditor _latencyTester{_deviceManager};
+    LatencyTesterEditor _latencyTester{_dispatcher};
     Spectogram _spectogram;
+    RealTimeAnalyzer _analyzer;
     NoiseGenerator _noise;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioInterfaceEditor)  // NOLINT
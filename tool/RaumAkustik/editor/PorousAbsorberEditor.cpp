@@ -7,6 +7,9 @@
 #include <ra/unit/pressure.hpp>
 #include <ra/unit/temperature.hpp>
 
+#include <array>
+#include <functional>
+
 namespace ra {
 
 namespace {
@@ -15,6 +18,11 @@ auto positionForFrequency(quantity<isq::frequency[si::hertz]> const freq) noexce
     return (std::log(freq.numerical_value_in(si::hertz) / 20.0) / std::numbers::ln2) / 10.0;
 }
 
+auto hashCombine(std::size_t seed, std::size_t value) noexcept -> std::size_t
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U));
+}
+
 }  // namespace
 
 auto PorousAbsorberEditor::createDefault(juce::ValueTree parent, juce::UndoManager* um) -> juce::ValueTree
@@ -39,8 +47,9 @@ auto PorousAbsorberEditor::createDefault(juce::ValueTree parent, juce::UndoManag
     return tree;
 }
 
-PorousAbsorberEditor::PorousAbsorberEditor(juce::ValueTree vt, juce::UndoManager* um)
-    : _undoManager{um}
+PorousAbsorberEditor::PorousAbsorberEditor(juce::ThreadPool& threadPool, juce::ValueTree vt, juce::UndoManager* um)
+    : _threadPool{threadPool}
+    , _undoManager{um}
     , _valueTree{std::move(vt)}
 {
     using juce::SliderPropertyComponent;
@@ -49,6 +58,9 @@ PorousAbsorberEditor::PorousAbsorberEditor(juce::ValueTree vt, juce::UndoManager
 
     addAndMakeVisible(_table);
     addAndMakeVisible(_absorberSpecs);
+    addAndMakeVisible(_optimize);
+
+    _optimize.onClick = [this] { optimize(); };
 
     _table.getHeader().addColumn("Frequency", 1, 100, 100);
     _table.getHeader().addColumn("Absorption No Gap", 2, 150, 150);
@@ -94,6 +106,13 @@ PorousAbsorberEditor::PorousAbsorberEditor(juce::ValueTree vt, juce::UndoManager
     updateSimulation();
 }
 
+PorousAbsorberEditor::~PorousAbsorberEditor()
+{
+    // A running job finishes its current sweep and drops the result
+    auto const lock = std::scoped_lock{_worker->mutex};
+    _worker->pending.reset();
+}
+
 auto PorousAbsorberEditor::paint(juce::Graphics& g) -> void
 {
     juce::Graphics::ScopedSaveState const state{g};
@@ -123,10 +142,11 @@ auto PorousAbsorberEditor::paint(juce::Graphics& g) -> void
     auto withAirGapPath = juce::Path{};
     withAirGapPath.startNewSubPath(_plotArea.getBottomLeft().toFloat());
 
-    for (auto const& p : _props) {
-        auto posX     = _plotArea.getX() + _plotArea.getWidth() * positionForFrequency(p.first);
-        auto noGapY   = _plotArea.getBottom() - _plotArea.getHeight() * p.second.absorptionFactorNoAirGap;
-        auto withGapY = _plotArea.getBottom() - _plotArea.getHeight() * p.second.absorptionFactorWithAirGap;
+    for (auto i{0UL}; i < _sweep->frequency.size(); ++i) {
+        auto freq     = _sweep->frequency[i] * si::hertz;
+        auto posX     = _plotArea.getX() + _plotArea.getWidth() * positionForFrequency(freq);
+        auto noGapY   = _plotArea.getBottom() - _plotArea.getHeight() * _sweep->noAirGap[i];
+        auto withGapY = _plotArea.getBottom() - _plotArea.getHeight() * _sweep->withAirGap[i];
         noAirGapPath.lineTo(juce::Point{posX, noGapY}.toFloat());
         withAirGapPath.lineTo(juce::Point{posX, withGapY}.toFloat());
     }
@@ -138,12 +158,23 @@ auto PorousAbsorberEditor::paint(juce::Graphics& g) -> void
     withAirGapPath = withAirGapPath.createPathWithRoundedCorners(5.0F);
     g.setColour(juce::Colours::red);
     g.strokePath(withAirGapPath, juce::PathStrokeType{2.0F});
+
+    g.setColour(juce::Colours::blue);
+    for (auto i{0UL}; i < _sweep->bands.size(); ++i) {
+        auto const lower = positionForFrequency(_sweep->bands[i] * std::pow(2.0, -1.0 / 6.0));
+        auto const upper = positionForFrequency(_sweep->bands[i] * std::pow(2.0, 1.0 / 6.0));
+        auto const left  = static_cast<float>(_plotArea.getX() + _plotArea.getWidth() * lower);
+        auto const right = static_cast<float>(_plotArea.getX() + _plotArea.getWidth() * upper);
+        auto const y     = static_cast<float>(_plotArea.getBottom() - _plotArea.getHeight() * _sweep->diffuse[i]);
+        g.drawLine(left, y, right, y, 2.0F);
+    }
 }
 
 auto PorousAbsorberEditor::resized() -> void
 {
     auto area = getLocalBounds();
     _absorberSpecs.setBounds(area.removeFromTop(area.proportionOfHeight(0.4)));
+    _optimize.setBounds(area.removeFromTop(30).removeFromLeft(150).reduced(10, 2));
 
     _plotArea = area.removeFromLeft(area.proportionOfWidth(0.5)).reduced(10);
     _table.setBounds(area.reduced(10));
@@ -155,7 +186,7 @@ auto PorousAbsorberEditor::valueTreePropertyChanged(juce::ValueTree& /*tree*/, j
     updateSimulation();
 }
 
-auto PorousAbsorberEditor::getNumRows() -> int { return static_cast<int>(_props.size()); }
+auto PorousAbsorberEditor::getNumRows() -> int { return static_cast<int>(_sweep->frequency.size()); }
 
 auto PorousAbsorberEditor::paintRowBackground(
     juce::Graphics& g,
@@ -182,17 +213,17 @@ auto PorousAbsorberEditor::paintCell(juce::Graphics& g, int row, int column, int
     g.setFont(16.0F);
 
     if (column == 1) {
-        auto const frequency = juce::String{_props[static_cast<size_t>(row)].first.numerical_value_in(si::hertz)};
+        auto const frequency = juce::String{_sweep->frequency[static_cast<size_t>(row)]};
         g.drawText(frequency, 2, 0, width - 4, height, juce::Justification::centredLeft, true);
     }
 
     if (column == 2) {
-        auto const absorptionFactor = juce::String{_props[static_cast<size_t>(row)].second.absorptionFactorNoAirGap};
+        auto const absorptionFactor = juce::String{_sweep->noAirGap[static_cast<size_t>(row)]};
         g.drawText(absorptionFactor, 2, 0, width - 4, height, juce::Justification::centredLeft, true);
     }
 
     if (column == 3) {
-        auto const absorptionFactor = juce::String{_props[static_cast<size_t>(row)].second.absorptionFactorWithAirGap};
+        auto const absorptionFactor = juce::String{_sweep->withAirGap[static_cast<size_t>(row)]};
         g.drawText(absorptionFactor, 2, 0, width - 4, height, juce::Justification::centredLeft, true);
     }
 
@@ -200,32 +231,182 @@ auto PorousAbsorberEditor::paintCell(juce::Graphics& g, int row, int column, int
     g.fillRect(width - 1, 0, 1, height);
 }
 
-auto PorousAbsorberEditor::updateSimulation() -> void
+auto PorousAbsorberEditor::RequestHash::operator()(Request const& request) const noexcept -> std::size_t
+{
+    auto seed = std::hash<std::size_t>{}(request.numPoints);
+    for (auto const value : {
+             request.thickness,
+             request.flowResisitivity,
+             request.airGap,
+             request.temperature,
+             request.pressure,
+             request.angle,
+             request.startFrequency,
+             request.subDivisions,
+         }) {
+        seed = hashCombine(seed, std::hash<double>{}(value));
+    }
+    return seed;
+}
+
+auto PorousAbsorberEditor::makeRequest() const -> Request
 {
-    _props.clear();
+    return Request{
+        .thickness        = _absorberThickness,
+        .flowResisitivity = _absorberFlowResisitivity,
+        .airGap           = _absorberAirGap,
+        .temperature      = _temperature,
+        .pressure         = _pressure,
+        .angle            = _absorberAngleOfIncidence,
+        .startFrequency   = _plotStartFrequency,
+        .subDivisions     = _plotOctaveSubdivision,
+        .numPoints        = static_cast<std::size_t>(std::max(static_cast<double>(_plotNumPoints), 0.0)),
+    };
+}
 
+auto PorousAbsorberEditor::compute(Request const& request) -> Sweep
+{
     auto const specs = PorousAbsorberSpecs{
-        double{_absorberThickness} * si::milli<si::metre>,
-        double{_absorberFlowResisitivity},
-        double{_absorberAirGap} * si::milli<si::metre>,
+        request.thickness * si::milli<si::metre>,
+        request.flowResisitivity,
+        request.airGap * si::milli<si::metre>,
     };
 
-    auto const angle = static_cast<double>(_absorberAngleOfIncidence);
+    auto const angle = std::array{request.angle};
 
     auto const env = AtmosphericEnvironment{
-        celciusToKelvin(_temperature),
-        static_cast<double>(_pressure) * OneAtmosphere<double>,
+        celciusToKelvin(request.temperature),
+        request.pressure * OneAtmosphere<double>,
     };
 
-    auto const startFrequency = static_cast<double>(_plotStartFrequency) * si::hertz;
-    auto const subDivisions   = static_cast<double>(_plotOctaveSubdivision);
+    auto const startFrequency = request.startFrequency * si::hertz;
+    auto const numPoints      = request.numPoints;
+
+    auto sweep = Sweep{};
+    sweep.frequency.resize(numPoints);
+    sweep.noAirGap.resize(numPoints);
+    sweep.withAirGap.resize(numPoints);
+
+    for (auto i{0UL}; i < numPoints; ++i) {
+        auto const frequency = oactaveSubdivision(startFrequency, request.subDivisions, static_cast<double>(i));
+        sweep.frequency[i]   = frequency.numerical_value_in(si::hertz);
+    }
+
+    propertiesOfAbsorber(specs, env, sweep.frequency, angle, {
+        .absorptionFactorNoAirGap   = sweep.noAirGap,
+        .absorptionFactorWithAirGap = sweep.withAirGap,
+    });
+
+    sweep.bands   = thirdOctaveBands(20.0 * si::hertz, 20'000.0 * si::hertz);
+    sweep.diffuse = diffuseFieldAbsorption(specs, env, sweep.bands);
+
+    return sweep;
+}
+
+auto PorousAbsorberEditor::updateSimulation() -> void
+{
+    auto const request = makeRequest();
+    if (auto const* cached = _cache.find(request); cached != nullptr) {
+        // A sweep still queued for an older request would replace this one
+        {
+            auto const lock  = std::scoped_lock{_worker->mutex};
+            _worker->pending = std::nullopt;
+        }
+        publish(request, *cached);
+        return;
+    }
+
+    {
+        auto const lock  = std::scoped_lock{_worker->mutex};
+        _worker->pending = request;
+        if (std::exchange(_worker->running, true)) {
+            return;
+        }
+    }
+
+    _threadPool.addJob([worker = _worker, editor = juce::Component::SafePointer{this}] {
+        while (true) {
+            auto request = Request{};
+            {
+                auto const lock = std::scoped_lock{worker->mutex};
+                if (not worker->pending.has_value()) {
+                    worker->running = false;
+                    return;
+                }
+                request = *std::exchange(worker->pending, std::nullopt);
+            }
+
+            auto sweep = std::make_shared<Sweep const>(compute(request));
+            juce::MessageManager::callAsync([editor, request, sweep = std::move(sweep)] {
+                if (editor != nullptr) {
+                    editor->publish(request, sweep);
+                }
+            });
+        }
+    });
+}
+
+auto PorousAbsorberEditor::publish(Request const& request, std::shared_ptr<Sweep const> sweep) -> void
+{
+    _cache.insert(request, sweep);
 
-    for (auto i{0}; i < static_cast<int>(_plotNumPoints); ++i) {
-        auto const frequency = oactaveSubdivision(startFrequency, subDivisions, static_cast<double>(i));
-        _props.emplace_back(frequency, propertiesOfAbsorber(specs, env, frequency, angle));
+    // The parameters may have changed while the sweep was computed
+    if (request != makeRequest()) {
+        return;
     }
 
+    _sweep = std::move(sweep);
     _table.updateContent();
     repaint();
 }
+
+auto PorousAbsorberEditor::optimize() -> void
+{
+    // Best mean bass absorption without getting deeper than the current design
+    auto const depth = double{_absorberThickness} + double{_absorberAirGap};
+
+    auto const env = AtmosphericEnvironment{
+        celciusToKelvin(_temperature),
+        static_cast<double>(_pressure) * OneAtmosphere<double>,
+    };
+
+    auto spec = AbsorberOptimizer::Spec{
+        .environment      = env,
+        .thickness        = {10.0 * si::milli<si::metre>, depth * si::milli<si::metre>},
+        .flowResisitivity = {1'000.0, 40'000.0},
+        .airGap           = {0.0 * si::milli<si::metre>, depth * si::milli<si::metre>},
+        .maxDepth         = depth * si::milli<si::metre>,
+        .angle            = static_cast<double>(_absorberAngleOfIncidence),
+        .candidates       = 200'000,
+    };
+    for (auto const band : thirdOctaveBands(63.0 * si::hertz, 250.0 * si::hertz)) {
+        spec.frequencies.push_back(band.numerical_value_in(si::hertz));
+    }
+
+    _optimize.setEnabled(false);
+
+    // The editor may be rebuilt while the search runs
+    _threadPool.addJob([spec, editor = juce::Component::SafePointer{this}] {
+        auto const front = AbsorberOptimizer{spec}();
+
+        juce::MessageManager::callAsync([front, editor] {
+            if (editor == nullptr) {
+                return;
+            }
+
+            editor->_optimize.setEnabled(true);
+            if (front.empty()) {
+                return;
+            }
+
+            auto const& best     = front.back();
+            auto const thickness = best.specs.thickness.numerical_value_in(si::milli<si::metre>);
+            auto const airGap    = best.specs.airGap.numerical_value_in(si::milli<si::metre>);
+            auto* undoManager    = editor->_undoManager;
+            editor->_absorberThickness.setValue(thickness, undoManager);
+            editor->_absorberFlowResisitivity.setValue(std::round(best.specs.flowResisitivity), undoManager);
+            editor->_absorberAirGap.setValue(airGap, undoManager);
+        });
+    });
+}
 }  // namespace ra
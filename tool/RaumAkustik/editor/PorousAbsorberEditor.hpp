@@ -1,9 +1,17 @@
 #pragma once
 
+#include <ra/acoustic/absorber/AbsorberOptimizer.hpp>
+#include <ra/acoustic/absorber/DiffuseFieldAbsorption.hpp>
 #include <ra/acoustic/absorber/PorousAbsorber.hpp>
 
+#include "utility/LruCache.hpp"
+
 #include <juce_gui_extra/juce_gui_extra.h>
 
+#include <memory>
+#include <mutex>
+#include <optional>
+
 namespace ra {
 
 struct PorousAbsorberEditor final
@@ -11,8 +19,8 @@ struct PorousAbsorberEditor final
     , juce::TableListBoxModel
     , juce::ValueTree::Listener
 {
-    PorousAbsorberEditor(juce::ValueTree vt, juce::UndoManager* um);
-    ~PorousAbsorberEditor() override = default;
+    PorousAbsorberEditor(juce::ThreadPool& threadPool, juce::ValueTree vt, juce::UndoManager* um);
+    ~PorousAbsorberEditor() override;
 
     auto paint(juce::Graphics& g) -> void override;
     auto resized() -> void override;
@@ -43,9 +51,58 @@ private:
 
     auto valueTreePropertyChanged(juce::ValueTree& tree, juce::Identifier const& property) -> void override;
 
+    /// Every parameter a sweep depends on
+    struct Request
+    {
+        double thickness{0};
+        double flowResisitivity{0};
+        double airGap{0};
+        double temperature{0};
+        double pressure{0};
+        double angle{0};
+        double startFrequency{0};
+        double subDivisions{0};
+        std::size_t numPoints{0};
+
+        auto operator==(Request const& other) const -> bool = default;
+    };
+
+    struct RequestHash
+    {
+        [[nodiscard]] auto operator()(Request const& request) const noexcept -> std::size_t;
+    };
+
+    struct Sweep
+    {
+        std::vector<double> frequency;
+        std::vector<double> noAirGap;
+        std::vector<double> withAirGap;
+
+        /// Random-incidence absorption in third-octave bands
+        std::vector<quantity<isq::frequency[si::hertz]>> bands;
+        std::vector<double> diffuse;
+    };
+
+    /// Shared with the background job. Requests arriving while a sweep is
+    /// computed replace each other, only the latest one runs next.
+    struct Worker
+    {
+        std::mutex mutex;
+        std::optional<Request> pending;
+        bool running{false};
+    };
+
+    [[nodiscard]] auto makeRequest() const -> Request;
+    [[nodiscard]] static auto compute(Request const& request) -> Sweep;
+
     auto updateSimulation() -> void;
+    auto publish(Request const& request, std::shared_ptr<Sweep const> sweep) -> void;
+    auto optimize() -> void;
+
+    juce::ThreadPool& _threadPool;
 
     juce::TableListBox _table{"Table", this};
+    juce::TextButton _optimize{"Optimize"};
     juce::PropertyPanel _absorberSpecs;
     juce::Rectangle<int> _plotArea;
 
@@ -64,7 +121,10 @@ private:
     juce::CachedValue<double> _plotStartFrequency{_valueTree, IDs::plotStartFrequency, _undoManager};
     juce::CachedValue<double> _plotOctaveSubdivision{_valueTree, IDs::plotOctaveSubdivision, _undoManager};
 
-    std::vector<std::pair<quantity<isq::frequency[si::hertz]>, PorousAbsorberProperties>> _props;
+    /// Result of a recomputation, immutable once published
+    std::shared_ptr<Sweep const> _sweep{std::make_shared<Sweep const>()};
+    LruCache<Request, std::shared_ptr<Sweep const>, RequestHash> _cache{64};
+    std::shared_ptr<Worker> _worker{std::make_shared<Worker>()};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PorousAbsorberEditor)  // NOLINT
 };
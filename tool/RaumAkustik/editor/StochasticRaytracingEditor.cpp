@@ -1,12 +1,36 @@
 #include "StochasticRaytracingEditor.hpp"
 
+#include "tool/AudioFile.hpp"
 #include "tool/PropertyComponent.hpp"
 
 #include <iostream>
 #include <juce_audio_basics/juce_audio_basics.h>
+#include <neo_core/neo_core.hpp>
 
 namespace ra {
 
+namespace {
+
+auto frequencies() -> std::vector<quantity<isq::frequency[si::hertz]>>
+{
+    using si::unit_symbols::Hz;
+
+    return {
+        31.25 * Hz,
+        62.5 * Hz,
+        125.0 * Hz,
+        250.0 * Hz,
+        500.0 * Hz,
+        1000.0 * Hz,
+        2000.0 * Hz,
+        4000.0 * Hz,
+        8000.0 * Hz,
+        16'000.0 * Hz,
+    };
+}
+
+}  // namespace
+
 StochasticRaytracingEditor::StochasticRaytracingEditor(juce::ThreadPool& threadPool, RoomEditor& roomEditor)
     : _threadPool{threadPool}
     , _roomEditor{roomEditor}
@@ -19,9 +43,12 @@ StochasticRaytracingEditor::StochasticRaytracingEditor(juce::ThreadPool& threadP
     });
 
     _render.onClick = [this] { run(); };
+    _hybrid.onClick = [this] { runHybrid(); };
 
     addAndMakeVisible(_properties);
     addAndMakeVisible(_render);
+    addAndMakeVisible(_hybrid);
+    addAndMakeVisible(_hybridInfo);
     for (auto i{0}; i < 10; ++i) {
         addAndMakeVisible(_plots.add(std::make_unique<Plot>()));
     }
@@ -45,8 +72,10 @@ auto StochasticRaytracingEditor::resized() -> void
     auto area = getLocalBounds();
 
     auto panel = area.removeFromRight(area.proportionOfWidth(0.175));
-    _properties.setBounds(panel.removeFromTop(panel.proportionOfHeight(0.9)));
-    _render.setBounds(panel);
+    _properties.setBounds(panel.removeFromTop(panel.proportionOfHeight(0.85)));
+    _render.setBounds(panel.removeFromTop(panel.proportionOfHeight(1.0 / 3.0)));
+    _hybrid.setBounds(panel.removeFromTop(panel.proportionOfHeight(0.5)));
+    _hybridInfo.setBounds(panel);
 
     auto top   = area.removeFromTop(area.proportionOfHeight(0.5));
     auto width = area.proportionOfWidth(1.0 / 5.0);
@@ -66,31 +95,8 @@ auto StochasticRaytracingEditor::resized() -> void
     _plots[9]->setBounds(area.removeFromLeft(width).reduced(8.0F));
 }
 
-auto StochasticRaytracingEditor::run() -> void
+auto StochasticRaytracingEditor::makeRoom() const -> StochasticRaytracing::Room
 {
-    using si::unit_symbols::Hz;
-
-    auto const frequencies = std::vector<quantity<isq::frequency[si::hertz]>>{
-        31.25 * Hz,
-        62.5 * Hz,
-        125.0 * Hz,
-        250.0 * Hz,
-        500.0 * Hz,
-        1000.0 * Hz,
-        2000.0 * Hz,
-        4000.0 * Hz,
-        8000.0 * Hz,
-        16'000.0 * Hz,
-    };
-
-    auto const simulation = StochasticRaytracing::Simulation{
-        .frequencies = frequencies,
-        .duration    = static_cast<double>(_duration.getValue()) * si::second,
-        .timeStep    = 0.001 * si::second,
-        .radius      = 0.0875 * si::metre,
-        .rays        = static_cast<size_t>(static_cast<double>(_rays.getValue())),
-    };
-
     auto const roomLayout      = _roomEditor.getRoomLayout();
     auto const paintedConcrete = std::vector{0.01, 0.01, 0.01, 0.05, 0.06, 0.07, 0.09, 0.08, 0.08, 0.08};
     auto const woodFloor       = std::vector{0.15, 0.15, 0.15, 0.11, 0.1, 0.07, 0.06, 0.07, 0.07, 0.07};
@@ -111,7 +117,7 @@ auto StochasticRaytracingEditor::run() -> void
         .floor   = {0.01, 0.01, 0.01, 0.05, 0.1, 0.2,  0.3, 0.5, 0.5, 0.5},
     };
 
-    auto const room = StochasticRaytracing::Room{
+    return StochasticRaytracing::Room{
         .dimensions = roomLayout.dimensions,
         .absorption = absorption,
         .reflection = makeReflection(absorption),
@@ -119,6 +125,19 @@ auto StochasticRaytracingEditor::run() -> void
         .source     = roomLayout.speakers[0],
         .receiver   = roomLayout.listenPosition,
     };
+}
+
+auto StochasticRaytracingEditor::run() -> void
+{
+    auto const simulation = StochasticRaytracing::Simulation{
+        .frequencies = frequencies(),
+        .duration    = static_cast<double>(_duration.getValue()) * si::second,
+        .timeStep    = 0.001 * si::second,
+        .radius      = 0.0875 * si::metre,
+        .rays        = static_cast<size_t>(static_cast<double>(_rays.getValue())),
+    };
+
+    auto const room = makeRoom();
 
     _threadPool.addJob([simulation, room, this] {
         auto raytracer = StochasticRaytracing{room};
@@ -144,6 +163,52 @@ auto StochasticRaytracingEditor::run() -> void
     });
 }
 
+auto StochasticRaytracingEditor::runHybrid() -> void
+{
+    auto const spec = HybridRenderer::Spec{
+        .room        = makeRoom(),
+        .frequencies = frequencies(),
+        .duration    = static_cast<double>(_duration.getValue()) * si::second,
+        .rays        = static_cast<size_t>(static_cast<double>(_rays.getValue())),
+    };
+
+    _hybrid.setEnabled(false);
+
+    _threadPool.addJob([spec, this] {
+        auto const renderer = HybridRenderer{spec};
+
+        auto start     = std::chrono::steady_clock::now();
+        auto result    = renderer();
+        auto stop      = std::chrono::steady_clock::now();
+        auto const sec = std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count();
+
+        auto const peak = std::transform_reduce(
+            result.impulse.begin(),
+            result.impulse.end(),
+            1e-12,
+            [](auto l, auto r) { return std::max(l, r); },
+            [](auto x) { return std::abs(x); }
+        );
+
+        auto samples = std::vector<float>(result.impulse.size());
+        std::transform(result.impulse.begin(), result.impulse.end(), samples.begin(), [peak](auto x) {
+            return static_cast<float>(x / peak);
+        });
+
+        auto const file      = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("hybrid.wav");
+        auto const crossover = result.crossover.numerical_value_in(si::hertz);
+        auto info            = neo::jformat("Crossover {:.0f} Hz in {:.2f} s", crossover, sec);
+        if (not writeToWavFile(file, samples, result.sampleRate)) {
+            info += ", writing " + file.getFileName() + " failed";
+        }
+
+        juce::MessageManager::callAsync([this, info] {
+            _hybridInfo.setText(info, juce::dontSendNotification);
+            _hybrid.setEnabled(true);
+        });
+    });
+}
+
 auto StochasticRaytracingEditor::Plot::plot(
     juce::String title,
     std::vector<double> const& data,
@@ -2,6 +2,7 @@
 
 #include "editor/RoomEditor.hpp"
 
+#include <ra/acoustic/HybridRenderer.hpp>
 #include <ra/acoustic/StochasticRaytracing.hpp>
 
 #include <juce_gui_extra/juce_gui_extra.h>
@@ -39,8 +40,12 @@ private:
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Plot)  // NOLINT
     };
 
+    [[nodiscard]] auto makeRoom() const -> StochasticRaytracing::Room;
     auto run() -> void;
 
+    /// Renders a broadband IR at the listening position to hybrid.wav in the temp directory
+    auto runHybrid() -> void;
+
     juce::ThreadPool& _threadPool;
     RoomEditor& _roomEditor;
 
@@ -52,6 +57,8 @@ private:
 
     juce::PropertyPanel _properties;
     juce::TextButton _render{"Render"};
+    juce::TextButton _hybrid{"Hybrid IR"};
+    juce::Label _hybridInfo;
     juce::OwnedArray<Plot> _plots;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StochasticRaytracingEditor)  // NOLINT
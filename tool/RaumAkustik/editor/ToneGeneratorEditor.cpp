@@ -1,5 +1,6 @@
 #include "ToneGeneratorEditor.hpp"
 
+#include "component/FrequencyPlot.hpp"
 #include "tool/PropertyComponent.hpp"
 #include "utility/ValueTree.hpp"
 
@@ -12,11 +13,6 @@
 namespace ra {
 
 namespace {
-struct FrequencyAndAmplitude
-{
-    float frequency;
-    float amplitude;
-};
 
 template<typename T>
 [[nodiscard]] constexpr auto frequencyForBin(size_t windowSize, size_t index, double sampleRate) -> T
@@ -24,22 +20,6 @@ template<typename T>
     return static_cast<T>(index) * static_cast<T>(sampleRate) / static_cast<T>(windowSize);
 }
 
-auto frequencyToX(float minFreq, float maxFreq, float freq, float width)
-{
-    auto const logMin  = std::log(minFreq);
-    auto const logMax  = std::log(maxFreq);
-    auto const logFreq = std::log(freq);
-    auto const ratio   = (logFreq - logMin) / (logMax - logMin);
-    return width * ratio;
-}
-
-auto amplitudeToY(float amplitude, juce::Rectangle<float> const bounds) -> float
-{
-    auto const infinity = -96.0F;
-    auto const dB       = juce::Decibels::gainToDecibels(amplitude, infinity);
-    return juce::jmap(dB, infinity, 0.0F, bounds.getBottom(), bounds.getY());
-}
-
 auto getFrequencyAndAmplitude(std::span<std::complex<float> const> bins, double sampleRate)
     -> std::vector<FrequencyAndAmplitude>
 {
@@ -57,35 +37,6 @@ auto getFrequencyAndAmplitude(std::span<std::complex<float> const> bins, double
     return result;
 }
 
-auto makePathFromAnalysis(std::span<FrequencyAndAmplitude const> analysis, float fs, juce::Rectangle<float> bounds)
-    -> juce::Path
-{
-    auto const size = static_cast<int>(analysis.size());
-    if (size == 0) {
-        return {};
-    }
-
-    auto frequencyLess = [](auto bin, auto target) { return bin.frequency < target; };
-    auto first         = std::lower_bound(begin(analysis), end(analysis), 1.0F, frequencyLess);
-    if (first == end(analysis)) {
-        return {};
-    }
-
-    auto p = juce::Path{};
-    p.preallocateSpace(8 + size * 3);
-
-    auto const width  = bounds.getWidth();
-    auto const startY = amplitudeToY(first->amplitude, bounds);
-    p.startNewSubPath(bounds.getX() + frequencyToX(1.0F, fs * 0.5F, first->frequency, width), startY);
-
-    for (; first != end(analysis); ++first) {
-        auto const y = amplitudeToY(first->amplitude, bounds);
-        p.lineTo(bounds.getX() + frequencyToX(1.0F, fs * 0.5F, first->frequency, width), y);
-    }
-
-    return p;
-}
-
 [[maybe_unused]] auto toAudioBuffer(std::vector<float> const& in) -> juce::AudioBuffer<float>
 {
     auto buf = juce::AudioBuffer<float>{1, static_cast<int>(in.size())};
@@ -116,7 +67,7 @@ getSpectrumPath(juce::AudioBuffer<float> const& in, double fs, juce::Rectangle<i
 }
 }  // namespace
 
-ToneGeneratorEditor::ToneGeneratorEditor(juce::AudioDeviceManager& deviceManager) : _recorder{deviceManager}
+ToneGeneratorEditor::ToneGeneratorEditor(AudioDispatcher& dispatcher) : _recorder{dispatcher}
 {
     setPropertyIfNotExist(_valueTree, "from", 20.0);
     setPropertyIfNotExist(_valueTree, "to", 20'000.0);
@@ -166,32 +117,8 @@ auto ToneGeneratorEditor::paint(juce::Graphics& g) -> void
     g.setColour(juce::Colours::white);
     _thumbnail.drawChannel(g, _thumbnailBounds.reduced(4), 0.0, _thumbnail.getTotalLength(), 0, 0.5F);
 
-    auto const b       = _spectrumBounds.toFloat();
     auto const maxFreq = static_cast<float>(static_cast<double>(_sampleRate)) / 2.0F;
-
-    for (auto const decade : {10.0F, 100.0F, 1'000.0F}) {
-        auto x0 = juce::roundToInt(b.getX() + frequencyToX(1.0F, maxFreq, decade, b.getWidth()));
-        g.setColour(juce::Colours::white.withAlpha(0.5F));
-        g.drawVerticalLine(x0, b.getY(), b.getBottom());
-
-        for (auto i{1}; i < 10; ++i) {
-            auto const d = decade * static_cast<float>(i);
-            auto const x = juce::roundToInt(b.getX() + frequencyToX(1.0F, maxFreq, d, b.getWidth()));
-            g.setColour(juce::Colours::white.withAlpha(0.25F));
-            g.drawVerticalLine(x, b.getY(), b.getBottom());
-        }
-    }
-
-    auto x0 = juce::roundToInt(b.getX() + frequencyToX(1.0F, maxFreq, 10'000.0F, b.getWidth()));
-    g.setColour(juce::Colours::white.withAlpha(0.5F));
-    g.drawVerticalLine(x0, b.getY(), b.getBottom());
-
-    for (auto i{0}; i < 90; i += 6) {
-        auto const amplitude = juce::Decibels::decibelsToGain(static_cast<float>(-i));
-        auto const y         = juce::roundToInt(amplitudeToY(amplitude, b));
-        g.setColour(juce::Colours::white.withAlpha(0.25F));
-        g.drawHorizontalLine(y, b.getX(), b.getRight());
-    }
+    drawFrequencyGrid(g, _spectrumBounds.toFloat(), maxFreq);
 
     g.setColour(juce::Colours::white);
     g.strokePath(_spectrumPath, juce::PathStrokeType{1.0F});
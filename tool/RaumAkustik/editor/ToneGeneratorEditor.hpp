@@ -15,7 +15,7 @@ struct ToneGeneratorEditor final
     , juce::ChangeListener
     , juce::ValueTree::Listener
 {
-    explicit ToneGeneratorEditor(juce::AudioDeviceManager& audioDeviceManager);
+    explicit ToneGeneratorEditor(AudioDispatcher& dispatcher);
     ~ToneGeneratorEditor() override = default;
 
     auto paint(juce::Graphics& g) -> void override;
@@ -2,20 +2,44 @@
 
 #include "look/ColorMap.hpp"
 #include "tool/PropertyComponent.hpp"
+#include "tool/WaveSnapshotRecorder.hpp"
 
-#include <neo/algorithm/copy.hpp>
+#include <ra/acoustic/ReverberationTime.hpp>
+#include <ra/acoustic/SchroederFrequency.hpp>
+#include <ra/dsp/Resampler.hpp>
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <neo_core/neo_core.hpp>
 
-#include <iostream>
+#include <numbers>
 
 namespace ra {
 
+namespace {
+
+// Same bands as the stochastic raytracer, so both can be compared directly
+auto const octaveBands = std::array{
+    31.25 * si::hertz,
+    62.5 * si::hertz,
+    125.0 * si::hertz,
+    250.0 * si::hertz,
+    500.0 * si::hertz,
+    1000.0 * si::hertz,
+    2000.0 * si::hertz,
+    4000.0 * si::hertz,
+    8000.0 * si::hertz,
+    16'000.0 * si::hertz,
+};
+
+constexpr auto analysisSampleRate = 48'000.0;
+
+}  // namespace
+
 WaveEquation2DEditor::WaveEquation2DEditor(juce::ThreadPool& threadPool, RoomEditor& roomEditor)
     : _threadPool{threadPool}
     , _roomEditor{roomEditor}
 {
+    using juce::ChoicePropertyComponent;
     using juce::SliderPropertyComponent;
 
     _title.setJustificationType(juce::Justification::centred);
@@ -28,27 +52,64 @@ WaveEquation2DEditor::WaveEquation2DEditor(juce::ThreadPool& threadPool, RoomEdi
         makeProperty<SliderPropertyComponent>(_duration, "Duration", 0.5, 10.0, 0.1),
         makeProperty<SliderPropertyComponent>(_fmax, "Max Frequency", 200.0, 20'000.0, 1.0),
         makeProperty<SliderPropertyComponent>(_ppw, "PPW", 1.0, 10.0, 1.0),
+        makeProperty<ChoicePropertyComponent>(
+            _scheme,
+            "Scheme",
+            juce::StringArray{"Standard Leapfrog", "Interpolated Wideband"},
+            juce::Array<juce::var>{
+                static_cast<int>(FdtdScheme::StandardLeapfrog),
+                static_cast<int>(FdtdScheme::InterpolatedWideband),
+            }
+        ),
+        makeProperty<ChoicePropertyComponent>(
+            _precision,
+            "Precision",
+            juce::StringArray{"Float32", "Float64"},
+            juce::Array<juce::var>{
+                static_cast<int>(FdtdPrecision::Float32),
+                static_cast<int>(FdtdPrecision::Float64),
+            }
+        ),
+        makeProperty<SliderPropertyComponent>(_absorbingLayer, "Absorbing Layer", 0.0, 64.0, 1.0),
+        makeProperty<ChoicePropertyComponent>(
+            _snapshotEncoding,
+            "Snapshot Format",
+            juce::StringArray{"Float32", "Float16", "Int16"},
+            juce::Array<juce::var>{
+                static_cast<int>(WaveSnapshotEncoding::Float32),
+                static_cast<int>(WaveSnapshotEncoding::Float16),
+                static_cast<int>(WaveSnapshotEncoding::Int16),
+            }
+        ),
+        makeProperty<SliderPropertyComponent>(_snapshotSpatial, "Snapshot Decimation", 1.0, 8.0, 1.0),
+        makeProperty<SliderPropertyComponent>(_snapshotInterval, "Snapshot Interval", 1.0, 100.0, 1.0),
+        makeProperty<SliderPropertyComponent>(_checkpointInterval, "Checkpoint Interval", 0.0, 10'000.0, 100.0),
     });
 
-    _render.onClick = [this] {
-        _readOut.clear();
-        _threadPool.addJob([this] { run(); });
-        startTimerHz(30);
-    };
+    _render.onClick = [this] { launch(false); };
+    _resume.onClick = [this] { launch(true); };
+    _stop.onClick   = [this] { _stopSource.request_stop(); };
+    _idle.signal();
 
     addAndMakeVisible(_title);
     addAndMakeVisible(_properties);
     addAndMakeVisible(_render);
+    addAndMakeVisible(_resume);
+    addAndMakeVisible(_stop);
+    addAndMakeVisible(_snapshots);
 }
 
+WaveEquation2DEditor::~WaveEquation2DEditor() { stopAndWait(); }
+
 auto WaveEquation2DEditor::paint(juce::Graphics& g) -> void
 {
     g.setColour(juce::Colours::white);
     g.fillRect(_plot);
 
-    auto plot       = _plot;
-    auto imgArea    = plot.removeFromLeft(plot.proportionOfWidth(0.5)).reduced(4.0F);
-    auto signalArea = plot.reduced(4.0F, plot.proportionOfHeight(0.2));
+    auto plot         = _plot;
+    auto imgArea      = plot.removeFromLeft(plot.proportionOfWidth(0.5)).reduced(4.0F);
+    auto signalArea   = plot.removeFromTop(plot.proportionOfHeight(0.5)).reduced(4.0F);
+    auto responseArea = plot.reduced(4.0F);
 
     auto path = juce::Path{};
     {
@@ -97,6 +158,107 @@ auto WaveEquation2DEditor::paint(juce::Graphics& g) -> void
     g.setColour(juce::Colours::black);
     g.strokePath(path, juce::PathStrokeType(1.0F));
     g.drawImage(_frameImage, imgArea, juce::RectanglePlacement::centred);
+
+    paintResponse(g, responseArea);
+}
+
+auto WaveEquation2DEditor::paintResponse(juce::Graphics& g, juce::Rectangle<float> area) -> void
+{
+    auto const& response = _analysis.response;
+    if (response.magnitude.size() < 2) {
+        return;
+    }
+
+    auto const fmin  = 20.0;
+    auto const fmax  = std::min(static_cast<double>(_fmax.getValue()), response.sampleRate * 0.5);
+    auto const toDb  = [](double mag) { return 20.0 * std::log10(std::max(mag, 1e-12)); };
+    auto const maxDb = toDb(*std::max_element(response.magnitude.begin(), response.magnitude.end()));
+
+    auto const toX = [&](double f) {
+        auto const norm = std::log(std::max(f, fmin) / fmin) / std::log(fmax / fmin);
+        return area.getX() + static_cast<float>(norm) * area.getWidth();
+    };
+    auto const toY = [&](double db) {
+        auto const norm = static_cast<float>((db - maxDb + 60.0) / 60.0);
+        return area.getBottom() - norm * area.getHeight();
+    };
+
+    // Band energies relative to the loudest band
+    if (not _analysis.bandEnergies.empty()) {
+        auto const maxBand = *std::max_element(_analysis.bandEnergies.begin(), _analysis.bandEnergies.end());
+        g.setColour(juce::Colours::grey.withAlpha(0.25F));
+        for (auto i{0UL}; i < _analysis.bandEnergies.size(); ++i) {
+            auto const center = octaveBands[i].numerical_value_in(si::hertz);
+            if (center / std::numbers::sqrt2 > fmax) {
+                break;
+            }
+
+            auto const level = 10.0 * std::log10(std::max(_analysis.bandEnergies[i] / maxBand, 1e-12)) + maxDb;
+            auto const left  = toX(center / std::numbers::sqrt2);
+            auto const right = toX(std::min(center * std::numbers::sqrt2, fmax));
+            auto const top   = std::clamp(toY(level), area.getY(), area.getBottom());
+            g.fillRect(juce::Rectangle<float>::leftTopRightBottom(left, top, right, area.getBottom()));
+        }
+    }
+
+    auto path = juce::Path{};
+    for (auto i{1UL}; i < response.frequency.size(); ++i) {
+        if (response.frequency[i] > fmax) {
+            break;
+        }
+
+        auto const point = juce::Point{toX(response.frequency[i]), toY(toDb(response.magnitude[i]))};
+        if (path.isEmpty()) {
+            path.startNewSubPath(point);
+        } else {
+            path.lineTo(point);
+        }
+    }
+
+    g.setColour(juce::Colours::black);
+    g.strokePath(path, juce::PathStrokeType(1.0F));
+
+    g.setColour(juce::Colours::blue);
+    for (auto const& peak : _analysis.peaks) {
+        auto const f = peak.frequency.numerical_value_in(si::hertz);
+        g.fillEllipse(juce::Rectangle<float>{5.0F, 5.0F}.withCentre({toX(f), toY(peak.level)}));
+    }
+
+    if (_analysis.schroederFrequency > fmin and _analysis.schroederFrequency < fmax) {
+        auto const x = toX(_analysis.schroederFrequency);
+        g.setColour(juce::Colours::red);
+        g.drawVerticalLine(static_cast<int>(x), area.getY(), area.getBottom());
+        g.drawText(
+            neo::jformat("fs = {:.0f} Hz", _analysis.schroederFrequency),
+            juce::Rectangle<float>{x + 4.0F, area.getY(), 100.0F, 16.0F},
+            juce::Justification::centredLeft
+        );
+    }
+}
+
+auto WaveEquation2DEditor::analyse(std::span<double const> receiver, double solverRate) const -> Analysis
+{
+    auto const room   = _roomEditor.getRoomLayout().dimensions;
+    auto const volume = room.length.numerical_value_in(si::metre) * room.width.numerical_value_in(si::metre)
+                      * room.height.numerical_value_in(si::metre) * cubic(si::metre);
+    auto const rt     = nominalReverberationTime(volume);
+
+    auto const resample = Resampler{{.inputRate = solverRate, .outputRate = analysisSampleRate}};
+    auto const impulse  = resample(receiver);
+
+    auto analysis = Analysis{
+        .response           = frequencyResponse(impulse, analysisSampleRate),
+        .peaks              = {},
+        .bandEnergies       = {},
+        .schroederFrequency = schroederFrequency(rt, volume).numerical_value_in(si::hertz),
+    };
+
+    // Modes are only distinct below the Schroeder frequency
+    auto const fmax       = std::max(analysis.schroederFrequency, 100.0) * si::hertz;
+    analysis.peaks        = findPeaks(analysis.response, 20.0 * si::hertz, fmax, 6.0);
+    analysis.bandEnergies = octaveBandEnergies(analysis.response, octaveBands);
+
+    return analysis;
 }
 
 auto WaveEquation2DEditor::resized() -> void
@@ -105,9 +267,12 @@ auto WaveEquation2DEditor::resized() -> void
 
     auto panel = area.removeFromRight(area.proportionOfWidth(0.175));
     _properties.setBounds(panel.removeFromTop(panel.proportionOfHeight(0.9)));
-    _render.setBounds(panel);
+    _render.setBounds(panel.removeFromLeft(panel.proportionOfWidth(0.4)));
+    _resume.setBounds(panel.removeFromLeft(panel.proportionOfWidth(0.5)));
+    _stop.setBounds(panel);
 
     _title.setBounds(area.removeFromTop(area.proportionOfHeight(0.05)));
+    _snapshots.setBounds(area.removeFromBottom(area.proportionOfHeight(0.4)));
     _plot = area.toFloat();
 }
 
@@ -118,50 +283,142 @@ auto WaveEquation2DEditor::timerCallback() -> void
     }
 }
 
-auto WaveEquation2DEditor::run() -> void
+auto WaveEquation2DEditor::launch(bool resume) -> void
+{
+    // Both jobs would write the same snapshot & checkpoint files
+    stopAndWait();
+    _stopSource = std::stop_source{};
+
+    _snapshots.close();
+    {
+        auto lock = std::scoped_lock{_frameMutex};
+        _readOut.clear();
+    }
+
+    _idle.reset();
+    _threadPool.addJob([this, resume, stop = _stopSource.get_token(), editor = juce::Component::SafePointer{this}] {
+        run(resume, stop, editor);
+        _idle.signal();
+    });
+    startTimerHz(30);
+}
+
+auto WaveEquation2DEditor::stopAndWait() -> void
+{
+    _stopSource.request_stop();
+    _idle.wait();
+}
+
+auto WaveEquation2DEditor::checkpointFile() const -> juce::File
+{
+    return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("WaveEquation2D.racheckpoint");
+}
+
+auto WaveEquation2DEditor::run(bool resume, std::stop_token stopToken, SafePointer<WaveEquation2DEditor> editor)
+    -> void
 {
     auto const room = _roomEditor.getRoomLayout().dimensions;
 
     auto we = WaveEquation2D({
-        .Lx       = room.width,
-        .Ly       = room.length,
-        .duration = static_cast<double>(_duration.getValue()) * si::second,
-        .fmax     = static_cast<double>(_fmax.getValue()) * si::hertz,
-        .ppw      = static_cast<double>(_ppw.getValue()),
+        .Lx             = room.width,
+        .Ly             = room.length,
+        .duration       = static_cast<double>(_duration.getValue()) * si::second,
+        .fmax           = static_cast<double>(_fmax.getValue()) * si::hertz,
+        .ppw            = static_cast<double>(_ppw.getValue()),
+        .scheme         = static_cast<FdtdScheme>(static_cast<int>(_scheme.getValue())),
+        .precision      = static_cast<FdtdPrecision>(static_cast<int>(_precision.getValue())),
+        .absorbingLayer = static_cast<std::size_t>(static_cast<double>(_absorbingLayer.getValue())),
     });
 
+    auto const checkpoint = WaveEquation2D::Checkpoint{
+        .path     = checkpointFile().getFullPathName().toStdString(),
+        .interval = static_cast<std::size_t>(static_cast<double>(_checkpointInterval.getValue())),
+    };
+
+    auto state = std::optional<WaveEquation2D::State>{};
+    if (resume) {
+        state = we.readCheckpoint(checkpoint.path);
+    }
+    if (not state.has_value()) {
+        state = we.initialState();
+    }
+
+    {
+        auto lock = std::scoped_lock{_frameMutex};
+        _readOut  = state->receiver;
+    }
+
+    auto const snapshotFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                  .getChildFile("WaveEquation2D.rasnap");
+    auto recorder = WaveSnapshotRecorder{
+        snapshotFile,
+        we.grid(),
+        {
+            .encoding           = static_cast<WaveSnapshotEncoding>(static_cast<int>(_snapshotEncoding.getValue())),
+            .spatialDecimation  = static_cast<std::size_t>(static_cast<double>(_snapshotSpatial.getValue())),
+            .temporalDecimation = static_cast<std::size_t>(static_cast<double>(_snapshotInterval.getValue())),
+            .firstTimeStep      = state->timeStep,
+        },
+    };
+
     auto iterations = 0UL;
 
     auto start = std::chrono::steady_clock::now();
-    we([&](auto frame) {
+    we(*state, [&](WaveEquation2D::Frame const& frame) {
         ++iterations;
+        recorder.push(frame);
 
-        {
+        std::visit([&](auto field) {
             auto lock = std::scoped_lock{_frameMutex};
-            if (_frame.extents() != frame.extents()) {
-                _frame = stdex::mdarray<double, stdex::dextents<size_t, 2>>{frame.extents()};
+            if (_frame.extent(0) != field.extent(0) or _frame.extent(1) != field.extent(1)) {
+                _frame = stdex::mdarray<double, stdex::dextents<size_t, 2>>{field.extent(0), field.extent(1)};
             }
 
-            _readOut.push_back(_frame(_frame.extent(0) / 2U, _frame.extent(1) / 2U));
-            neo::copy(frame, _frame.to_mdspan());
+            _readOut.push_back(state->receiver.back());
+            for (auto x{0UL}; x < field.extent(0); ++x) {
+                for (auto y{0UL}; y < field.extent(1); ++y) {
+                    _frame(x, y) = static_cast<double>(field(x, y));
+                }
+            }
             _needsRepaint = true;
-        }
-    });
+        }, frame);
+    }, checkpoint, stopToken);
     auto stop = std::chrono::steady_clock::now();
 
-    juce::MessageManager::callAsync([this, t = stop - start, iterations] {
+    recorder.finish();
+    auto const dropped = recorder.droppedFrames();
+
+    auto analysis = analyse(state->receiver, 1.0 / we.grid().dt);
+
+    // The editor may be gone by the time this runs
+    juce::MessageManager::callAsync([editor, t = stop - start, iterations, dropped, snapshotFile, analysis] {
+        if (editor == nullptr) {
+            return;
+        }
+
+        editor->_snapshots.open(snapshotFile);
+        editor->_analysis = analysis;
+
         auto const sec  = std::chrono::duration_cast<std::chrono::duration<double>>(t).count();
-        auto const x    = _frame.extent(0);
-        auto const y    = _frame.extent(1);
+        auto const x    = editor->_frame.extent(0);
+        auto const y    = editor->_frame.extent(1);
         auto const mvox = x * y * iterations / sec / 1'000'000.0;
 
-        _title.setText(
-            neo::jformat("Grid: {}x{} with {} frames in {:.2f} s ({:.2f} Mvox/s)", x, y, iterations, sec, mvox),
-            juce::sendNotification
+        auto title = neo::jformat(
+            "Grid: {}x{} with {} frames in {:.2f} s ({:.2f} Mvox/s)",
+            x,
+            y,
+            iterations,
+            sec,
+            mvox
         );
+        if (dropped != 0) {
+            title += neo::jformat(", {} snapshot frames dropped", dropped);
+        }
+        editor->_title.setText(title, juce::sendNotification);
 
-        stopTimer();
-        repaint();
+        editor->stopTimer();
+        editor->repaint();
     });
 }
 
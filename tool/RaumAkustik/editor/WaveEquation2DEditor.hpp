@@ -1,9 +1,11 @@
 #pragma once
 
+#include "component/WaveSnapshotViewer.hpp"
 #include "editor/RoomEditor.hpp"
 
 #include <ra/acoustic/StochasticRaytracing.hpp>
 #include <ra/acoustic/WaveEquation2D.hpp>
+#include <ra/dsp/FrequencyResponse.hpp>
 
 #include <juce_gui_extra/juce_gui_extra.h>
 
@@ -14,14 +16,28 @@ struct WaveEquation2DEditor final
     , juce::Timer
 {
     WaveEquation2DEditor(juce::ThreadPool& threadPool, RoomEditor& roomEditor);
-    ~WaveEquation2DEditor() override = default;
+    ~WaveEquation2DEditor() override;
 
     auto paint(juce::Graphics& g) -> void override;
     auto resized() -> void override;
     auto timerCallback() -> void override;
 
 private:
-    auto run() -> void;
+    struct Analysis
+    {
+        FrequencyResponse response;
+        std::vector<ResponsePeak> peaks;
+        std::vector<double> bandEnergies;
+        double schroederFrequency{0.0};
+    };
+
+    [[nodiscard]] auto analyse(std::span<double const> receiver, double solverRate) const -> Analysis;
+    auto paintResponse(juce::Graphics& g, juce::Rectangle<float> area) -> void;
+
+    auto launch(bool resume) -> void;
+    auto stopAndWait() -> void;
+    auto run(bool resume, std::stop_token stopToken, SafePointer<WaveEquation2DEditor> editor) -> void;
+    [[nodiscard]] auto checkpointFile() const -> juce::File;
 
     juce::ThreadPool& _threadPool;
     RoomEditor& _roomEditor;
@@ -29,11 +45,25 @@ private:
     juce::Value _duration{juce::var(2.0)};
     juce::Value _fmax{juce::var(2000.0)};
     juce::Value _ppw{juce::var(6.0)};
+    juce::Value _scheme{juce::var(static_cast<int>(FdtdScheme::StandardLeapfrog))};
+    juce::Value _precision{juce::var(static_cast<int>(FdtdPrecision::Float64))};
+    juce::Value _absorbingLayer{juce::var(0.0)};
+    juce::Value _snapshotEncoding{juce::var(static_cast<int>(WaveSnapshotEncoding::Float16))};
+    juce::Value _snapshotSpatial{juce::var(2.0)};
+    juce::Value _snapshotInterval{juce::var(4.0)};
+    juce::Value _checkpointInterval{juce::var(1000.0)};
 
     juce::Label _title;
     juce::Rectangle<float> _plot;
     juce::PropertyPanel _properties;
     juce::TextButton _render{"Render"};
+    juce::TextButton _resume{"Resume"};
+    juce::TextButton _stop{"Stop"};
+    std::stop_source _stopSource;
+
+    // Signalled while no run() job is queued or running
+    juce::WaitableEvent _idle{true};
+    WaveSnapshotViewer _snapshots;
 
     std::mutex _frameMutex;
     stdex::mdarray<double, stdex::dextents<size_t, 2>> _frame;
@@ -41,6 +71,7 @@ private:
     bool _needsRepaint{true};
 
     juce::Image _frameImage{juce::Image::ARGB, 1, 1, true};
+    Analysis _analysis;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveEquation2DEditor)  // NOLINT
 };
@@ -1,238 +1,202 @@
 #include "LatencyTester.hpp"
 
-#include <juce_dsp/juce_dsp.h>
-
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 namespace ra {
 
-LatencyTester::LatencyTester(juce::TextEditor& editorBox) : _resultsBox(editorBox) {}
+LatencyTester::LatencyTester(juce::TextEditor& editorBox, juce::Label& status)
+    : juce::Thread{"Latency Tester"}
+    , _resultsBox(editorBox)
+    , _status(status)
+{
+    startThread();
+    startTimerHz(20);
+}
 
-void LatencyTester::beginTest()
+LatencyTester::~LatencyTester() { stopThread(1000); }
+
+void LatencyTester::beginTest(bool continuous)
 {
     _resultsBox.moveCaretToEnd();
     _resultsBox.insertTextAtCaret(juce::newLine + juce::newLine + "Starting test..." + juce::newLine);
     _resultsBox.moveCaretToEnd();
 
-    startTimer(50);
-
-    juce::ScopedLock const sl(_lock);
-    createTestSound();
-    _recordedSound.clear();
-    _playingSampleNum = _recordedSampleNum = 0;
-    _testIsRunning                         = true;
+    // The worker resets the probe, samples of older generations are skipped
+    _continuous = continuous;
+    _generation.fetch_add(1);
+    _running.store(true);
 }
 
-void LatencyTester::timerCallback()
-{
-    if (_testIsRunning && _recordedSampleNum >= _recordedSound.getNumSamples()) {
-        _testIsRunning = false;
-        stopTimer();
-
-        // Test has finished, so calculate the result..
-        auto latencySamples = calculateLatencySamples();
+void LatencyTester::stopTest() { _running.store(false); }
 
-        _resultsBox.moveCaretToEnd();
-        _resultsBox.insertTextAtCaret(getMessageDescribingResult(latencySamples));
-        _resultsBox.moveCaretToEnd();
-    }
-}
+auto LatencyTester::isRunning() const -> bool { return _running.load(); }
 
-auto LatencyTester::getMessageDescribingResult(int latencySamples) const -> juce::String const
+void LatencyTester::timerCallback()
 {
-    juce::String message;
-
-    if (latencySamples >= 0) {
-        message << juce::newLine << "Results (" << _bufferSize << "): " << juce::newLine << latencySamples
-                << " samples (" << juce::String(latencySamples * 1000.0 / _sampleRate, 1) << " milliseconds)"
-                << juce::newLine << "The audio device reports an input latency of " << _deviceInputLatency
-                << " samples, output latency of " << _deviceOutputLatency << " samples." << juce::newLine
-                << "So the corrected latency = " << (latencySamples - _deviceInputLatency - _deviceOutputLatency)
-                << " samples ("
-                << juce::String((latencySamples - _deviceInputLatency - _deviceOutputLatency) * 1000.0 / _sampleRate, 2)
-                << " milliseconds)";
-    } else {
-        message << juce::newLine << "Couldn't detect the test signal!!" << juce::newLine
-                << "Make sure there's no background noise that might be confusing it..";
+    auto report = std::optional<Report>{};
+    {
+        auto const lock = std::scoped_lock{_reportMutex};
+        report          = std::exchange(_report, std::nullopt);
     }
 
-    return message;
-}
-
-void LatencyTester::audioDeviceAboutToStart(juce::AudioIODevice* device)
-{
-    _testIsRunning    = false;
-    _playingSampleNum = _recordedSampleNum = 0;
-
-    _bufferSize          = device->getCurrentBufferSizeSamples();
-    _sampleRate          = device->getCurrentSampleRate();
-    _deviceInputLatency  = device->getInputLatencyInSamples();
-    _deviceOutputLatency = device->getOutputLatencyInSamples();
-
-    _recordedSound.setSize(1, (int)(0.9 * _sampleRate));
-    _recordedSound.clear();
+    // Estimates of a test that was stopped or restarted meanwhile are stale
+    if (report.has_value() and report->generation == _generation.load() and _running.load()) {
+        show(*report);
+    }
 }
 
-void LatencyTester::audioDeviceStopped() {}
-
-void LatencyTester::audioDeviceIOCallbackWithContext(
-    float const* const* inputChannelData,
-    int numInputChannels,
-    float* const* outputChannelData,
-    int numOutputChannels,
-    int numSamples,
-    juce::AudioIODeviceCallbackContext const& context
-)
+void LatencyTester::run()
 {
-    ignoreUnused(context);
-
-    juce::ScopedLock const sl(_lock);
-
-    if (!_testIsRunning) {
-        auto const output = juce::dsp::AudioBlock<float>{
-            outputChannelData,
-            static_cast<size_t>(numOutputChannels),
-            static_cast<size_t>(numSamples),
-        };
-
-        output.fill(0.0F);
-        return;
-    }
-
-    auto* recordingBuffer  = _recordedSound.getWritePointer(0);
-    auto const* playBuffer = _testSound.getReadPointer(0);
-
-    for (int i = 0; i < numSamples; ++i) {
-        if (_recordedSampleNum < _recordedSound.getNumSamples()) {
-            auto inputSamp = 0.0F;
-
-            for (auto j = numInputChannels; --j >= 0;) {
-                if (inputChannelData[j] != nullptr) {
-                    inputSamp += inputChannelData[j][i];
-                }
-            }
-
-            recordingBuffer[_recordedSampleNum] = inputSamp;
+    while (not threadShouldExit()) {
+        // A gap in the recording breaks the alignment with the probe
+        if (_overflow.exchange(false) and _running.load()) {
+            _generation.fetch_add(1);
         }
 
-        ++_recordedSampleNum;
-
-        auto outputSamp = (_playingSampleNum < _testSound.getNumSamples()) ? playBuffer[_playingSampleNum] : 0.0F;
-
-        for (auto j = numOutputChannels; --j >= 0;) {
-            if (outputChannelData[j] != nullptr) {
-                outputChannelData[j][i] = outputSamp;
-            }
+        auto const generation = _generation.load();
+        if (generation != _analyzing) {
+            _analyzing = generation;
+            _probe.reset();
         }
 
-        ++_playingSampleNum;
+        auto const scope  = _fifo.read(_fifo.getNumReady());
+        auto const buffer = std::span<float const>{_fifoBuffer};
+        auto const first  = buffer.subspan(static_cast<std::size_t>(scope.startIndex1));
+        auto const second = buffer.subspan(static_cast<std::size_t>(scope.startIndex2));
+        analyze(first.first(static_cast<std::size_t>(scope.blockSize1)), generation);
+        analyze(second.first(static_cast<std::size_t>(scope.blockSize2)), generation);
+
+        wait(5);
     }
 }
 
-// create a test sound which consists of a series of randomly-spaced audio spikes..
-void LatencyTester::createTestSound()
+auto LatencyTester::analyze(std::span<float const> input, std::uint64_t generation) -> void
 {
-    auto length = ((int)_sampleRate) / 4;
-    _testSound.setSize(1, length);
-    _testSound.clear();
+    auto const first = _read;
+    _read += input.size();
 
-    juce::Random rand;
-
-    for (int i = 0; i < length; ++i) {
-        _testSound.setSample(0, i, (rand.nextFloat() - rand.nextFloat() + rand.nextFloat() - rand.nextFloat()) * 0.06F);
+    if (not _running.load() or _startedGeneration.load(std::memory_order_acquire) != generation) {
+        return;
     }
 
-    _spikePositions.clear();
-
-    int spikePos   = 0;
-    int spikeDelta = 50;
+    // Only samples recorded after the probe started
+    auto const startedAt = _startedAt.load(std::memory_order_relaxed);
+    if (_read <= startedAt) {
+        return;
+    }
 
-    while (spikePos < length - 1) {
-        _spikePositions.add(spikePos);
+    auto const skip = startedAt > first ? startedAt - first : 0;
+    if (_probe(input.subspan(skip)) == 0 and _probe.rejected() == 0) {
+        return;
+    }
 
-        _testSound.setSample(0, spikePos, 0.99F);
-        _testSound.setSample(0, spikePos + 1, -0.99F);
+    auto report = Report{
+        .estimate   = _probe.latest(),
+        .drift      = _probe.drift(),
+        .rejected   = _probe.rejected(),
+        .generation = generation,
+    };
 
-        spikePos += spikeDelta;
-        spikeDelta += spikeDelta / 6 + rand.nextInt(5);
-    }
+    auto const lock = std::scoped_lock{_reportMutex};
+    _report         = std::move(report);
 }
 
-// Searches a buffer for a set of spikes that matches those in the test sound
-auto LatencyTester::findOffsetOfSpikes(juce::AudioBuffer<float> const& buffer) const -> int
+auto LatencyTester::show(Report const& report) -> void
 {
-    auto minSpikeLevel          = 5.0F;
-    auto smooth                 = 0.975;
-    auto const* s               = buffer.getReadPointer(0);
-    int const spikeDriftAllowed = 5;
-
-    juce::Array<int> spikesFound;
-    spikesFound.ensureStorageAllocated(100);
-    auto runningAverage = 0.0;
-    int lastSpike       = 0;
-
-    for (int i = 0; i < buffer.getNumSamples() - 10; ++i) {
-        auto samp = std::abs(s[i]);
-
-        if (samp > runningAverage * minSpikeLevel && i > lastSpike + 20) {
-            lastSpike = i;
-            spikesFound.add(i);
+    auto const& estimate = report.estimate;
+
+    if (_continuous) {
+        if (estimate.has_value()) {
+            auto const ms = estimate->latency * 1000.0 / _sampleRate;
+            _status.setText(
+                juce::String(estimate->latency, 2) + " samples (" + juce::String(ms, 3) + " ms), drift "
+                    + juce::String(report.drift, 1) + " ppm, " + juce::String(report.rejected) + " dropped",
+                juce::dontSendNotification
+            );
         }
-
-        runningAverage = runningAverage * smooth + (1.0 - smooth) * samp;
+        return;
     }
 
-    int bestMatch       = -1;
-    auto bestNumMatches = _spikePositions.size() / 3;  // the minimum number of matches required
-
-    if (spikesFound.size() < bestNumMatches) {
-        return -1;
+    auto message = juce::String{};
+    if (estimate.has_value()) {
+        message = getMessageDescribingResult(*estimate);
+    } else if (report.rejected >= 3) {
+        message << juce::newLine << "Couldn't detect the test signal!!" << juce::newLine
+                << "Make sure the output is audible at the input..";
+    } else {
+        return;
     }
 
-    for (int offsetToTest = 0; offsetToTest < buffer.getNumSamples() - 2048; ++offsetToTest) {
-        int numMatchesHere = 0;
-        int foundIndex     = 0;
-
-        for (int refIndex = 0; refIndex < _spikePositions.size(); ++refIndex) {
-            auto referenceSpike = _spikePositions.getUnchecked(refIndex) + offsetToTest;
-            int spike           = 0;
+    stopTest();
+    _resultsBox.moveCaretToEnd();
+    _resultsBox.insertTextAtCaret(message);
+    _resultsBox.moveCaretToEnd();
+}
 
-            while ((spike = spikesFound.getUnchecked(foundIndex)) < referenceSpike - spikeDriftAllowed
-                   && foundIndex < spikesFound.size() - 1) {
-                ++foundIndex;
-            }
+auto LatencyTester::getMessageDescribingResult(LatencyEstimate const& estimate) const -> juce::String const
+{
+    auto const latency   = estimate.latency;
+    auto const corrected = latency - _deviceInputLatency - _deviceOutputLatency;
 
-            if (spike >= referenceSpike - spikeDriftAllowed && spike <= referenceSpike + spikeDriftAllowed) {
-                ++numMatchesHere;
-            }
-        }
+    juce::String message;
+    message << juce::newLine << "Results (" << _bufferSize << "): " << juce::newLine << juce::String(latency, 2)
+            << " samples (" << juce::String(latency * 1000.0 / _sampleRate, 2) << " milliseconds), confidence "
+            << juce::String(estimate.confidence, 1) << juce::newLine
+            << "The audio device reports an input latency of " << _deviceInputLatency
+            << " samples, output latency of " << _deviceOutputLatency << " samples." << juce::newLine
+            << "So the corrected latency = " << juce::String(corrected, 2) << " samples ("
+            << juce::String(corrected * 1000.0 / _sampleRate, 2) << " milliseconds)";
+    return message;
+}
 
-        if (numMatchesHere > bestNumMatches) {
-            bestNumMatches = numMatchesHere;
-            bestMatch      = offsetToTest;
+auto LatencyTester::audioProducts() const -> AudioProducts { return {.channelSum = true}; }
 
-            if (numMatchesHere == _spikePositions.size()) {
-                break;
-            }
-        }
-    }
+auto LatencyTester::audioStarted(juce::AudioIODevice& device) -> void
+{
+    _bufferSize          = device.getCurrentBufferSizeSamples();
+    _sampleRate          = device.getCurrentSampleRate();
+    _deviceInputLatency  = device.getInputLatencyInSamples();
+    _deviceOutputLatency = device.getOutputLatencyInSamples();
 
-    return bestMatch;
+    // The probe restarts from its first sample
+    _playing = 0;
 }
 
-auto LatencyTester::calculateLatencySamples() const -> int
+auto LatencyTester::processAudio(AudioInput const& input, AudioOutput const& output) -> void
 {
-    // Detect the sound in both our test sound and the recording of it, and measure the difference
-    // in their start times..
-    auto referenceStart = findOffsetOfSpikes(_testSound);
-    jassert(referenceStart >= 0);
+    auto const samples    = input.numSamples;
+    auto const generation = _generation.load(std::memory_order_acquire);
+    if (generation != _playing) {
+        _playing  = generation;
+        _position = 0;
+        _startedAt.store(_written, std::memory_order_relaxed);
+        _startedGeneration.store(generation, std::memory_order_release);
+    }
+
+    // Same probe on every output
+    if (_running.load()) {
+        auto const probe = output.scratch();
+        _probe.render(_position, probe);
+        output.addToAll(probe);
+        _position += samples;
+    }
 
-    auto recordedStart = findOffsetOfSpikes(_recordedSound);
+    // The sum of all inputs
+    auto const scope = _fifo.write(static_cast<int>(samples));
+    auto const second = std::next(input.sum.begin(), scope.blockSize1);
+    std::copy_n(input.sum.begin(), scope.blockSize1, std::next(_fifoBuffer.begin(), scope.startIndex1));
+    std::copy_n(second, scope.blockSize2, std::next(_fifoBuffer.begin(), scope.startIndex2));
 
-    return (recordedStart < 0) ? -1 : (recordedStart - referenceStart);
+    auto const written = static_cast<std::size_t>(scope.blockSize1 + scope.blockSize2);
+    _written += written;
+    if (written < samples) {
+        _overflow.store(true);
+    }
 }
 
-LatencyTesterEditor::LatencyTesterEditor(juce::AudioDeviceManager& deviceManager) : _audioDeviceManager{deviceManager}
+LatencyTesterEditor::LatencyTesterEditor(AudioDispatcher& dispatcher) : _dispatcher{dispatcher}
 {
     setOpaque(true);
 
@@ -249,39 +213,67 @@ LatencyTesterEditor::LatencyTesterEditor(juce::AudioDeviceManager& deviceManager
 
     _resultsBox.setText("Running this test measures the round-trip latency between the audio output and input "
                         "devices you\'ve got selected.\n\n"
-                        "It\'ll play a sound, then try to measure the time at which the sound arrives "
-                        "back at the audio input. Obviously for this to work you need to have your "
-                        "microphone somewhere near your speakers...");
+                        "It\'ll play a maximum length sequence, then correlate it with the audio input to "
+                        "find the time at which it arrives, down to a fraction of a sample. Obviously for "
+                        "this to work you need to have your microphone somewhere near your speakers...\n\n"
+                        "Tracking keeps the sequence looping and shows the latency and clock drift below.");
 
     addAndMakeVisible(_startTestButton);
     _startTestButton.onClick = [this] { startTest(); };
 
+    addAndMakeVisible(_trackButton);
+    _trackButton.setClickingTogglesState(true);
+    _trackButton.onClick = [this] { toggleTracking(); };
+
+    addAndMakeVisible(_status);
+
     setSize(500, 500);
 }
 
 LatencyTesterEditor::~LatencyTesterEditor()
 {
-    _audioDeviceManager.removeAudioCallback(_latencyTester.get());
+    if (_latencyTester != nullptr) {
+        _dispatcher.remove(*_latencyTester);
+    }
     _latencyTester.reset();
 }
 
-void LatencyTesterEditor::startTest()
+auto LatencyTesterEditor::createTester() -> LatencyTester&
 {
     if (_latencyTester == nullptr) {
-        _latencyTester = std::make_unique<LatencyTester>(_resultsBox);
-        _audioDeviceManager.addAudioCallback(_latencyTester.get());
+        _latencyTester = std::make_unique<LatencyTester>(_resultsBox, _status);
+        _dispatcher.add(*_latencyTester, "Latency Tester");
     }
 
-    _latencyTester->beginTest();
+    return *_latencyTester;
+}
+
+void LatencyTesterEditor::startTest()
+{
+    _trackButton.setToggleState(false, juce::dontSendNotification);
+    createTester().beginTest();
+}
+
+void LatencyTesterEditor::toggleTracking()
+{
+    if (_trackButton.getToggleState()) {
+        createTester().beginTest(true);
+    } else if (_latencyTester != nullptr) {
+        _latencyTester->stopTest();
+    }
 }
 
 void LatencyTesterEditor::paint(juce::Graphics& g) { g.fillAll(findColour(juce::ResizableWindow::backgroundColourId)); }
 
 void LatencyTesterEditor::resized()
 {
-    auto b = getLocalBounds().reduced(5);
-    _startTestButton.setBounds(b.removeFromBottom(b.getHeight() / 10));
-    b.removeFromBottom(10);
+    auto b       = getLocalBounds().reduced(5);
+    auto buttons = b.removeFromBottom(b.getHeight() / 10);
+    _startTestButton.setBounds(buttons.removeFromLeft(buttons.proportionOfWidth(0.5)));
+    _trackButton.setBounds(buttons);
+    b.removeFromBottom(5);
+    _status.setBounds(b.removeFromBottom(24));
+    b.removeFromBottom(5);
     _resultsBox.setBounds(b);
 }
 
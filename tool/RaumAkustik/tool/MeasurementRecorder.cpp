@@ -1,145 +1,280 @@
 #include "MeasurementRecorder.hpp"
 
+#include "tool/AudioFile.hpp"
+#include "tool/PropertyComponent.hpp"
+
+#include <ra/acoustic/ImpulseResponseAnalysis.hpp>
+#include <ra/dsp/Deconvolver.hpp>
+
+#include <neo_core/neo_core.hpp>
+
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 namespace ra {
 
+namespace {
+
+[[nodiscard]] auto toString(ImpulseResponseParameters const& params) -> juce::String
+{
+    return neo::jformat(
+        "EDT={:.2f}s T20={:.2f}s T30={:.2f}s C50={:.1f}dB C80={:.1f}dB",
+        params.edt.numerical_value_in(si::second),
+        params.t20.numerical_value_in(si::second),
+        params.t30.numerical_value_in(si::second),
+        params.c50,
+        params.c80
+    );
+}
+
+}  // namespace
+
 MeasurementRecorder::MeasurementRecorder(juce::AudioThumbnail& thumbnail) : _thumbnail(thumbnail)
 {
     _writerThread.startThread();
+    startTimerHz(20);
 }
 
-MeasurementRecorder::~MeasurementRecorder() { stop(); }
+MeasurementRecorder::~MeasurementRecorder()
+{
+    // No callback is running anymore, everything can go right away
+    _active.store(nullptr);
+    _session.reset();
+    _retired.clear();
+}
 
-void MeasurementRecorder::startRecording(juce::File const& file)
+void MeasurementRecorder::startRecording(juce::File const& file, std::size_t channels, std::size_t repetitions)
 {
     stop();
 
-    if (_sampleRate > 0) {
-        // Create an OutputStream to write to our destination file...
-        file.deleteFile();
-
-        if (auto fileStream = std::unique_ptr<juce::FileOutputStream>(file.createOutputStream())) {
-            // Now create a WAV writer object that writes to our output stream...
-            juce::WavAudioFormat wavFormat;
+    _file = file;
 
-            if (auto* writer = wavFormat.createWriterFor(fileStream.get(), _sampleRate, 1, 16, {}, 0)) {
+    if (_sampleRate <= 0) {
+        return;
+    }
 
-                // passes responsibility for deleting the stream to the writer object that is now using it
-                [[maybe_unused]] auto* ptr = fileStream.release();
+    // Generating the sweep is expensive, only redo it for a new rate or layout
+    auto const* current = _schedule != nullptr ? &_schedule->spec() : nullptr;
+    if (current == nullptr or current->sweep.sampleRate != _sweepSpec.sampleRate or current->channels != channels
+        or current->repetitions != repetitions) {
+        _schedule = std::make_shared<MultiSweep const>(MultiSweep::Spec{
+            .sweep       = _sweepSpec,
+            .channels    = channels,
+            .repetitions = repetitions,
+            .length      = 2.0 * si::second,
+        });
+    }
 
-                // Now we'll create one of these helper objects which will act as a FIFO buffer, and will
-                // write the data to disk on our background thread.
-                _writer = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(writer, _writerThread, 32768);
+    auto session      = std::make_unique<Session>();
+    session->schedule = _schedule;
+    session->inputs   = std::max(_inputs, 1);
+    session->capture.resize(_schedule->size(), 0.0F);
 
-                // Reset our recording thumbnail
-                _thumbnail.reset(writer->getNumChannels(), writer->getSampleRate());
-                _nextSampleNum = 0;
+    file.deleteFile();
+    auto stream = std::unique_ptr<juce::FileOutputStream>(file.createOutputStream());
+    if (stream == nullptr) {
+        return;
+    }
 
-                // And now, swap over our active writer pointer so that the audio callback will start using it..
-                juce::ScopedLock const sl(_writerLock);
-                _activeWriter = _writer.get();
-            }
-        }
+    // 32-bit float, the capture isn't quantized before the deconvolution
+    auto wav     = juce::WavAudioFormat{};
+    auto* writer = wav.createWriterFor(stream.get(), _sampleRate, static_cast<unsigned>(session->inputs), 32, {}, 0);
+    if (writer == nullptr) {
+        return;
     }
 
-    _doneRecording.store(false);
-    startTimer(500);
+    // The writer owns the stream now, the threaded writer owns the writer
+    juce::ignoreUnused(stream.release());
+    session->writer = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(writer, _writerThread, 1 << 16);
+
+    // Only the first input is shown
+    _thumbnail.reset(1, _sampleRate);
+    _thumbnailPosition = 0;
+
+    _session = std::move(session);
+    _active.store(_session.get());
 }
 
 void MeasurementRecorder::timerCallback()
 {
-    if (not _doneRecording.load()) {
+    reclaim();
+
+    if (_session == nullptr) {
         return;
     }
 
-    stopTimer();
-    stop();
+    updateThumbnail(*_session);
+
+    if (_session->done.load()) {
+        analyze(*_session);
+        stop();
+    }
 }
 
-void MeasurementRecorder::stop()
+auto MeasurementRecorder::analyze(Session const& session) -> void
 {
-    // First, clear this pointer to stop the audio callback from using our writer object..
-    {
-        juce::ScopedLock const sl(_writerLock);
-        _activeWriter = nullptr;
+    auto const& schedule = session.schedule->spec();
+    if (schedule.channels > 1 or schedule.repetitions > 1) {
+        analyzeMultiSweep(session);
+        return;
     }
 
-    // Now we can delete the writer object. It's done in this order because the deletion could
-    // take a little time while remaining data gets flushed to disk, so it's best to avoid blocking
-    // the audio callback while this happens.
-    _writer.reset();
-}
+    auto const spec = Deconvolver::Spec{.sweep = _sweepSpec, .harmonics = 5};
+    auto const file = _file.getSiblingFile(_file.getFileNameWithoutExtension() + " IR.wav");
 
-auto MeasurementRecorder::isRecording() const -> bool { return _activeWriter.load() != nullptr; }
+    juce::Thread::launch([spec, file, capture = session.capture] {
+        auto deconvolver = Deconvolver{spec};
+        deconvolver(capture);
 
-void MeasurementRecorder::audioDeviceAboutToStart(juce::AudioIODevice* device)
-{
-    _sampleRate = device->getCurrentSampleRate();
+        auto const distortion = deconvolver.distortion();
+        auto thd              = juce::String{"THD"};
+        for (auto const frequency : {63.0, 125.0, 250.0, 500.0, 1'000.0, 2'000.0}) {
+            auto const bin = std::lower_bound(distortion.frequency.begin(), distortion.frequency.end(), frequency);
+            if (bin != distortion.frequency.end()) {
+                auto const index = static_cast<std::size_t>(std::distance(distortion.frequency.begin(), bin));
+                thd += neo::jformat(" {:.0f}Hz={:.2f}%", frequency, distortion.thd[index]);
+            }
+        }
+        juce::Logger::writeToLog(thd);
 
-    _sweep = generate(GlideSweep{
-        .from       = 20.0 * si::hertz,
-        .to         = 20'000.0 * si::hertz,
-        .curve      = GlideSweep::Curve::Logarithmic,
-        .duration   = 10 * si::second,
-        .sampleRate = _sampleRate * si::hertz,
+        auto const impulse = deconvolver.finish();
+        auto const params  = analyzeImpulseResponse(impulse, spec.sweep.sampleRate);
+        juce::Logger::writeToLog(toString(params));
+
+        auto samples = std::vector<float>(impulse.size());
+        std::transform(impulse.begin(), impulse.end(), samples.begin(), [](auto x) { return static_cast<float>(x); });
+        if (writeToWavFile(file, samples, spec.sweep.sampleRate.numerical_value_in(si::hertz))) {
+            juce::Logger::writeToLog(file.getFullPathName());
+        }
     });
 }
 
-void MeasurementRecorder::audioDeviceStopped() { _sampleRate = 0; }
+auto MeasurementRecorder::analyzeMultiSweep(Session const& session) -> void
+{
+    auto const fs   = _sweepSpec.sampleRate;
+    auto const file = _file;
+
+    // The shared schedule stays alive while the capture is deconvolved
+    juce::Thread::launch([schedule = session.schedule, file, fs, capture = session.capture] {
+        auto const responses = schedule->deconvolve(capture);
+        for (auto channel{0UL}; channel < responses.size(); ++channel) {
+            auto const& impulse = responses[channel];
+            auto const peak     = std::max_element(impulse.begin(), impulse.end(), [](auto l, auto r) {
+                return std::abs(l) < std::abs(r);
+            });
+
+            auto const params = analyzeImpulseResponse(std::span{peak, impulse.end()}, fs);
+            juce::Logger::writeToLog(neo::jformat("Channel {}: ", channel + 1) + toString(params));
+
+            auto samples = std::vector<float>(impulse.size());
+            auto const scale = peak != impulse.end() and *peak != 0.0 ? 1.0 / std::abs(*peak) : 1.0;
+            std::transform(impulse.begin(), impulse.end(), samples.begin(), [scale](auto x) {
+                return static_cast<float>(x * scale);
+            });
+
+            auto const name = file.getFileNameWithoutExtension() + " IR " + juce::String(channel + 1) + ".wav";
+            auto const out  = file.getSiblingFile(name);
+            if (writeToWavFile(out, samples, fs.numerical_value_in(si::hertz))) {
+                juce::Logger::writeToLog(out.getFullPathName());
+            }
+        }
+    });
+}
 
-void MeasurementRecorder::audioDeviceIOCallbackWithContext(
-    float const* const* inputChannelData,
-    int numInputChannels,
-    float* const* outputChannelData,
-    int numOutputChannels,
-    int numSamples,
-    juce::AudioIODeviceCallbackContext const& context
-)
+auto MeasurementRecorder::updateThumbnail(Session const& session) -> void
 {
-    ignoreUnused(context);
+    auto const position = std::min(session.position.load(std::memory_order_acquire), session.capture.size());
+    if (position <= _thumbnailPosition) {
+        return;
+    }
 
-    // We need to clear the output buffers, in case they're full of junk..
-    for (int i = 0; i < numOutputChannels; ++i) {
-        if (outputChannelData[i] != nullptr) {
-            juce::FloatVectorOperations::clear(outputChannelData[i], numSamples);
-        }
+    // Wraps the capture, no copies
+    auto* first          = const_cast<float*>(std::next(session.capture.data(), std::ptrdiff_t(_thumbnailPosition)));
+    auto const numFrames = static_cast<int>(position - _thumbnailPosition);
+    auto const buffer    = juce::AudioBuffer<float>{&first, 1, numFrames};  // NOLINT
+
+    _thumbnail.addBlock(static_cast<juce::int64>(_thumbnailPosition), buffer, 0, numFrames);
+    _thumbnailPosition = position;
+}
+
+void MeasurementRecorder::stop()
+{
+    if (_session == nullptr) {
+        return;
     }
 
-    juce::ScopedLock const sl(_writerLock);
+    // A callback that still sees the session ends after the one counted here
+    _active.store(nullptr);
+    _retired.push_back(Retired{.session = std::move(_session), .callbacks = _callbacks.load()});
+    reclaim();
+}
+
+auto MeasurementRecorder::reclaim() -> void
+{
+    // Deleting the threaded writer flushes the file, off the audio thread
+    auto const callbacks = _callbacks.load();
+    auto const running   = _deviceRunning.load();
+    std::erase_if(_retired, [=](auto const& retired) { return not running or callbacks > retired.callbacks; });
+}
 
-    auto const lastSample = std::ssize(_sweep) + juce::roundToInt(_sampleRate * 2.0);
+auto MeasurementRecorder::isRecording() const -> bool { return _active.load() != nullptr; }
 
-    if (_activeWriter.load() != nullptr && numInputChannels >= _thumbnail.getNumChannels()) {
-        _activeWriter.load()->write(inputChannelData, numSamples);
+auto MeasurementRecorder::audioStarted(juce::AudioIODevice& device) -> void
+{
+    _sampleRate = device.getCurrentSampleRate();
+    _sweepSpec = ExponentialSweep{
+        .from       = 20.0 * si::hertz,
+        .to         = 20'000.0 * si::hertz,
+        .duration   = 10.0 * si::second,
+        .sampleRate = _sampleRate * si::hertz,
+        .fadeIn     = 0.05 * si::second,
+        .fadeOut    = 0.01 * si::second,
+    };
 
-        // Create an AudioBuffer to wrap our incoming data, note that this does no allocations or copies, it simply
-        // references our input data
-        juce::AudioBuffer<float> const buffer(
-            const_cast<float**>(inputChannelData),  // NOLINT
-            _thumbnail.getNumChannels(),
-            numSamples
-        );
-        _thumbnail.addBlock(_nextSampleNum, buffer, 0, numSamples);
+    _inputs = device.getActiveInputChannels().countNumberOfSetBits();
+    _deviceRunning.store(true);
+}
 
-        if (numOutputChannels > 0) {
-            auto const* sweep = std::data(_sweep);
-            auto const* end   = std::next(sweep, std::ssize(_sweep));
-            auto const* first = std::min(end, std::next(sweep, _nextSampleNum));
-            auto const* last  = std::min(end, std::next(first, numSamples));
-            std::copy(first, last, outputChannelData[0]);
+auto MeasurementRecorder::audioStopped() -> void
+{
+    _deviceRunning.store(false);
+    _sampleRate = 0;
+}
+
+auto MeasurementRecorder::processAudio(AudioInput const& input, AudioOutput const& output) -> void
+{
+    auto* session = _active.load();
+    if (session != nullptr and not session->done.load(std::memory_order_relaxed)
+        and input.channels.size() >= static_cast<std::size_t>(session->inputs)) {
+        // Never blocks, drops the block if the writer thread falls behind
+        session->writer->write(input.channels.data(), static_cast<int>(input.numSamples));
+
+        auto const& schedule = *session->schedule;
+        auto const position  = session->position.load(std::memory_order_relaxed);
+        auto const samples   = input.numSamples;
+
+        auto const first     = input.channel(0);
+        auto const remaining = session->capture.size() - std::min(position, session->capture.size());
+        auto const captured  = std::min(first.size(), remaining);
+        std::copy_n(first.begin(), captured, std::next(session->capture.begin(), std::ptrdiff_t(position)));
+
+        auto const channels = std::min(output.channels(), schedule.spec().channels);
+        for (auto channel{0UL}; channel < channels; ++channel) {
+            schedule.render(channel, position, output.scratch());
+            output.add(channel, output.scratch());
         }
 
-        _nextSampleNum += numSamples;
+        session->position.store(position + samples, std::memory_order_release);
+        if (position + samples >= schedule.size()) {
+            session->done.store(true, std::memory_order_release);
+        }
     }
 
-    if (_nextSampleNum >= lastSample) {
-        _doneRecording.store(true);
-    }
+    _callbacks.fetch_add(1);
 }
 
-MeasurementRecorderEditor::MeasurementRecorderEditor(juce::AudioDeviceManager& deviceManager)
-    : _audioDeviceManager{deviceManager}
+MeasurementRecorderEditor::MeasurementRecorderEditor(AudioDispatcher& dispatcher) : _dispatcher{dispatcher}
 {
     setOpaque(true);
 
@@ -155,14 +290,20 @@ MeasurementRecorderEditor::MeasurementRecorderEditor(juce::AudioDeviceManager& d
         }
     };
 
+    _properties.addProperties(juce::Array<juce::PropertyComponent*>{
+        makeProperty<juce::SliderPropertyComponent>(_channels, "Channels", 1.0, 8.0, 1.0),
+        makeProperty<juce::SliderPropertyComponent>(_repetitions, "Repetitions", 1.0, 16.0, 1.0),
+    });
+
+    addAndMakeVisible(_properties);
     addAndMakeVisible(_thumbnail);
 
-    _audioDeviceManager.addAudioCallback(&_recorder);
+    _dispatcher.add(_recorder, "Measurement Recorder");
 
     setSize(500, 500);
 }
 
-MeasurementRecorderEditor::~MeasurementRecorderEditor() { _audioDeviceManager.removeAudioCallback(&_recorder); }
+MeasurementRecorderEditor::~MeasurementRecorderEditor() { _dispatcher.remove(_recorder); }
 
 void MeasurementRecorderEditor::paint(juce::Graphics& g)
 {
@@ -175,6 +316,7 @@ void MeasurementRecorderEditor::resized()
 
     _thumbnail.setBounds(area.removeFromTop(80).reduced(8));
     _recordButton.setBounds(area.removeFromTop(36).removeFromLeft(140).reduced(8));
+    _properties.setBounds(area.removeFromTop(_properties.getTotalContentHeight()).reduced(8, 0));
 }
 
 MeasurementRecorderEditor::Thumbnail::Thumbnail()
@@ -222,7 +364,9 @@ void MeasurementRecorderEditor::startRecording()
     auto parentDir = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory);
     _lastRecording = parentDir.getNonexistentChildFile("JUCE Demo Audio Recording", ".wav");
 
-    _recorder.startRecording(_lastRecording);
+    auto const channels    = static_cast<std::size_t>(static_cast<int>(_channels.getValue()));
+    auto const repetitions = static_cast<std::size_t>(static_cast<int>(_repetitions.getValue()));
+    _recorder.startRecording(_lastRecording, channels, repetitions);
 
     _recordButton.setButtonText("Stop");
     _thumbnail.setDisplayFullThumbnail(false);
@@ -1,55 +1,98 @@
 #pragma once
 
-#include <ra/generator/GlideSweep.hpp>
+#include <ra/dsp/MultiSweep.hpp>
+#include <ra/generator/ExponentialSweep.hpp>
 
+#include "application/AudioDispatcher.hpp"
 #include "component/ScrollingWaveform.hpp"
 
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 namespace ra {
 
+/// Plays the sweeps & records every active input as 32-bit float
+///
+/// The audio thread never locks. Each recording is a session handed over
+/// through an atomic pointer. Stopping swaps the pointer out and retires
+/// the session. It's deleted, which flushes the file, once the audio
+/// thread has finished a callback that started after the swap.
 struct MeasurementRecorder final
     : juce::Timer
-    , juce::AudioIODeviceCallback
+    , AudioConsumer
 {
     explicit MeasurementRecorder(juce::AudioThumbnail& thumbnail);
+
+    /// Has to be removed from the dispatcher before
     ~MeasurementRecorder() override;
 
-    void startRecording(juce::File const& file);
+    /// Plays the sweep repetitions times on the first outputs,
+    /// interleaved as multiple exponential sweeps
+    void startRecording(juce::File const& file, std::size_t channels = 1, std::size_t repetitions = 1);
     void stop();
     auto isRecording() const -> bool;
 
     void timerCallback() override;
 
-    void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
-    void audioDeviceStopped() override;
-    void audioDeviceIOCallbackWithContext(
-        float const* const* inputChannelData,
-        int numInputChannels,
-        float* const* outputChannelData,
-        int numOutputChannels,
-        int numSamples,
-        juce::AudioIODeviceCallbackContext const& context
-    ) override;
+    auto audioStarted(juce::AudioIODevice& device) -> void override;
+    auto audioStopped() -> void override;
+    auto processAudio(AudioInput const& input, AudioOutput const& output) -> void override;
 
 private:
+    struct Session
+    {
+        std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> writer;
+        std::shared_ptr<MultiSweep const> schedule;
+        int inputs{0};
+
+        // First input, deconvolved once the sweep is done
+        std::vector<float> capture;
+
+        // Written by the audio thread only
+        std::atomic<std::size_t> position{0};
+        std::atomic<bool> done{false};
+    };
+
+    struct Retired
+    {
+        std::unique_ptr<Session> session;
+        std::uint64_t callbacks{0};
+    };
+
+    auto analyze(Session const& session) -> void;
+    auto analyzeMultiSweep(Session const& session) -> void;
+    auto updateThumbnail(Session const& session) -> void;
+    auto reclaim() -> void;
+
     juce::AudioThumbnail& _thumbnail;
     juce::TimeSliceThread _writerThread{"Audio Recorder Thread"};
-    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> _writer;
     double _sampleRate{0.0};
-    juce::int64 _nextSampleNum{0};
+    int _inputs{0};
 
-    std::vector<float> _sweep;
-    std::atomic<bool> _doneRecording{false};
+    ExponentialSweep _sweepSpec;
 
-    juce::CriticalSection _writerLock;
-    std::atomic<juce::AudioFormatWriter::ThreadedWriter*> _activeWriter{nullptr};
+    // Rebuilt on the message thread only when the rate or layout changes.
+    // Sessions keep their schedule alive until they're reclaimed.
+    std::shared_ptr<MultiSweep const> _schedule;
+
+    juce::File _file;
+    std::unique_ptr<Session> _session;
+    std::size_t _thumbnailPosition{0};
+    std::vector<Retired> _retired;
+
+    std::atomic<Session*> _active{nullptr};
+    std::atomic<std::uint64_t> _callbacks{0};
+    std::atomic<bool> _deviceRunning{false};
 };
 
 struct MeasurementRecorderEditor final : juce::Component
 {
-    explicit MeasurementRecorderEditor(juce::AudioDeviceManager& audioDeviceManager);
+    explicit MeasurementRecorderEditor(AudioDispatcher& dispatcher);
     ~MeasurementRecorderEditor() override;
 
     void paint(juce::Graphics& g) override;
@@ -80,11 +123,15 @@ private:
     void startRecording();
     void stopRecording();
 
-    juce::AudioDeviceManager& _audioDeviceManager;
+    AudioDispatcher& _dispatcher;
 
     Thumbnail _thumbnail;
     MeasurementRecorder _recorder{_thumbnail.getAudioThumbnail()};
 
+    juce::Value _channels{juce::var(1.0)};
+    juce::Value _repetitions{juce::var(1.0)};
+    juce::PropertyPanel _properties;
+
     juce::TextButton _recordButton{"Record"};
     juce::File _lastRecording;
 };
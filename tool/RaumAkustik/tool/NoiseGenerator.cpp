@@ -32,36 +32,22 @@ auto NoiseGenerator::resized() -> void
     _play.setBounds(area);
 }
 
-auto NoiseGenerator::audioDeviceAboutToStart(juce::AudioIODevice* /*device*/) -> void {}
+auto NoiseGenerator::audioStarted(juce::AudioIODevice& /*device*/) -> void {}
 
-auto NoiseGenerator::audioDeviceStopped() -> void {}
-
-auto NoiseGenerator::audioDeviceIOCallbackWithContext(
-    float const* const* inputChannelData,
-    int numInputChannels,
-    float* const* outputChannelData,
-    int numOutputChannels,
-    int numberOfSamples,
-    juce::AudioIODeviceCallbackContext const& context
-) -> void
+auto NoiseGenerator::processAudio(AudioInput const& input, AudioOutput const& output) -> void
 {
-    juce::ignoreUnused(context, inputChannelData, numInputChannels);
-
-    auto const output = juce::dsp::AudioBlock<float>{
-        outputChannelData,
-        static_cast<size_t>(numOutputChannels),
-        static_cast<size_t>(numberOfSamples),
-    };
+    juce::ignoreUnused(input);
 
-    output.fill(0.0F);
     if (!_isPlaying.load()) {
         return;
     }
 
-    auto* const channel = output.getChannelPointer(0);
-    for (auto i{0}; i < numberOfSamples; ++i) {
-        channel[i] = _dist(_urng) * _gain;
+    // First output only
+    auto const noise = output.scratch();
+    for (auto& sample : noise) {
+        sample = _dist(_urng) * _gain;
     }
+    output.add(0, noise);
 }
 
 }  // namespace ra
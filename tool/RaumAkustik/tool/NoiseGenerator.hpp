@@ -1,5 +1,7 @@
 #pragma once
 
+#include "application/AudioDispatcher.hpp"
+
 #include <juce_audio_utils/juce_audio_utils.h>
 #include <juce_dsp/juce_dsp.h>
 
@@ -9,23 +11,15 @@ namespace ra {
 
 struct NoiseGenerator final
     : juce::Component
-    , juce::AudioIODeviceCallback
+    , AudioConsumer
 {
     NoiseGenerator();
     ~NoiseGenerator() override = default;
 
     auto resized() -> void override;
 
-    auto audioDeviceAboutToStart(juce::AudioIODevice* /*device*/) -> void override;
-    auto audioDeviceStopped() -> void override;
-    auto audioDeviceIOCallbackWithContext(
-        float const* const* inputChannelData,
-        int numInputChannels,
-        float* const* outputChannelData,
-        int numOutputChannels,
-        int numberOfSamples,
-        juce::AudioIODeviceCallbackContext const& context
-    ) -> void override;
+    auto audioStarted(juce::AudioIODevice& /*device*/) -> void override;
+    auto processAudio(AudioInput const& input, AudioOutput const& output) -> void override;
 
 private:
     std::mt19937 _urng{std::random_device{}()};
@@ -0,0 +1,120 @@
+#include "WaveSnapshotRecorder.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace ra {
+
+WaveSnapshotRecorder::WaveSnapshotRecorder(juce::File file, WaveEquation2D::Grid const& grid, Options const& options)
+    : juce::Thread{"Wave Snapshot Recorder"}
+    , _file{std::move(file)}
+    , _timeStep{options.firstTimeStep}
+{
+    auto const spatial  = std::max(options.spatialDecimation, std::size_t(1));
+    auto const temporal = std::max(options.temporalDecimation, std::size_t(1));
+    auto const steps    = grid.Nt - std::min<std::size_t>(options.firstTimeStep, grid.Nt);
+
+    _header.encoding           = options.encoding;
+    _header.width              = static_cast<std::uint32_t>((grid.Nx + spatial - 1) / spatial);
+    _header.height             = static_cast<std::uint32_t>((grid.Ny + spatial - 1) / spatial);
+    _header.spatialDecimation  = static_cast<std::uint32_t>(spatial);
+    _header.temporalDecimation = static_cast<std::uint32_t>(temporal);
+    _header.sampleRate         = 1.0 / grid.dt;
+    _header.capacity           = (steps + temporal - 1) / temporal;
+
+    // The length of the run is known upfront, so the file is allocated once
+    // and mapped for its whole lifetime.
+    _file.deleteFile();
+    {
+        auto stream = juce::FileOutputStream{_file};
+        if (not stream.openedOk()) {
+            return;
+        }
+
+        stream.write(&_header, sizeof(_header));
+        if (auto const size = fileSize(_header); size > sizeof(_header)) {
+            stream.setPosition(static_cast<juce::int64>(size) - 1);
+            stream.writeByte(0);
+        }
+    }
+
+    _map = std::make_unique<juce::MemoryMappedFile>(_file, juce::MemoryMappedFile::readWrite);
+    if (_map->getData() == nullptr) {
+        _map.reset();
+        return;
+    }
+
+    auto const numSamples = std::size_t{_header.width} * std::size_t{_header.height};
+    for (auto& slot : _slots) {
+        slot.frame.resize(numSamples);
+        _free.push(&slot);
+    }
+
+    startThread();
+}
+
+WaveSnapshotRecorder::~WaveSnapshotRecorder() { finish(); }
+
+auto WaveSnapshotRecorder::isOpen() const -> bool { return _map != nullptr; }
+
+auto WaveSnapshotRecorder::push(WaveEquation2D::Frame const& frame) -> void
+{
+    auto const timeStep = _timeStep++;
+    if (not isOpen() or timeStep % _header.temporalDecimation != 0) {
+        return;
+    }
+
+    auto* slot = static_cast<Slot*>(nullptr);
+    if (not _free.pop(slot)) {
+        _dropped.fetch_add(1);
+        return;
+    }
+
+    slot->timeStep = timeStep;
+    std::visit([this, slot](auto field) { decimate(field, _header.spatialDecimation, slot->frame); }, frame);
+    _filled.push(slot);
+}
+
+auto WaveSnapshotRecorder::finish() -> void
+{
+    stopThread(-1);
+    writePending();
+}
+
+auto WaveSnapshotRecorder::droppedFrames() const -> std::uint64_t { return _dropped.load(); }
+
+auto WaveSnapshotRecorder::run() -> void
+{
+    while (not threadShouldExit()) {
+        writePending();
+        wait(5);
+    }
+}
+
+auto WaveSnapshotRecorder::writePending() -> void
+{
+    if (not isOpen()) {
+        return;
+    }
+
+    auto* const data = static_cast<std::byte*>(_map->getData());
+    auto const size  = recordSize(_header);
+
+    auto* slot = static_cast<Slot*>(nullptr);
+    while (_filled.pop(slot)) {
+        if (_header.frameCount < _header.capacity) {
+            auto const offset = recordOffset(_header, static_cast<std::size_t>(_header.frameCount));
+            encodeWaveSnapshot(_header, slot->frame, slot->timeStep, {std::next(data, std::ptrdiff_t(offset)), size});
+
+            // Publish the frame only after its record is complete, pairs
+            // with the acquire fence in WaveSnapshotViewer::readHeader
+            ++_header.frameCount;
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(data, &_header, sizeof(_header));
+        }
+
+        _free.push(slot);
+    }
+}
+
+}  // namespace ra
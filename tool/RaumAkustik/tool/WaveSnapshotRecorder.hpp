@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ra/acoustic/WaveEquation2D.hpp>
+#include <ra/acoustic/WaveSnapshot.hpp>
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <juce_core/juce_core.h>
+
+namespace ra {
+
+/// Streams decimated & quantized frames of a FDTD run into a memory-mapped
+/// file. The solver thread only copies the decimated frame into a pooled
+/// buffer, encoding & writing happens on the recorder's own thread.
+struct WaveSnapshotRecorder final : juce::Thread
+{
+    struct Options
+    {
+        WaveSnapshotEncoding encoding{WaveSnapshotEncoding::Float16};
+        std::size_t spatialDecimation{1};
+        std::size_t temporalDecimation{1};
+
+        /// Time step of the first pushed frame, non-zero for resumed runs
+        std::uint64_t firstTimeStep{0};
+    };
+
+    WaveSnapshotRecorder(juce::File file, WaveEquation2D::Grid const& grid, Options const& options);
+    ~WaveSnapshotRecorder() override;
+
+    [[nodiscard]] auto isOpen() const -> bool;
+
+    /// Called by the solver once per time step. Never blocks, if the writer
+    /// falls behind the frame is dropped.
+    auto push(WaveEquation2D::Frame const& frame) -> void;
+
+    /// Writes all pending frames and stops the writer thread.
+    auto finish() -> void;
+
+    [[nodiscard]] auto droppedFrames() const -> std::uint64_t;
+
+    auto run() -> void override;
+
+private:
+    struct Slot
+    {
+        std::uint64_t timeStep{0};
+        std::vector<float> frame;
+    };
+
+    static constexpr auto numSlots = std::size_t{64};
+
+    auto writePending() -> void;
+
+    juce::File _file;
+    WaveSnapshotHeader _header;
+    std::unique_ptr<juce::MemoryMappedFile> _map;
+
+    std::array<Slot, numSlots> _slots;
+    boost::lockfree::spsc_queue<Slot*, boost::lockfree::capacity<numSlots>> _free;
+    boost::lockfree::spsc_queue<Slot*, boost::lockfree::capacity<numSlots>> _filled;
+
+    std::uint64_t _timeStep{0};
+    std::atomic<std::uint64_t> _dropped{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveSnapshotRecorder)  // NOLINT
+};
+
+}  // namespace ra
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace ra {
+
+/// Fixed capacity map, evicts the least recently used entry. Not thread-safe.
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+struct LruCache
+{
+    explicit LruCache(std::size_t capacity) : _capacity{capacity} {}
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return _entries.size(); }
+
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t { return _capacity; }
+
+    /// Marks the entry as most recently used, nullptr if not cached
+    [[nodiscard]] auto find(Key const& key) -> Value const*
+    {
+        auto const found = _index.find(key);
+        if (found == _index.end()) {
+            return nullptr;
+        }
+
+        _entries.splice(_entries.begin(), _entries, found->second);
+        return &found->second->second;
+    }
+
+    auto insert(Key key, Value value) -> void
+    {
+        if (auto const found = _index.find(key); found != _index.end()) {
+            found->second->second = std::move(value);
+            _entries.splice(_entries.begin(), _entries, found->second);
+            return;
+        }
+
+        if (_capacity == 0) {
+            return;
+        }
+
+        if (_entries.size() == _capacity) {
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+
+        _entries.emplace_front(key, std::move(value));
+        _index.emplace(std::move(key), _entries.begin());
+    }
+
+private:
+    using Entries = std::list<std::pair<Key, Value>>;
+
+    std::size_t _capacity;
+    Entries _entries;
+    std::unordered_map<Key, typename Entries::iterator, Hash> _index;
+};
+
+}  // namespace ra